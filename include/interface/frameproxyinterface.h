@@ -37,6 +37,8 @@ public:
     virtual void setSearchPath(ModuleInterface *const inter) const = 0;
     virtual void addChildPageTrans(const QString &menu, const QString &rran) = 0;
 
+    // 搜索数据按模块划分，set*Visible 只记录可见性变化，
+    // updateSearchData 只重建 module 的搜索数据，module 为模块显示名称
     virtual void setModuleVisible(const QString &module, bool visible) = 0;
     virtual void setWidgetVisible(const QString &module, const QString &widget, bool visible) = 0;
     virtual void setDetailVisible(const QString &module, const QString &widget, const QString &detail, bool visible) = 0;
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "namespace.h"
+
+namespace DCC_NAMESPACE {
+
+// ModulePageCacheInterface 为可选接口，继承该接口的模块在切换到其他模块时页面不会被销毁，
+// 而是隐藏后放入缓存并调用 ModuleInterface::deactive()，再次进入时调用 restore() 代替 active()。
+// 模块需要保证 deactive() 不会销毁页面仍在使用的数据，缓存满时页面会被直接销毁
+class ModulePageCacheInterface
+{
+public:
+    virtual ~ModulePageCacheInterface() {}
+
+    ///
+    /// \brief isPageCacheable
+    /// 当前页面是否可以缓存，例如页面中有显示在其他位置的窗口时不能缓存
+    ///
+    virtual bool isPageCacheable() const { return true; }
+
+    ///
+    /// \brief restore
+    /// 缓存的页面重新显示前调用，恢复 deactive() 中停止的工作；
+    /// 返回 false 表示页面已经过期，主窗口会销毁缓存的页面并重新调用 active()
+    ///
+    virtual bool restore() { return true; }
+};
+
+}
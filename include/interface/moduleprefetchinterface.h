@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "namespace.h"
+
+#include <QStringList>
+
+namespace DCC_NAMESPACE {
+
+// ModulePrefetchInterface 为可选接口，模块可以同时继承 ModuleInterface 和该接口，
+// 声明预初始化的依赖关系以及可以在线程池中提前执行的工作。
+// 未继承该接口的模块(包括旧的插件)按原有顺序在主线程中预初始化
+class ModulePrefetchInterface
+{
+public:
+    virtual ~ModulePrefetchInterface() {}
+
+    ///
+    /// \brief preInitializeAfter
+    /// 需要在本模块之前完成 preInitialize 的模块 name()，不存在的模块会被忽略
+    ///
+    virtual QStringList preInitializeAfter() const { return QStringList(); }
+
+    ///
+    /// \brief sessionServices / systemServices
+    /// 模块依赖的 D-Bus 服务，会在线程池中提前激活，避免 preInitialize 时阻塞等待服务启动
+    ///
+    virtual QStringList sessionServices() const { return QStringList(); }
+    virtual QStringList systemServices() const { return QStringList(); }
+
+    ///
+    /// \brief prefetch
+    /// 在线程池中执行，早于 preInitialize 被调用；
+    /// 只能读取文件或 D-Bus 等数据，不能创建或访问主线程中的对象及界面
+    ///
+    virtual void prefetch() {}
+};
+
+}
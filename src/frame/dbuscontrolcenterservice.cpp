@@ -4,6 +4,7 @@
 
 #include "dbuscontrolcenterservice.h"
 #include "window/mainwindow.h"
+#include "window/tracer.h"
 
 #include "modules/display/displaymodel.h"
 #include "modules/display/displayworker.h"
@@ -17,6 +18,8 @@
 #include <QtCore/QVariant>
 #include <QtCore/QThread>
 #include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <qpa/qplatformwindow.h>
 #include <QScreen>
 #include <QString>
@@ -130,6 +133,7 @@ void DBusControlCenterService::ShowModule(const QString &module)
 
 void DBusControlCenterService::ShowPage(const QString &module, const QString &page)
 {
+    DCC_TRACE_SCOPE("dbus", "ShowPage", module + "/" + page);
     parent()->initAllModule(module);
 
     static bool firstEnter = true;
@@ -166,10 +170,21 @@ bool DBusControlCenterService::isModuleAvailable(const QString &m)
     return parent()->isModuleAvailable(m);
 }
 
+QString DBusControlCenterService::SetTraceEnabled(bool enabled)
+{
+    // 返回 trace 文件路径，关闭时写入文件，写入失败返回空
+    Tracer *tracer = Tracer::instance();
+    if (!tracer->setEnabled(enabled))
+        return QString();
+
+    return tracer->fileName();
+}
+
 
 DBusControlCenterGrandSearchService::DBusControlCenterGrandSearchService(MainWindow *parent)
     : QDBusAbstractAdaptor(parent)
     , m_autoExitTimer(new QTimer(this))
+    , m_pendingTimer(new QTimer(this))
 {
     this->parent()->initAllModule();
     m_autoExitTimer->setInterval(10000);
@@ -180,6 +195,12 @@ DBusControlCenterGrandSearchService::DBusControlCenterGrandSearchService(MainWin
             QCoreApplication::quit();
     });
     m_autoExitTimer->start();
+
+    //搜索数据最多等待5秒，超时后使用已有的数据回复
+    m_pendingTimer->setInterval(5000);
+    m_pendingTimer->setSingleShot(true);
+    connect(m_pendingTimer, &QTimer::timeout, this, &DBusControlCenterGrandSearchService::onSearchDataLoaded);
+    connect(this->parent(), &MainWindow::searchDataLoaded, this, &DBusControlCenterGrandSearchService::onSearchDataLoaded);
 }
 
 DBusControlCenterGrandSearchService::~DBusControlCenterGrandSearchService()
@@ -188,11 +209,22 @@ DBusControlCenterGrandSearchService::~DBusControlCenterGrandSearchService()
 }
 
 //匹配搜索结果
-QString DBusControlCenterGrandSearchService::Search(const QString json)
+QString DBusControlCenterGrandSearchService::Search(const QString json, const QDBusMessage &message)
 {
-    QString val = parent()->GrandSearchSearch(json);
     m_autoExitTimer->start();
-    return val;
+
+    if (parent()->isSearchDataLoaded())
+        return parent()->GrandSearchSearch(json);
+
+    //搜索数据还未加载完成，延迟回复，加载完成后再处理；同一个id的新搜索替换旧的搜索
+    message.setDelayedReply(true);
+    const QString id = QJsonDocument::fromJson(json.toUtf8()).object().value("mID").toVariant().toString();
+    cancelPendingSearch(id);
+    m_pendingSearches.append({ id, json, message });
+    if (!m_pendingTimer->isActive())
+        m_pendingTimer->start();
+
+    return QString();
 }
 
 //停止搜索
@@ -200,11 +232,47 @@ bool DBusControlCenterGrandSearchService::Stop(const QString json)
 {
     bool val = parent()->GrandSearchStop(json);
 
+    //取消还未回复的搜索，避免调用方收到过期的结果
+    cancelPendingSearch(QJsonDocument::fromJson(json.toUtf8()).object().value("mID").toVariant().toString());
+    if (m_pendingSearches.isEmpty())
+        m_pendingTimer->stop();
+
     m_autoExitTimer->start();
 
     return val;
 }
 
+void DBusControlCenterGrandSearchService::onSearchDataLoaded()
+{
+    m_pendingTimer->stop();
+
+    const QList<PendingSearch> pendingSearches = m_pendingSearches;
+    m_pendingSearches.clear();
+    for (const PendingSearch &search : pendingSearches) {
+        replyPendingSearch(search.message, parent()->GrandSearchSearch(search.json));
+    }
+
+    if (!pendingSearches.isEmpty())
+        m_autoExitTimer->start();
+}
+
+void DBusControlCenterGrandSearchService::replyPendingSearch(const QDBusMessage &message, const QString &reply)
+{
+    QDBusConnection::sessionBus().send(message.createReply(reply));
+}
+
+void DBusControlCenterGrandSearchService::cancelPendingSearch(const QString &id)
+{
+    for (auto it = m_pendingSearches.begin(); it != m_pendingSearches.end();) {
+        if (it->id == id) {
+            replyPendingSearch(it->message, QString());
+            it = m_pendingSearches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 //执行搜索
 bool DBusControlCenterGrandSearchService::Action(const QString json)
 {
@@ -58,6 +58,7 @@ public Q_SLOTS: // METHODS
     void ToggleInLeft();
     bool isNetworkCanShowPassword();
     bool isModuleAvailable(const QString &m);
+    QString SetTraceEnabled(bool enabled);
 
 Q_SIGNALS: // SIGNALS
     void rectChanged(const QRect &rect);
@@ -79,12 +80,29 @@ public:
     inline DCC_NAMESPACE::MainWindow *parent() const;
 
 public Q_SLOTS: // METHODS
-    QString Search(const QString json);
+    QString Search(const QString json, const QDBusMessage &message);
     bool Stop(const QString json);
     bool Action(const QString json);
 
+private Q_SLOTS:
+    void onSearchDataLoaded();
+
+private:
+    void replyPendingSearch(const QDBusMessage &message, const QString &reply);
+    // 取消id对应的还未回复的搜索，回复空结果
+    void cancelPendingSearch(const QString &id);
+
 private:
+    // 搜索数据加载完成前收到的搜索请求，使用延迟回复，不阻塞主线程
+    struct PendingSearch {
+        QString id;
+        QString json;
+        QDBusMessage message;
+    };
+
     QTimer *m_autoExitTimer;
+    QTimer *m_pendingTimer;
+    QList<PendingSearch> m_pendingSearches;
 };
 
 #endif
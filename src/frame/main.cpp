@@ -5,6 +5,7 @@
 #include "dbuscontrolcenterservice.h"
 #include "window/mainwindow.h"
 #include "window/accessible.h"
+#include "window/tracer.h"
 
 #include <DApplication>
 #include <DDBusSender>
@@ -18,6 +19,9 @@ DCORE_USE_NAMESPACE
 
 int main(int argc, char *argv[])
 {
+    // 尽早开始计时，trace 中的时间从进程启动开始计算
+    DCC_NAMESPACE::Tracer::instance()->initFromEnvironment();
+
     DApplication *app = DApplication::globalApplication(argc, argv);
     app->setOrganizationName("deepin");
     app->setApplicationName("dde-control-center");
@@ -78,6 +82,10 @@ int main(int argc, char *argv[])
     DLogManager::registerConsoleAppender();
     DLogManager::registerFileAppender();
 
+    QObject::connect(app, &QCoreApplication::aboutToQuit, [] {
+        DCC_NAMESPACE::Tracer::instance()->flush();
+    });
+
 #ifdef CVERSION
     QString verstr(CVERSION);
     if (verstr.isEmpty())
@@ -151,5 +159,6 @@ int main(int argc, char *argv[])
     }
 #endif
 
+    DCC_NAMESPACE::Tracer::instance()->addInstant("startup", "exec");
     return app->exec();
 }
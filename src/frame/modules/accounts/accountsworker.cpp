@@ -5,6 +5,7 @@
 #include "accountsworker.h"
 #include "window/utils.h"
 #include "widgets/utils.h"
+#include "modules/dbuspropertybinder.h"
 
 #include <QFileDialog>
 #include <QtConcurrent>
@@ -72,7 +73,12 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
     if (!currentUserPath.isEmpty()) {
         onUserListChanged({currentUserPath.first().toString()});
     }
-    onUserListChanged(interface.property("UserList").toStringList());
+    // 用户列表已经由 prefetch 在线程池中读取时不再同步读取
+    const QVariantMap &prefetched = dcc::DBusPropertyBinder::takePrefetched(AccountsService, "/com/deepin/daemon/Accounts", Accounts::staticInterfaceName());
+    if (prefetched.contains("UserList"))
+        onUserListChanged(qdbus_cast<QStringList>(prefetched.value("UserList")));
+    else
+        onUserListChanged(interface.property("UserList").toStringList());
     updateUserOnlineStatus(m_dmInter->sessions());
     getAllGroups();
     getPresetGroups();
@@ -448,7 +454,9 @@ void AccountsWorker::setAdministrator(User *user, const bool asAdministrator)
     // because this operate need root permission, we must wait for finished and refersh result
     Q_EMIT requestMainWindowEnabled(false);
 
-    QStringList lstGroups = ui->groups();
+    // 用户属性由 DBusPropertyBinder 异步读取，ui 没有缓存分组，ui->groups() 可能返回空列表，
+    // 导致用户被移出所有分组，这里使用 model 中的分组
+    QStringList lstGroups = user->groups();
     if(!asAdministrator)
         lstGroups.removeOne("sudo");
     else
@@ -539,7 +547,9 @@ void AccountsWorker::addUser(const QString &userPath)
 
     User *user = new User(this);
 
-    connect(userInter, &AccountsUser::UserNameChanged, user, [=](const QString &name) {
+    // 用户的属性通过一次 GetAll 异步读取，之后只处理变化的属性
+    dcc::DBusPropertyBinder *binder = new dcc::DBusPropertyBinder(AccountsService, userPath, AccountsUser::staticInterfaceName(), QDBusConnection::systemBus(), user);
+    binder->bind<QString>("UserName", user, [=](const QString &name) {
         user->setName(name);
         user->setSecurityLever(getSecUserLeverbyname(name));
         user->setOnline(m_onlineUsers.contains(name));
@@ -549,34 +559,20 @@ void AccountsWorker::addUser(const QString &userPath)
 #endif
     });
 
-    connect(userInter, &AccountsUser::AutomaticLoginChanged, user, &User::setAutoLogin);
-    connect(userInter, &AccountsUser::IconListChanged, user, &User::setAvatars);
-    connect(userInter, &AccountsUser::IconFileChanged, user, &User::setCurrentAvatar);
-    connect(userInter, &AccountsUser::FullNameChanged, user, &User::setFullname);
-    connect(userInter, &AccountsUser::NoPasswdLoginChanged, user, &User::setNopasswdLogin);
-    connect(userInter, &AccountsUser::PasswordStatusChanged, user, &User::setPasswordStatus);
-    connect(userInter, &AccountsUser::CreatedTimeChanged, user, &User::setCreatedTime);
-    connect(userInter, &AccountsUser::GroupsChanged, user, &User::setGroups);
-    connect(userInter, &AccountsUser::AccountTypeChanged, user, &User::setUserType);
-    connect(userInter, &AccountsUser::MaxPasswordAgeChanged, user, &User::setPasswordAge);
-    connect(userInter, &AccountsUser::GidChanged, user, &User::setGid);
-
-    // 这里直接赋值的话, 由于请求是异步的, 所以一开始会被初始化成乱码,
-    // 然后数据正常了以后会额外产生一次变化信号
-    // 对于计算当前有多少个管理员有干扰.
-    userInter->userName();
-    userInter->fullName();
-    userInter->automaticLogin();
-    userInter->iconList();
-    userInter->groups();
-    userInter->iconFile();
-    userInter->noPasswdLogin();
-    userInter->passwordStatus();
-    userInter->createdTime();
-    userInter->accountType();
-    userInter->maxPasswordAge();
+    binder->bind("AutomaticLogin", user, &User::setAutoLogin);
+    binder->bind("IconList", user, &User::setAvatars);
+    binder->bind("IconFile", user, &User::setCurrentAvatar);
+    binder->bind("FullName", user, &User::setFullname);
+    binder->bind("NoPasswdLogin", user, &User::setNopasswdLogin);
+    binder->bind("PasswordStatus", user, &User::setPasswordStatus);
+    binder->bind("CreatedTime", user, &User::setCreatedTime);
+    binder->bind("Groups", user, &User::setGroups);
+    binder->bind("AccountType", user, &User::setUserType);
+    binder->bind("MaxPasswordAge", user, &User::setPasswordAge);
+    binder->bind("Gid", user, &User::setGid);
+    binder->refresh();
+
     userInter->IsPasswordExpired();
-    userInter->gid();
 
     m_userInters[user] = userInter;
     m_userModel->addUser(userPath, user);
@@ -6,6 +6,7 @@
 
 #include <QPainter>
 #include <QPainterPath>
+#include <QPixmapCache>
 #include <QTime>
 #include <QtMath>
 
@@ -38,24 +39,15 @@ void Clock::paintEvent(QPaintEvent *)
     painter.setRenderHints(painter.renderHints() | QPainter::Antialiasing);
 
     // draw plate
-    const bool nightMode = !(time.hour() >= 6  && time.hour() < 18);
-    painter.setPen(Qt::transparent);
-    painter.setBrush(nightMode && autoNightMode() ? Qt::black : Qt::white);
+    // 表盘只和尺寸、昼夜有关，所有世界时钟共用缓存，每次只绘制指针
+    const bool nightMode = !(time.hour() >= 6  && time.hour() < 18) && autoNightMode();
+    painter.drawPixmap(0, 0, platePixmap(nightMode));
 
     QPen pen(painter.pen());
-    if (nightMode && autoNightMode()) {
-        pen.setColor(Qt::black);
-    } else {
-        pen.setColor(QColor("#E6E6E6"));
-    }
     pen.setWidth(1);
-    painter.setPen(pen);
-
     int penWidth = pen.width();
     const QRect rct(QRect(penWidth, penWidth, rect().width() - penWidth * 2, rect().height() - penWidth * 2));
 
-    painter.drawRoundedRect(rct, rct.width() / 2.0, rct.height() / 2.0);
-
     // draw hour hand
     const qreal hourAngle = qreal(time.hour()) * 30 + time.minute() * 30 / 60;
     painter.save();
@@ -84,6 +76,35 @@ void Clock::paintEvent(QPaintEvent *)
     // LCOV_EXCL_STOP
 }
 
+QPixmap Clock::platePixmap(bool nightMode) const
+{
+    const qreal ratio = devicePixelRatioF();
+    const QString key = QString("dcc_world_clock_plate_%1x%2_%3@%4").arg(width()).arg(height()).arg(nightMode).arg(ratio);
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap))
+        return pixmap;
+
+    pixmap = QPixmap(size() * ratio);
+    pixmap.setDevicePixelRatio(ratio);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setRenderHints(painter.renderHints() | QPainter::Antialiasing);
+    painter.setBrush(nightMode ? Qt::black : Qt::white);
+
+    QPen pen(nightMode ? QColor(Qt::black) : QColor("#E6E6E6"));
+    pen.setWidth(1);
+    painter.setPen(pen);
+
+    int penWidth = pen.width();
+    const QRect rct(QRect(penWidth, penWidth, rect().width() - penWidth * 2, rect().height() - penWidth * 2));
+    painter.drawRoundedRect(rct, rct.width() / 2.0, rct.height() / 2.0);
+    painter.end();
+
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
+}
+
 bool Clock::autoNightMode() const
 {
     return m_autoNightMode;
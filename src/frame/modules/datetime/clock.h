@@ -6,6 +6,7 @@
 #define CLOCK_H
 
 #include <QWidget>
+#include <QPixmap>
 #include <QTimeZone>
 #include <types/zoneinfo.h>
 
@@ -31,6 +32,8 @@ protected:
     void paintEvent(QPaintEvent *event);
 
 private:
+    QPixmap platePixmap(bool nightMode) const;
+
     bool m_drawTicks;
     bool m_autoNightMode;
     ZoneInfo m_timeZone;
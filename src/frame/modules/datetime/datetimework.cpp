@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "datetimework.h"
+#include "timezone_dialog/timezone_database.h"
 #include <QDebug>
 
 #include <QtConcurrent>
@@ -13,6 +14,10 @@ namespace datetime {
 
 static ZoneInfo callbackZoneInfo(const QString &zoneId)
 {
+    // 在线程中调用，无效的时区不再请求后端
+    if (!installer::TimezoneDatabase::Instance().IsValid(zoneId))
+        return ZoneInfo();
+
     return DatetimeWork::getInstance().getTimedate()->GetZoneInfo(zoneId);
 }
 
@@ -326,6 +331,8 @@ void DatetimeWork::onTimezoneListChanged(const QStringList &timezones)
 
         for (int i = 0; i < future.resultCount(); i++) {
             ZoneInfo info = watcher->resultAt(i);
+            if (info.getZoneName().isEmpty())
+                continue;
             m_model->addUserTimeZone(info);
             records.append(info.getZoneName());
         }
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "map_pixmap_cache.h"
+
+namespace installer {
+
+namespace {
+
+// Levels whose width or height is smaller than this are not generated.
+const int kMinLevelSize = 64;
+
+// Default limit of total size of cached pixmaps, in kilobytes.
+const int kDefaultCostLimit = 16 * 1024;
+
+int PixmapCost(const QPixmap& pixmap) {
+  if (pixmap.isNull()) {
+    return 0;
+  }
+  return int(qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8 / 1024);
+}
+
+}  // namespace
+
+MapPixmapCache::MapPixmapCache(const QPixmap& source)
+    : cost_limit_(kDefaultCostLimit) {
+  this->SetSource(source);
+}
+
+void MapPixmapCache::SetSource(const QPixmap& source) {
+  levels_.clear();
+  last_used_.clear();
+  smooth_ = QPixmap();
+
+  levels_.append(source);
+  last_used_.append(0);
+  if (source.isNull()) {
+    return;
+  }
+
+  QSize size = this->LevelSize(levels_.length());
+  while (qMin(size.width(), size.height()) >= kMinLevelSize) {
+    levels_.append(QPixmap());
+    last_used_.append(0);
+    size = this->LevelSize(levels_.length());
+  }
+}
+
+QPixmap MapPixmapCache::Fast(const QSize& size) {
+  const QSize fitted = this->source().size().scaled(size, Qt::KeepAspectRatio);
+  if (fitted.isEmpty()) {
+    return QPixmap();
+  }
+
+  const QPixmap& pixmap = this->Level(this->LevelFor(fitted));
+  if (pixmap.size() == fitted) {
+    return pixmap;
+  }
+
+  QPixmap result = pixmap.scaled(fitted, Qt::IgnoreAspectRatio,
+                                 Qt::FastTransformation);
+  result.setDevicePixelRatio(this->source().devicePixelRatio());
+  return result;
+}
+
+QPixmap MapPixmapCache::Smooth(const QSize& size) {
+  const QSize fitted = this->source().size().scaled(size, Qt::KeepAspectRatio);
+  if (fitted.isEmpty()) {
+    return QPixmap();
+  }
+  if (smooth_.size() == fitted) {
+    return smooth_;
+  }
+
+  const QPixmap& pixmap = this->Level(this->LevelFor(fitted));
+  if (pixmap.size() == fitted) {
+    smooth_ = pixmap;
+  } else {
+    smooth_ = pixmap.scaled(fitted, Qt::IgnoreAspectRatio,
+                            Qt::SmoothTransformation);
+    smooth_.setDevicePixelRatio(this->source().devicePixelRatio());
+  }
+  return smooth_;
+}
+
+void MapPixmapCache::SetCostLimit(int kilobytes) {
+  cost_limit_ = kilobytes;
+  this->Trim();
+}
+
+int MapPixmapCache::cost() const {
+  int cost = 0;
+  bool smooth_cached = false;
+  for (const QPixmap& pixmap : levels_) {
+    cost += PixmapCost(pixmap);
+    smooth_cached |= !pixmap.isNull() && pixmap.cacheKey() == smooth_.cacheKey();
+  }
+  return smooth_cached ? cost : cost + PixmapCost(smooth_);
+}
+
+int MapPixmapCache::level_count() const {
+  int count = 0;
+  for (const QPixmap& pixmap : levels_) {
+    count += pixmap.isNull() ? 0 : 1;
+  }
+  return count;
+}
+
+QSize MapPixmapCache::LevelSize(int index) const {
+  QSize size = this->source().size();
+  for (int i = 0; i < index; i++) {
+    size = QSize((size.width() + 1) / 2, (size.height() + 1) / 2);
+  }
+  return size;
+}
+
+int MapPixmapCache::LevelFor(const QSize& size) const {
+  for (int index = levels_.length() - 1; index > 0; index--) {
+    const QSize level_size = this->LevelSize(index);
+    if (level_size.width() >= size.width() &&
+        level_size.height() >= size.height()) {
+      return index;
+    }
+  }
+  return 0;
+}
+
+const QPixmap& MapPixmapCache::Level(int index) {
+  last_used_[index] = ++clock_;
+  if (index > 0 && levels_.at(index).isNull()) {
+    // Scale from the nearest larger level, level 0 is always available.
+    int larger = index - 1;
+    while (levels_.at(larger).isNull()) {
+      larger--;
+    }
+    QPixmap pixmap = levels_.at(larger).scaled(this->LevelSize(index),
+                                               Qt::IgnoreAspectRatio,
+                                               Qt::SmoothTransformation);
+    pixmap.setDevicePixelRatio(this->source().devicePixelRatio());
+    levels_[index] = pixmap;
+    this->Trim();
+  }
+  return levels_.at(index);
+}
+
+void MapPixmapCache::Trim() {
+  while (this->cost() > cost_limit_) {
+    // Evict the least recently used level except level 0 and the one in use.
+    int evicted = -1;
+    for (int index = 1; index < levels_.length(); index++) {
+      if (!levels_.at(index).isNull() && last_used_.at(index) != clock_ &&
+          (evicted == -1 || last_used_.at(index) < last_used_.at(evicted))) {
+        evicted = index;
+      }
+    }
+    if (evicted == -1) {
+      break;
+    }
+    levels_[evicted] = QPixmap();
+  }
+}
+
+}  // namespace installer
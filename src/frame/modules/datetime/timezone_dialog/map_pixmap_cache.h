@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef INSTALLER_UI_WIDGETS_MAP_PIXMAP_CACHE_H
+#define INSTALLER_UI_WIDGETS_MAP_PIXMAP_CACHE_H
+
+#include <QPixmap>
+#include <QVector>
+
+namespace installer {
+
+// Pre-scaled copies of map image used while map is being resized.
+// Level 0 is the source pixmap and each next level is half the size of the
+// previous one. Levels are scaled smoothly on first use and kept until total
+// cost exceeds the limit, least recently used first. Level 0 is always kept.
+// All sizes are in device pixels.
+class MapPixmapCache {
+ public:
+  explicit MapPixmapCache(const QPixmap& source = QPixmap());
+
+  void SetSource(const QPixmap& source);
+  const QPixmap& source() const { return levels_.first(); }
+
+  // Pixmap to show during live resize: the nearest level no smaller than
+  // |size|, scaled with fast transformation if needed.
+  QPixmap Fast(const QSize& size);
+
+  // Pixmap scaled smoothly from the nearest level, the last one is cached.
+  QPixmap Smooth(const QSize& size);
+
+  // Limit of total size of cached pixmaps, in kilobytes.
+  void SetCostLimit(int kilobytes);
+
+  // Total size of cached pixmaps in kilobytes, and count of cached levels.
+  int cost() const;
+  int level_count() const;
+
+ private:
+  // Size of level |index|, and the deepest level to scale |size| from.
+  QSize LevelSize(int index) const;
+  int LevelFor(const QSize& size) const;
+  const QPixmap& Level(int index);
+  void Trim();
+
+  // Null if level is not generated yet or evicted.
+  QVector<QPixmap> levels_;
+  QVector<quint64> last_used_;
+  quint64 clock_ = 0;
+  int cost_limit_;
+
+  QPixmap smooth_;
+};
+
+}  // namespace installer
+
+#endif  // INSTALLER_UI_WIDGETS_MAP_PIXMAP_CACHE_H
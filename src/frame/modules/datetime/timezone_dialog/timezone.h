@@ -26,7 +26,8 @@ bool ZoneInfoDistanceComp(const ZoneInfo& a, const ZoneInfo& b);
 QDebug& operator<<(QDebug& debug, const ZoneInfo& info);
 typedef QList<ZoneInfo> ZoneInfoList;
 
-// Read available timezone info in zone.tab file.
+// Returns timezone info in zone.tab file.
+// The list is parsed once and shared, see TimezoneDatabase.
 ZoneInfoList GetZoneInfoList();
 
 // Find ZoneInfo based on |country| or |timezone|.
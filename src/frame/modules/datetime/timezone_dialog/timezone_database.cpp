@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "timezone_database.h"
+
+#include <cmath>
+#include <cstring>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QStringList>
+#include <QtEndian>
+
+#include "file_util.h"
+
+namespace installer {
+
+namespace {
+
+// Absolute path to zone.tab file.
+const char kZoneTabFile[] = "/usr/share/zoneinfo/zone1970.tab";
+
+// Absolute path to backward timezone file.
+const char kTimezoneAliasFile[] = "/timezone_alias";
+
+// Folder containing tzfile of each timezone.
+const char kZoneInfoDir[] = "/usr/share/zoneinfo/";
+
+// Domain name for timezones, and the folder its catalogs are installed in.
+const char kTimezoneDomain[] = "deepin-installer-timezones";
+const char kLocaleDir[] = "/usr/share/locale";
+
+const quint32 kMoMagic = 0x950412de;
+
+// Parse latitude and longitude of the zone's principal location.
+// See https://en.wikipedia.org/wiki/List_of_tz_database_time_zones.
+// |pos| is in ISO 6709 sign-degrees-minutes-seconds format,
+// either +-DDMM+-DDDMM or +-DDMMSS+-DDDMMSS.
+// |digits| 2 for latitude, 3 for longitude.
+double ConvertPos(const QString& pos, int digits) {
+  if (pos.length() < 4 || digits > 9) {
+    return 0.0;
+  }
+
+  const QString integer = pos.left(digits + 1);
+  const QString fraction = pos.mid(digits + 1);
+  const double t1 = integer.toDouble();
+  const double t2 = fraction.toDouble();
+  if (t1 > 0.0) {
+    return t1 + t2 / pow(10.0, fraction.length());
+  } else {
+    return t1 - t2 / pow(10.0, fraction.length());
+  }
+}
+
+ZoneInfoList ReadZoneTab() {
+  ZoneInfoList list;
+  const QString content(ReadFile(kZoneTabFile));
+  for (const QString& line : content.split('\n')) {
+    if (!line.startsWith('#')) {
+      const QStringList parts(line.split('\t'));
+      // Parse latitude and longitude.
+      if (parts.length() >= 3) {
+        const QString coordinates = parts.at(1);
+        int index = coordinates.indexOf('+', 3);
+        if (index == -1) {
+          index = coordinates.indexOf('-', 3);
+        }
+        Q_ASSERT(index > -1);
+        const double latitude = ConvertPos(coordinates.left(index), 2);
+        const double longitude = ConvertPos(coordinates.mid(index), 3);
+        const ZoneInfo zone_info = {parts.at(0), parts.at(2),
+                                    latitude, longitude, 0.0};
+        list.append(zone_info);
+      }
+    }
+  }
+  return list;
+}
+
+TimezoneAliasMap ReadAliasMap() {
+  TimezoneAliasMap map;
+
+  const QString content = ReadFile(kTimezoneAliasFile);
+  for (const QString& line : content.split('\n')) {
+    if (!line.isEmpty()) {
+      const QStringList parts = line.split(':');
+      Q_ASSERT(parts.length() == 2);
+      if (parts.length() == 2) {
+        map.insert(parts.at(0), parts.at(1));
+      }
+    }
+  }
+
+  return map;
+}
+
+// Read translations in GNU message catalog at |path| into |catalog|.
+// See https://www.gnu.org/software/gettext/manual/html_node/MO-Files.html
+bool ReadMoFile(const QString& path, QHash<QString, QString>& catalog) {
+  QByteArray content;
+  if (!ReadRawFile(path, content) || content.size() < 20) {
+    return false;
+  }
+
+  const uchar* data = reinterpret_cast<const uchar*>(content.constData());
+  const quint64 size = quint64(content.size());
+  const bool big_endian = qFromBigEndian<quint32>(data) == kMoMagic;
+  if (!big_endian && qFromLittleEndian<quint32>(data) != kMoMagic) {
+    qWarning() << "Invalid message catalog:" << path;
+    return false;
+  }
+  auto read = [data, big_endian](quint64 offset) {
+    return big_endian ? qFromBigEndian<quint32>(data + offset)
+                      : qFromLittleEndian<quint32>(data + offset);
+  };
+  // Message in catalog is nul terminated, only the singular form is used.
+  auto message = [data, size, &read](quint64 entry, QString& text) {
+    const quint64 length = read(entry);
+    const quint64 offset = read(entry + 4);
+    if (offset + length > size) {
+      return false;
+    }
+    const char* str = reinterpret_cast<const char*>(data + offset);
+    text = QString::fromUtf8(str, int(strnlen(str, length)));
+    return true;
+  };
+
+  const quint64 count = read(8);
+  const quint64 orig_table = read(12);
+  const quint64 trans_table = read(16);
+  if (orig_table + count * 8 > size || trans_table + count * 8 > size) {
+    qWarning() << "Invalid message catalog:" << path;
+    return false;
+  }
+
+  catalog.reserve(int(count));
+  for (quint64 i = 0; i < count; ++i) {
+    QString msgid, msgstr;
+    if (!message(orig_table + i * 8, msgid) ||
+        !message(trans_table + i * 8, msgstr)) {
+      return false;
+    }
+    // Skip header entry.
+    if (!msgid.isEmpty() && !msgstr.isEmpty()) {
+      catalog.insert(msgid, msgstr);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+const TimezoneDatabase& TimezoneDatabase::Instance() {
+  static const TimezoneDatabase database;
+  return database;
+}
+
+TimezoneDatabase::TimezoneDatabase()
+    : zones_(ReadZoneTab()),
+      aliases_(ReadAliasMap()) {
+  zone_index_.reserve(zones_.length());
+  for (int index = zones_.length() - 1; index >= 0; --index) {
+    zone_index_.insert(zones_.at(index).timezone, index);
+    country_index_.insert(zones_.at(index).country, index);
+  }
+}
+
+int TimezoneDatabase::IndexOfZone(const QString& timezone) const {
+  return zone_index_.value(timezone, -1);
+}
+
+int TimezoneDatabase::IndexOfCountry(const QString& country) const {
+  return country_index_.value(country, -1);
+}
+
+bool TimezoneDatabase::IsValid(const QString& timezone) const {
+  // Ignores empty timezone.
+  if (timezone.isEmpty()) {
+    return false;
+  }
+  if (zone_index_.contains(timezone)) {
+    return true;
+  }
+
+  // If |filepath| is a file or a symbolic link to file, it is a valid timezone.
+  return QFile::exists(QString(kZoneInfoDir) + timezone);
+}
+
+QString TimezoneDatabase::LocalName(const QString& timezone,
+                                    const QString& locale) const {
+  const QString local_name = GetCatalog(locale).value(timezone, timezone);
+  int index = local_name.lastIndexOf('/');
+  if (index == -1) {
+    // Some translations of locale name contains non-standard char.
+    index = local_name.lastIndexOf("∕");
+  }
+
+  return (index > -1) ? local_name.mid(index + 1) : local_name;
+}
+
+TimezoneOffset TimezoneDatabase::Offset(const QString& timezone,
+                                        qint64 time) const {
+  const QTimeZone zone = GetTimeZone(timezone);
+  if (!zone.isValid()) {
+    return {QString(), 0};
+  }
+
+  const QDateTime date_time = QDateTime::fromSecsSinceEpoch(time, Qt::UTC);
+  return {zone.abbreviation(date_time), zone.offsetFromUtc(date_time)};
+}
+
+TimezoneDatabase::Catalog TimezoneDatabase::GetCatalog(
+    const QString& locale) const {
+  {
+    QReadLocker locker(&catalog_lock_);
+    auto it = catalogs_.constFind(locale);
+    if (it != catalogs_.constEnd()) {
+      return it.value();
+    }
+  }
+
+  // Same lookup order as gettext: zh_CN.UTF-8@variant -> zh_CN -> zh.
+  QString name = locale.section('@', 0, 0).section('.', 0, 0);
+  QStringList candidates = {name};
+  if (name.contains('_')) {
+    candidates.append(name.section('_', 0, 0));
+  }
+
+  Catalog catalog;
+  for (const QString& candidate : candidates) {
+    const QString path = QString("%1/%2/LC_MESSAGES/%3.mo")
+        .arg(kLocaleDir, candidate, kTimezoneDomain);
+    catalog.clear();
+    if (QFile::exists(path) && ReadMoFile(path, catalog)) {
+      break;
+    }
+  }
+
+  QWriteLocker locker(&catalog_lock_);
+  catalogs_.insert(locale, catalog);
+  return catalog;
+}
+
+QTimeZone TimezoneDatabase::GetTimeZone(const QString& timezone) const {
+  QMutexLocker locker(&timezone_mutex_);
+  auto it = timezones_.find(timezone);
+  if (it == timezones_.end()) {
+    it = timezones_.insert(timezone, QTimeZone(timezone.toUtf8()));
+  }
+  return it.value();
+}
+
+}  // namespace installer
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef INSTALLER_SYSINFO_TIMEZONE_DATABASE_H
+#define INSTALLER_SYSINFO_TIMEZONE_DATABASE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QTimeZone>
+
+#include "timezone.h"
+
+namespace installer {
+
+// Process-wide, read-only timezone store.
+// zone.tab and the alias map are parsed once on first use; translation
+// catalogs and tzfile data are loaded on demand and kept for the lifetime
+// of the process. No global state (locale, TZ) is modified, so all methods
+// can be called from any thread.
+class TimezoneDatabase {
+ public:
+  static const TimezoneDatabase& Instance();
+
+  // Zones in zone.tab, in file order.
+  const ZoneInfoList& zones() const { return zones_; }
+
+  // Index of |timezone| or the first zone of |country| in zones().
+  // Returns -1 if not found.
+  int IndexOfZone(const QString& timezone) const;
+  int IndexOfCountry(const QString& country) const;
+
+  const TimezoneAliasMap& aliases() const { return aliases_; }
+
+  bool IsValid(const QString& timezone) const;
+
+  // Returns local name of |timezone| in |locale|, excluding continent name.
+  QString LocalName(const QString& timezone, const QString& locale) const;
+
+  // Returns GMT offset of |timezone| at |time| (seconds since epoch).
+  TimezoneOffset Offset(const QString& timezone, qint64 time) const;
+
+ private:
+  typedef QHash<QString, QString> Catalog;
+
+  TimezoneDatabase();
+  Q_DISABLE_COPY(TimezoneDatabase)
+
+  // Translations of timezone domain in |locale|, loaded on first use.
+  Catalog GetCatalog(const QString& locale) const;
+  QTimeZone GetTimeZone(const QString& timezone) const;
+
+  ZoneInfoList zones_;
+  QHash<QString, int> zone_index_;
+  QHash<QString, int> country_index_;
+  TimezoneAliasMap aliases_;
+
+  mutable QReadWriteLock catalog_lock_;
+  mutable QHash<QString, Catalog> catalogs_;
+  mutable QMutex timezone_mutex_;
+  mutable QHash<QString, QTimeZone> timezones_;
+};
+
+}  // namespace installer
+
+#endif  // INSTALLER_SYSINFO_TIMEZONE_DATABASE_H
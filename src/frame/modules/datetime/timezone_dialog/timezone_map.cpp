@@ -9,10 +9,12 @@
 #include <QLabel>
 #include <QListView>
 #include <QMouseEvent>
+#include <QTimer>
 #include <QVBoxLayout>
 #include "widgets/basiclistdelegate.h"
 
 #include "file_util.h"
+#include "timezone_database.h"
 #include "timezone_map_util.h"
 #include "popup_menu.h"
 #include "tooltip_pin.h"
@@ -26,6 +28,8 @@ const int kZonePinHeight = 30;
 const int kZonePinMinimumWidth = 60;
 
 const double kDistanceThreshold = 64.0;
+// Delay before map is rescaled smoothly after the last resize, in ms.
+const int kSmoothScaleDelay = 200;
 const char kDotFile[] = ":/timezone_dialog/images/indicator_active.png";
 const char kTimezoneMapFile[] = ":/timezone_dialog/images/timezone_map_big@1x.svg";
 
@@ -43,7 +47,8 @@ TimezoneMap::TimezoneMap(QWidget* parent)
     : QFrame(parent),
       current_zone_(),
       total_zones_(GetZoneInfoList()),
-      nearest_zones_() {
+      nearest_zones_(),
+      zone_index_(total_zones_) {
   this->setObjectName("timezone_map");
   this->setAccessibleName("timezone_map");
   this->initUI();
@@ -61,10 +66,18 @@ const QString TimezoneMap::getTimezone() const {
   return current_zone_.timezone;
 }
 
+void TimezoneMap::setHoverPreview(bool enabled) {
+  hover_preview_ = enabled;
+  this->setMouseTracking(enabled);
+  if (!enabled) {
+    this->previewZone(-1);
+  }
+}
+
 bool TimezoneMap::setTimezone(const QString &timezone)
 {
     nearest_zones_.clear();
-    const int index = GetZoneInfoByZone(total_zones_, timezone);
+    const int index = TimezoneDatabase::Instance().IndexOfZone(timezone);
     if (index > -1) {
         // 找到时区并标记到地图上
         current_zone_ = total_zones_.at(index);
@@ -82,11 +95,23 @@ bool TimezoneMap::setTimezone(const QString &timezone)
 void TimezoneMap::mousePressEvent(QMouseEvent* event) {
   if (event->button() == Qt::LeftButton) {
     // Get nearest zones around mouse.
-    nearest_zones_ = GetNearestZones(total_zones_, kDistanceThreshold,
-                                     event->x(), event->y(),
-                                     this->width(), this->height());
+    zone_index_.Resize(this->width(), this->height());
+    QList<int> indexes = zone_index_.Within(event->x(), event->y(),
+                                            kDistanceThreshold);
+    if (indexes.isEmpty()) {
+      indexes = zone_index_.Nearest(event->x(), event->y());
+    }
+    if (indexes.isEmpty()) {
+      return;
+    }
+
+    nearest_zones_.clear();
+    for (int index : indexes) {
+      nearest_zones_.append(total_zones_.at(index));
+    }
     qDebug() << nearest_zones_;
     current_zone_ = nearest_zones_.first();
+    hover_index_ = -1;
     if (nearest_zones_.length() == 1) {
         // 单个时区
       this->remark();
@@ -99,16 +124,43 @@ void TimezoneMap::mousePressEvent(QMouseEvent* event) {
   }
 }
 
+void TimezoneMap::mouseMoveEvent(QMouseEvent* event) {
+  if (hover_preview_ && !popup_window_->isVisible()) {
+    // 只查找鼠标附近的格子，每次移动都可以调用
+    zone_index_.Resize(this->width(), this->height());
+    const QList<int> indexes = zone_index_.Nearest(event->x(), event->y());
+    int index = -1;
+    if (!indexes.isEmpty()) {
+      const QPointF delta = zone_index_.Position(indexes.first()) - event->localPos();
+      if (QPointF::dotProduct(delta, delta) <= kDistanceThreshold) {
+        index = indexes.first();
+      }
+    }
+    this->previewZone(index);
+  }
+
+  QWidget::mouseMoveEvent(event);
+}
+
+void TimezoneMap::leaveEvent(QEvent* event) {
+  if (!popup_window_->isVisible()) {
+    this->previewZone(-1);
+  }
+
+  QWidget::leaveEvent(event);
+}
+
 void TimezoneMap::resizeEvent(QResizeEvent* event) {
   if (popup_window_->isVisible()) {
     dot_->hide();
     popup_window_->hide();
   }
 
+  // 缩放过程中使用预先缩放好的地图，停止缩放后再平滑缩放
   QLabel *background_label = findChild<QLabel*>("background_label");
   if (background_label) {
-      QPixmap timezone_pixmap = loadPixmap(kTimezoneMapFile);
-      background_label->setPixmap(timezone_pixmap.scaled(event->size() * devicePixelRatioF(), Qt::KeepAspectRatio, Qt::FastTransformation));
+      background_label->setPixmap(map_cache_.Fast(event->size() * devicePixelRatioF()));
+      smooth_timer_->start();
   }
 
   QWidget::resizeEvent(event);
@@ -127,9 +179,16 @@ void TimezoneMap::initConnections() {
 void TimezoneMap::initUI() {
   QLabel* background_label = new QLabel(this);
   background_label->setObjectName("background_label");
-  QPixmap timezone_pixmap = loadPixmap(kTimezoneMapFile);
-  Q_ASSERT(!timezone_pixmap.isNull());
-  background_label->setPixmap(timezone_pixmap);
+  map_cache_.SetSource(loadPixmap(kTimezoneMapFile));
+  Q_ASSERT(!map_cache_.source().isNull());
+  background_label->setPixmap(map_cache_.source());
+
+  smooth_timer_ = new QTimer(this);
+  smooth_timer_->setSingleShot(true);
+  smooth_timer_->setInterval(kSmoothScaleDelay);
+  connect(smooth_timer_, &QTimer::timeout, background_label, [=] {
+    background_label->setPixmap(map_cache_.Smooth(this->size() * devicePixelRatioF()));
+  });
 
   // Set parent widget of dot_ to SystemInfoTimezoneFrame.
   dot_ = new QLabel(this->parentWidget());
@@ -180,6 +239,13 @@ void TimezoneMap::popupZoneWindow(const QPoint& pos) {
 }
 
 void TimezoneMap::remark() {
+  Q_ASSERT(!nearest_zones_.isEmpty());
+  if (!nearest_zones_.isEmpty()) {
+    this->markZone(current_zone_);
+  }
+}
+
+void TimezoneMap::markZone(const ZoneInfo& zone) {
   // Hide all marks first.
   dot_->hide();
   zone_pin_->hide();
@@ -188,34 +254,47 @@ void TimezoneMap::remark() {
   const int map_width = this->width();
   const int map_height = this->height();
 
-  Q_ASSERT(!nearest_zones_.isEmpty());
   const QString locale = QLocale::system().name();
-  if (!nearest_zones_.isEmpty()) {
-    zone_pin_->setText(GetLocalTimezoneName(current_zone_.timezone, locale));
+  zone_pin_->setText(GetLocalTimezoneName(zone.timezone, locale));
 
-    // Adjust size of pin to fit its content.
-    zone_pin_->adjustSize();
+  // Adjust size of pin to fit its content.
+  zone_pin_->adjustSize();
 
-    // Show zone pin at current marked zone.
-    const QPoint zone_pos = ZoneInfoToPosition(current_zone_, map_width,
-                                               map_height);
-    const int zone_dy = zone_pos.y() - dot_->height() / 2 - kDotVerticalMargin;
-    const QPoint zone_pin_relative_pos(zone_pos.x(), zone_dy);
-    const QPoint zone_pin_pos(this->mapToParent(zone_pin_relative_pos));
+  // Show zone pin at current marked zone.
+  const QPoint zone_pos = ZoneInfoToPosition(zone, map_width, map_height);
+  const int zone_dy = zone_pos.y() - dot_->height() / 2 - kDotVerticalMargin;
+  const QPoint zone_pin_relative_pos(zone_pos.x(), zone_dy);
+  const QPoint zone_pin_pos(this->mapToParent(zone_pin_relative_pos));
 
-    if (zone_pin_pos.x() < 100) {
-        // 左侧位置不够，箭头放到左边
-        zone_pin_->setArrowDirection(TooltipPin::ArrowLeft);
-    } else {
-        zone_pin_->setArrowDirection(TooltipPin::ArrowDown);
-    }
-    zone_pin_->popup(zone_pin_pos);
+  if (zone_pin_pos.x() < 100) {
+      // 左侧位置不够，箭头放到左边
+      zone_pin_->setArrowDirection(TooltipPin::ArrowLeft);
+  } else {
+      zone_pin_->setArrowDirection(TooltipPin::ArrowDown);
+  }
+  zone_pin_->popup(zone_pin_pos);
 
-    const QPoint dot_relative_pos(zone_pos.x() - dot_->width() / 2,
-                                  zone_pos.y() - dot_->height() / 2);
-    const QPoint dot_pos(this->mapToParent(dot_relative_pos));
-    dot_->move(dot_pos);
-    dot_->show();
+  const QPoint dot_relative_pos(zone_pos.x() - dot_->width() / 2,
+                                zone_pos.y() - dot_->height() / 2);
+  const QPoint dot_pos(this->mapToParent(dot_relative_pos));
+  dot_->move(dot_pos);
+  dot_->show();
+}
+
+void TimezoneMap::previewZone(int index) {
+  // 预览的时区没有变化时不重新绘制
+  if (index == hover_index_) {
+    return;
+  }
+  hover_index_ = index;
+
+  if (index > -1) {
+    this->markZone(total_zones_.at(index));
+  } else if (!nearest_zones_.isEmpty()) {
+    this->remark();
+  } else {
+    dot_->hide();
+    zone_pin_->hide();
   }
 }
 
@@ -10,8 +10,11 @@ class QLabel;
 class QListView;
 class QResizeEvent;
 class QStringListModel;
+class QTimer;
 
+#include "map_pixmap_cache.h"
 #include "timezone.h"
+#include "timezone_map_util.h"
 
 namespace installer {
 
@@ -29,6 +32,9 @@ class TimezoneMap : public QFrame {
   // Get current selected timezone, might be empty.
   const QString getTimezone() const;
 
+  // Preview the zone under cursor with zone pin when mouse moves on the map.
+  void setHoverPreview(bool enabled);
+
  Q_SIGNALS:
   void timezoneUpdated(const QString& timezone);
 
@@ -38,6 +44,8 @@ class TimezoneMap : public QFrame {
 
  protected:
   void mousePressEvent(QMouseEvent* event) override;
+  void mouseMoveEvent(QMouseEvent* event) override;
+  void leaveEvent(QEvent* event) override;
 
   // Hide tooltips when window is resized.
   void resizeEvent(QResizeEvent* event) override;
@@ -52,6 +60,13 @@ class TimezoneMap : public QFrame {
   // Mark current zone on the map.
   void remark();
 
+  // Show dot and zone pin at |zone|.
+  void markZone(const ZoneInfo& zone);
+
+  // Preview zone at |index| of total_zones_, or restore current zone if
+  // |index| is -1.
+  void previewZone(int index);
+
   // Currently selected/marked timezone.
   ZoneInfo current_zone_;
 
@@ -61,6 +76,18 @@ class TimezoneMap : public QFrame {
   // A list of zone info which are near enough to current cursor position.
   ZoneInfoList nearest_zones_;
 
+  // Positions of total_zones_ on the map, updated when map is resized.
+  ZoneIndex zone_index_;
+
+  bool hover_preview_ = false;
+  // Index of zone being previewed, -1 if none.
+  int hover_index_ = -1;
+
+  // Pre-scaled map pixmaps, and timer to rescale map smoothly once
+  // resizing settles.
+  MapPixmapCache map_cache_;
+  QTimer* smooth_timer_ = nullptr;
+
   // A round dot to indicate position on the map.
   QLabel* dot_ = nullptr;
 
@@ -5,11 +5,17 @@
 #include "timezone_map_util.h"
 
 #include <math.h>
+#include <algorithm>
+#include <limits>
+#include <QPair>
 
 namespace installer {
 
 namespace {
 
+// Size of grid cell in ZoneIndex, in pixels.
+const int kCellSize = 16;
+
 // From gnome-control-center.
 double radians(double degrees) {
   return (degrees / 360.0) * M_PI * 2;
@@ -38,33 +44,172 @@ double ConvertLongitudeToX(double longitude) {
   return ((180.0 + longitude) / 360.0 + xdeg_offset / 180.0);
 }
 
-ZoneInfoList GetNearestZones(const ZoneInfoList& total_zones, double threshold,
-                             int x, int y, int map_width, int map_height) {
-  ZoneInfoList zones;
-  double minimum_distance = map_width * map_width + map_height * map_height;
-  int nearest_zone_index = -1;
-  for (int index = 0; index < total_zones.length(); index++) {
-    const ZoneInfo& zone = total_zones.at(index);
-    const double point_x = ConvertLongitudeToX(zone.longitude) * map_width;
-    const double point_y = ConvertLatitudeToY(zone.latitude) * map_height;
-    const double dx = point_x - x;
-    const double dy = point_y - y;
-    const double distance = dx * dx + dy * dy;
-    if (distance < minimum_distance) {
-      minimum_distance = distance;
-      nearest_zone_index = index;
-    }
-    if (distance <= threshold) {
-      zones.append(zone);
+ZoneIndex::ZoneIndex(const ZoneInfoList& zones) : zones_(zones) {
+}
+
+void ZoneIndex::SetZones(const ZoneInfoList& zones) {
+  zones_ = zones;
+  if (map_width_ >= 0 && map_height_ >= 0) {
+    this->Rebuild();
+  }
+}
+
+void ZoneIndex::Resize(int map_width, int map_height) {
+  if (map_width == map_width_ && map_height == map_height_) {
+    return;
+  }
+  map_width_ = map_width;
+  map_height_ = map_height;
+  this->Rebuild();
+}
+
+void ZoneIndex::Rebuild() {
+  columns_ = qMax(1, (map_width_ + kCellSize - 1) / kCellSize);
+  rows_ = qMax(1, (map_height_ + kCellSize - 1) / kCellSize);
+
+  positions_.resize(zones_.length());
+  QVector<int> cells(zones_.length());
+  cell_start_.fill(0, columns_ * rows_ + 1);
+  for (int index = 0; index < zones_.length(); index++) {
+    const ZoneInfo& zone = zones_.at(index);
+    positions_[index] = QPointF(ConvertLongitudeToX(zone.longitude) * map_width_,
+                                ConvertLatitudeToY(zone.latitude) * map_height_);
+    cells[index] = this->CellRow(positions_[index].y()) * columns_ +
+                   this->CellColumn(positions_[index].x());
+    cell_start_[cells[index] + 1]++;
+  }
+
+  // Counting sort, zones in the same cell keep list order.
+  for (int cell = 0; cell < columns_ * rows_; cell++) {
+    cell_start_[cell + 1] += cell_start_[cell];
+  }
+  cell_items_.resize(zones_.length());
+  QVector<int> next(cell_start_);
+  for (int index = 0; index < zones_.length(); index++) {
+    cell_items_[next[cells[index]]++] = index;
+  }
+}
+
+int ZoneIndex::CellColumn(double x) const {
+  return qBound(0, int(floor(x / kCellSize)), columns_ - 1);
+}
+
+int ZoneIndex::CellRow(double y) const {
+  return qBound(0, int(floor(y / kCellSize)), rows_ - 1);
+}
+
+QList<int> ZoneIndex::Within(double x, double y, double threshold) const {
+  QList<int> result;
+  if (positions_.isEmpty() || threshold < 0) {
+    return result;
+  }
+
+  const double radius = sqrt(threshold);
+  const int left = this->CellColumn(x - radius);
+  const int right = this->CellColumn(x + radius);
+  const int top = this->CellRow(y - radius);
+  const int bottom = this->CellRow(y + radius);
+  for (int row = top; row <= bottom; row++) {
+    for (int column = left; column <= right; column++) {
+      const int cell = row * columns_ + column;
+      for (int i = cell_start_[cell]; i < cell_start_[cell + 1]; i++) {
+        const QPointF& point = positions_.at(cell_items_.at(i));
+        const double dx = point.x() - x;
+        const double dy = point.y() - y;
+        if (dx * dx + dy * dy <= threshold) {
+          result.append(cell_items_.at(i));
+        }
+      }
     }
   }
 
-  // Get the nearest zone.
-  if (zones.isEmpty()) {
-    zones.append(total_zones.at(nearest_zone_index));
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+QList<int> ZoneIndex::Nearest(double x, double y, int count) const {
+  QList<int> result;
+  count = qMin(count, positions_.size());
+  if (count <= 0) {
+    return result;
   }
 
-  return zones;
+  // Sorted by distance and index, at most |count| items.
+  typedef QPair<double, int> Candidate;
+  QVector<Candidate> candidates;
+  auto visit = [&](int row, int column) {
+    const int cell = row * columns_ + column;
+    for (int i = cell_start_[cell]; i < cell_start_[cell + 1]; i++) {
+      const int index = cell_items_.at(i);
+      const double dx = positions_.at(index).x() - x;
+      const double dy = positions_.at(index).y() - y;
+      const Candidate candidate(dx * dx + dy * dy, index);
+      if (candidates.size() < count || candidate < candidates.last()) {
+        candidates.insert(std::upper_bound(candidates.begin(),
+                                           candidates.end(), candidate),
+                          candidate);
+        if (candidates.size() > count) {
+          candidates.removeLast();
+        }
+      }
+    }
+  };
+
+  // Visit rings of cells around (x, y) until no unvisited cell can be
+  // nearer than the candidates found.
+  const int center_row = this->CellRow(y);
+  const int center_column = this->CellColumn(x);
+  for (int ring = 0; ; ring++) {
+    const int top = center_row - ring;
+    const int bottom = center_row + ring;
+    const int left = center_column - ring;
+    const int right = center_column + ring;
+    for (int column = qMax(left, 0); column <= qMin(right, columns_ - 1);
+         column++) {
+      if (top >= 0) {
+        visit(top, column);
+      }
+      if (bottom < rows_ && bottom != top) {
+        visit(bottom, column);
+      }
+    }
+    for (int row = qMax(top + 1, 0); row <= qMin(bottom - 1, rows_ - 1);
+         row++) {
+      if (left >= 0) {
+        visit(row, left);
+      }
+      if (right < columns_ && right != left) {
+        visit(row, right);
+      }
+    }
+
+    // Distance from (x, y) to cells outside of the visited ones.
+    double bound = std::numeric_limits<double>::max();
+    if (left > 0) {
+      bound = qMin(bound, x - left * kCellSize);
+    }
+    if (right < columns_ - 1) {
+      bound = qMin(bound, (right + 1) * kCellSize - x);
+    }
+    if (top > 0) {
+      bound = qMin(bound, y - top * kCellSize);
+    }
+    if (bottom < rows_ - 1) {
+      bound = qMin(bound, (bottom + 1) * kCellSize - y);
+    }
+    if (bound == std::numeric_limits<double>::max()) {
+      break;
+    }
+    bound = qMax(bound, 0.0);
+    if (candidates.size() == count && candidates.last().first <= bound * bound) {
+      break;
+    }
+  }
+
+  for (const Candidate& candidate : candidates) {
+    result.append(candidate.second);
+  }
+  return result;
 }
 
 }  // namespace installer
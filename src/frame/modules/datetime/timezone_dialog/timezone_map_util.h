@@ -5,6 +5,9 @@
 #ifndef INSTALLER_DELEGATES_TIMEZONE_MAP_UTIL_H
 #define INSTALLER_DELEGATES_TIMEZONE_MAP_UTIL_H
 
+#include <QPointF>
+#include <QVector>
+
 #include "timezone.h"
 
 namespace installer {
@@ -13,10 +16,47 @@ namespace installer {
 double ConvertLatitudeToY(double latitude);
 double ConvertLongitudeToX(double longitude);
 
-// Get a list of zone info whose distance to (x, y) is less than |threshold|
-// in a world map with size (map_width, map_height).
-ZoneInfoList GetNearestZones(const ZoneInfoList& total_zones, double threshold,
-                             int x, int y, int map_width, int map_height);
+// Spatial index of zones on a world map.
+// Positions of zones are projected once per map size and bucketed into a
+// uniform grid, so hit-testing only visits the cells around (x, y).
+class ZoneIndex {
+ public:
+  explicit ZoneIndex(const ZoneInfoList& zones = ZoneInfoList());
+
+  void SetZones(const ZoneInfoList& zones);
+
+  // Project zones on a map with size (map_width, map_height).
+  // Does nothing if size is not changed.
+  void Resize(int map_width, int map_height);
+
+  // Position of zone at |index| on the map.
+  QPointF Position(int index) const { return positions_.at(index); }
+
+  // Indexes of zones whose squared distance to (x, y) is no more than
+  // |threshold|, in the same order as zone list.
+  QList<int> Within(double x, double y, double threshold) const;
+
+  // Indexes of at most |count| zones nearest to (x, y), nearest first.
+  // Zones with the same distance are ordered by index.
+  QList<int> Nearest(double x, double y, int count = 1) const;
+
+ private:
+  void Rebuild();
+  int CellColumn(double x) const;
+  int CellRow(double y) const;
+
+  ZoneInfoList zones_;
+  int map_width_ = -1;
+  int map_height_ = -1;
+  int columns_ = 0;
+  int rows_ = 0;
+  QVector<QPointF> positions_;
+
+  // Zones in cell i (row major) are cell_items_[cell_start_[i], cell_start_[i + 1]).
+  // Zones outside of the map are put into the nearest border cell.
+  QVector<int> cell_start_;
+  QVector<int> cell_items_;
+};
 
 }  // namespace installer
 
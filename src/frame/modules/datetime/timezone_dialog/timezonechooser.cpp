@@ -55,6 +55,8 @@ TimeZoneChooser::TimeZoneChooser(QWidget* parent)
     m_cancelBtn->setMinimumSize(200, 36);
     m_confirmBtn->setMinimumSize(200, 36);
     m_confirmBtn->setEnabled(false);
+    // 鼠标移动到时区附近时显示时区名称
+    m_map->setHoverPreview(true);
 
     DPalette pa = DApplicationHelper::instance()->palette(m_title);
     pa.setBrush(QPalette::WindowText, pa.windowText());
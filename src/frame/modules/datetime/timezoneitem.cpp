@@ -125,6 +125,7 @@ void TimezoneItem::updateInfo()
     m_details->setText(QString("%1, %2").arg(dateLiteral).arg(compareLiteral));
     m_city->setText(m_timezone.getZoneCity() + gmData);
     m_clock->setTimeZone(m_timezone);
+    m_clock->update();
 
     m_removeBtn->setAccessibleName(m_timezone.getZoneCity() + "_DEL");
 }
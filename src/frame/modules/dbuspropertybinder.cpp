@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbuspropertybinder.h"
+#include "window/tracer.h"
+
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDebug>
+#include <QMutex>
+#include <QSharedPointer>
+
+using namespace dcc;
+
+namespace {
+const QString PropertiesInterface = "org.freedesktop.DBus.Properties";
+
+// prefetch 的结果，在线程池中写入，在主线程中读取
+QMutex PrefetchMutex;
+QHash<QString, QVariantMap> PrefetchCache;
+
+QString prefetchKey(const QString &service, const QString &path, const QString &interface)
+{
+    return service + path + "/" + interface;
+}
+}
+
+DBusPropertyBinder::DBusPropertyBinder(const QString &service, const QString &path, const QString &interface,
+                                       const QDBusConnection &connection, QObject *parent)
+    : QObject(parent)
+    , m_service(service)
+    , m_path(path)
+    , m_interface(interface)
+    , m_connection(connection)
+    , m_active(true)
+    , m_pendingCount(0)
+{
+    m_connection.connect(m_service, m_path, PropertiesInterface, "PropertiesChanged",
+                         this, SLOT(onPropertiesChanged(QDBusMessage)));
+}
+
+void DBusPropertyBinder::addBinding(const QString &property, QObject *context, const std::function<void(const QVariant &)> &apply)
+{
+    m_bindings[property].append({ context, apply });
+}
+
+void DBusPropertyBinder::refresh()
+{
+    // 先使用 prefetch 的结果，再异步读取一次，更新 prefetch 之后、绑定之前变化的属性
+    const QVariantMap &prefetched = takePrefetched(m_service, m_path, m_interface);
+    for (auto it = prefetched.cbegin(); it != prefetched.cend(); ++it)
+        apply(it.key(), it.value());
+
+    QDBusMessage message = QDBusMessage::createMethodCall(m_service, m_path, PropertiesInterface, "GetAll");
+    message << m_interface;
+
+    if (m_pendingCount == 0)
+        m_changedWhilePending.clear();
+    ++m_pendingCount;
+
+    QSharedPointer<DCC_NAMESPACE::TraceSpan> span(new DCC_NAMESPACE::TraceSpan("dbus", "GetAll", m_path));
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_connection.asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, span](QDBusPendingCallWatcher *w) {
+        span->finish();
+        onGetAllFinished(w);
+    });
+}
+
+QVariantMap DBusPropertyBinder::prefetch(const QString &service, const QString &path, const QString &interface,
+                                         const QDBusConnection &connection)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(service, path, PropertiesInterface, "GetAll");
+    message << interface;
+
+    DCC_TRACE_SCOPE("dbus", "prefetchGetAll", path);
+    const QDBusMessage reply = connection.call(message);
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+        qWarning() << "prefetch properties of" << service << path << "failed:" << reply.errorMessage();
+        return QVariantMap();
+    }
+
+    const QVariantMap &properties = qdbus_cast<QVariantMap>(reply.arguments().first());
+    QMutexLocker locker(&PrefetchMutex);
+    PrefetchCache.insert(prefetchKey(service, path, interface), properties);
+    return properties;
+}
+
+QVariantMap DBusPropertyBinder::takePrefetched(const QString &service, const QString &path, const QString &interface)
+{
+    QMutexLocker locker(&PrefetchMutex);
+    return PrefetchCache.take(prefetchKey(service, path, interface));
+}
+
+void DBusPropertyBinder::clearPrefetched()
+{
+    QMutexLocker locker(&PrefetchMutex);
+    PrefetchCache.clear();
+}
+
+void DBusPropertyBinder::onGetAllFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+    --m_pendingCount;
+
+    QDBusPendingReply<QVariantMap> reply = *watcher;
+    if (reply.isError()) {
+        qWarning() << "get properties of" << m_service << m_path << "failed:" << reply.error().message();
+        return;
+    }
+
+    const QVariantMap &properties = reply.value();
+    for (auto it = properties.cbegin(); it != properties.cend(); ++it) {
+        if (!m_changedWhilePending.contains(it.key()))
+            apply(it.key(), it.value());
+    }
+
+    Q_EMIT refreshed();
+}
+
+void DBusPropertyBinder::onPropertiesChanged(const QDBusMessage &message)
+{
+    const QList<QVariant> &arguments = message.arguments();
+    if (!m_active || arguments.size() != 3 || arguments.at(0).toString() != m_interface)
+        return;
+
+    const QVariantMap &changed = qdbus_cast<QVariantMap>(arguments.at(1));
+    for (auto it = changed.cbegin(); it != changed.cend(); ++it) {
+        if (m_pendingCount > 0)
+            m_changedWhilePending.insert(it.key());
+        apply(it.key(), it.value());
+    }
+
+    // 只通知了失效的属性时重新读取
+    for (const QString &property : qdbus_cast<QStringList>(arguments.at(2))) {
+        if (m_bindings.contains(property)) {
+            refresh();
+            break;
+        }
+    }
+}
+
+void DBusPropertyBinder::apply(const QString &property, const QVariant &value)
+{
+    auto it = m_bindings.find(property);
+    if (it == m_bindings.end())
+        return;
+
+    for (const Binding &binding : it.value()) {
+        if (binding.context)
+            binding.apply(value);
+    }
+}
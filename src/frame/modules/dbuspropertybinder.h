@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DBUSPROPERTYBINDER_H
+#define DBUSPROPERTYBINDER_H
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QVariant>
+
+#include <functional>
+#include <type_traits>
+
+class QDBusPendingCallWatcher;
+
+namespace dcc {
+
+/**
+ * @brief The DBusPropertyBinder class
+ * 将一个 D-Bus 对象的属性绑定到 model 的 setter 上：
+ * refresh() 通过一次异步的 org.freedesktop.DBus.Properties.GetAll 读取所有属性，
+ * 之后通过 PropertiesChanged 信号只更新变化的属性，不在主线程中同步读取属性。
+ * 启动时模块可以在线程池中通过 prefetch() 提前读取属性，第一次 refresh() 时直接使用
+ */
+class DBusPropertyBinder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DBusPropertyBinder(const QString &service, const QString &path, const QString &interface,
+                                const QDBusConnection &connection, QObject *parent = nullptr);
+
+    // 绑定到成员函数，receiver 销毁后自动失效
+    template<typename Receiver, typename Class, typename Arg>
+    void bind(const QString &property, Receiver *receiver, void (Class::*setter)(Arg))
+    {
+        typedef typename std::decay<Arg>::type Type;
+        addBinding(property, receiver, [receiver, setter](const QVariant &value) {
+            (receiver->*setter)(qdbus_cast<Type>(value));
+        });
+    }
+
+    // 绑定到函数，需要指定属性的类型，例如 bind<QString>("UserName", user, [=](const QString &name) {...})
+    template<typename T>
+    void bind(const QString &property, QObject *context, std::function<void(const T &)> func)
+    {
+        addBinding(property, context, [func](const QVariant &value) {
+            func(qdbus_cast<T>(value));
+        });
+    }
+
+    // 异步读取所有属性，返回后调用所有绑定的 setter
+    void refresh();
+
+    // 在线程池中同步读取所有属性并缓存，只在启动预初始化期间有效，结束后调用 clearPrefetched() 清除
+    static QVariantMap prefetch(const QString &service, const QString &path, const QString &interface,
+                                const QDBusConnection &connection);
+    static QVariantMap takePrefetched(const QString &service, const QString &path, const QString &interface);
+    static void clearPrefetched();
+    // 未激活时忽略属性变化，对应 worker 的 activate/deactivate
+    inline void setActive(bool active) { m_active = active; }
+    inline bool isActive() const { return m_active; }
+
+Q_SIGNALS:
+    // refresh() 读取到数据后发出
+    void refreshed();
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QDBusMessage &message);
+    void onGetAllFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    struct Binding {
+        QPointer<QObject> context;
+        std::function<void(const QVariant &)> apply;
+    };
+
+    void addBinding(const QString &property, QObject *context, const std::function<void(const QVariant &)> &apply);
+    void apply(const QString &property, const QVariant &value);
+
+private:
+    QString m_service;
+    QString m_path;
+    QString m_interface;
+    QDBusConnection m_connection;
+    QHash<QString, QList<Binding>> m_bindings;
+    bool m_active;
+    int m_pendingCount;
+    // GetAll 返回前已经通过 PropertiesChanged 更新的属性，GetAll 的结果可能更旧，不再覆盖
+    QSet<QString> m_changedWhilePending;
+};
+
+}
+
+#endif // DBUSPROPERTYBINDER_H
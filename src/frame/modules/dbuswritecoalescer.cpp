@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbuswritecoalescer.h"
+
+#include <QDBusPendingCallWatcher>
+#include <QDebug>
+
+using namespace dcc;
+
+DBusWriteCoalescer::DBusWriteCoalescer(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void DBusWriteCoalescer::write(QObject *object, const QString &property, const Call &call)
+{
+    if (!object || !call)
+        return;
+
+    if (!m_watchedObjects.contains(object)) {
+        m_watchedObjects.insert(object);
+        connect(object, &QObject::destroyed, this, &DBusWriteCoalescer::onObjectDestroyed);
+    }
+
+    const Key key(object, property);
+    Entry &entry = m_entries[key];
+    ++entry.metrics.requested;
+    ++m_metrics.requested;
+
+    // 前一个请求还没有发送，直接用新的值替换
+    if (entry.waiting) {
+        ++entry.metrics.dropped;
+        ++m_metrics.dropped;
+    }
+    entry.waiting = call;
+
+    if (!entry.inFlight)
+        send(key);
+}
+
+bool DBusWriteCoalescer::isPending(QObject *object, const QString &property) const
+{
+    auto it = m_entries.constFind(Key(object, property));
+    return it != m_entries.cend() && (it->inFlight || it->waiting);
+}
+
+DBusWriteCoalescer::Metrics DBusWriteCoalescer::metrics(QObject *object, const QString &property) const
+{
+    return m_entries.value(Key(object, property)).metrics;
+}
+
+void DBusWriteCoalescer::send(const Key &key)
+{
+    Entry &entry = m_entries[key];
+    const Call call = entry.waiting;
+    entry.waiting = nullptr;
+    entry.inFlight = true;
+    ++entry.metrics.sent;
+    ++m_metrics.sent;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, key, watcher] {
+        onFinished(key, watcher);
+    });
+}
+
+void DBusWriteCoalescer::onFinished(const Key &key, QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+
+    // 对象已经销毁
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    it->inFlight = false;
+    if (watcher->isError()) {
+        ++it->metrics.failed;
+        ++m_metrics.failed;
+        qWarning() << "failed to write" << key.second << ":" << watcher->error().message();
+    }
+
+    if (it->waiting) {
+        send(key);
+        return;
+    }
+
+    Q_EMIT written(key.first, key.second);
+}
+
+void DBusWriteCoalescer::onObjectDestroyed(QObject *object)
+{
+    m_watchedObjects.remove(object);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.key().first == object)
+            it = m_entries.erase(it);
+        else
+            ++it;
+    }
+}
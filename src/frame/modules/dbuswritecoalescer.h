@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DBUSWRITECOALESCER_H
+#define DBUSWRITECOALESCER_H
+
+#include <QDBusPendingCall>
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+
+#include <functional>
+
+class QDBusPendingCallWatcher;
+
+namespace dcc {
+
+/**
+ * @brief The DBusWriteCoalescer class
+ * 合并滑动条等频繁触发的 D-Bus 写操作：同一个 (对象, 属性) 同时只有一个调用在等待返回，
+ * 返回前的新请求只保留最新的一个，返回后再发送，中间的值直接丢弃
+ */
+class DBusWriteCoalescer : public QObject
+{
+    Q_OBJECT
+public:
+    // 发起异步调用，例如 [=] { return sink->SetVolume(volume, true); }
+    typedef std::function<QDBusPendingCall()> Call;
+
+    struct Metrics {
+        quint64 requested = 0;  // 收到的请求
+        quint64 sent = 0;       // 实际发送的调用
+        quint64 dropped = 0;    // 被更新的值替换、没有发送的请求
+        quint64 failed = 0;     // 返回错误的调用
+    };
+
+    explicit DBusWriteCoalescer(QObject *parent = nullptr);
+
+    // object 销毁后丢弃还没有发送的请求
+    void write(QObject *object, const QString &property, const Call &call);
+
+    bool isPending(QObject *object, const QString &property) const;
+    inline const Metrics &metrics() const { return m_metrics; }
+    Metrics metrics(QObject *object, const QString &property) const;
+
+Q_SIGNALS:
+    // 最新的值已经写入
+    void written(QObject *object, const QString &property);
+
+private:
+    typedef QPair<QObject *, QString> Key;
+
+    struct Entry {
+        bool inFlight = false;
+        Call waiting;
+        Metrics metrics;
+    };
+
+    void send(const Key &key);
+    void onFinished(const Key &key, QDBusPendingCallWatcher *watcher);
+    void onObjectDestroyed(QObject *object);
+
+private:
+    QHash<Key, Entry> m_entries;
+    QSet<QObject *> m_watchedObjects;
+    Metrics m_metrics;
+};
+
+}
+
+#endif // DBUSWRITECOALESCER_H
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "displaytransaction.h"
+#include "window/tracer.h"
+
+#include <QDBusPendingCallWatcher>
+#include <QDebug>
+#include <QSharedPointer>
+
+using namespace dcc::display;
+
+DisplayTransaction::DisplayTransaction(DisplayInter *displayInter, QObject *parent)
+    : QObject(parent)
+    , m_displayInter(displayInter)
+    , m_flags(NoFlags)
+    , m_running(false)
+    , m_waitingCount(0)
+{
+
+}
+
+void DisplayTransaction::addStep(const QString &name, const Call &apply, const Call &rollback)
+{
+    if (m_running) {
+        qWarning() << "display transaction is running, ignore" << name;
+        return;
+    }
+
+    for (Step &step : m_steps) {
+        if (step.name == name) {
+            step.apply = apply;
+            return;
+        }
+    }
+
+    Step step;
+    step.name = name;
+    step.apply = apply;
+    step.rollback = rollback;
+    m_steps << step;
+}
+
+void DisplayTransaction::commit(CommitFlags flags)
+{
+    if (m_running)
+        return;
+
+    m_running = true;
+    m_flags = flags;
+    m_timings.clear();
+    m_elapsed.start();
+
+    if (m_steps.isEmpty()) {
+        applyAndSave();
+        return;
+    }
+
+    // 所有修改同时发送，不等待前一个返回
+    m_waitingCount = m_steps.size();
+    for (int i = 0; i < m_steps.size(); ++i) {
+        send(m_steps.at(i).name, m_steps.at(i).apply, [this, i](bool succeeded) {
+            m_steps[i].succeeded = succeeded;
+            if (--m_waitingCount == 0)
+                onStepsFinished();
+        });
+    }
+}
+
+void DisplayTransaction::send(const QString &name, const Call &call, const std::function<void(bool)> &done)
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    // name 为 ApplyChanges、Save 或设置屏幕参数的步骤
+    QSharedPointer<DCC_NAMESPACE::TraceSpan> span(new DCC_NAMESPACE::TraceSpan("dbus", "DisplayTransaction", name));
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, name, elapsed, done, watcher, span] {
+        span->finish();
+        watcher->deleteLater();
+
+        StepTiming timing;
+        timing.name = name;
+        timing.elapsed = elapsed.elapsed();
+        timing.succeeded = !watcher->isError();
+        m_timings << timing;
+
+        if (watcher->isError())
+            qWarning() << "display transaction step" << name << "failed:" << watcher->error().message();
+        done(timing.succeeded);
+    });
+}
+
+void DisplayTransaction::onStepsFinished()
+{
+    for (const Step &step : m_steps) {
+        if (!step.succeeded) {
+            rollback();
+            return;
+        }
+    }
+
+    applyAndSave();
+}
+
+void DisplayTransaction::applyAndSave()
+{
+    if (!m_displayInter) {
+        finish(false);
+        return;
+    }
+
+    if (m_flags.testFlag(Apply)) {
+        m_flags.setFlag(Apply, false);
+        send("ApplyChanges", [this] { return m_displayInter->ApplyChanges(); }, [this](bool succeeded) {
+            if (succeeded)
+                applyAndSave();
+            else
+                rollback();
+        });
+        return;
+    }
+
+    // 保存失败时修改已经生效，不再回滚
+    if (m_flags.testFlag(Save)) {
+        m_flags.setFlag(Save, false);
+        send("Save", [this] { return m_displayInter->Save(); }, [this](bool succeeded) {
+            finish(succeeded);
+        });
+        return;
+    }
+
+    finish(true);
+}
+
+void DisplayTransaction::rollback()
+{
+    QList<Step> steps;
+    for (auto it = m_steps.crbegin(); it != m_steps.crend(); ++it) {
+        if (it->succeeded && it->rollback)
+            steps << *it;
+    }
+
+    if (steps.isEmpty()) {
+        finish(false);
+        return;
+    }
+
+    m_waitingCount = steps.size();
+    for (const Step &step : steps) {
+        send("rollback " + step.name, step.rollback, [this](bool) {
+            if (--m_waitingCount == 0)
+                finish(false);
+        });
+    }
+}
+
+void DisplayTransaction::finish(bool succeeded)
+{
+    m_running = false;
+    m_steps.clear();
+
+    QStringList timings;
+    for (const StepTiming &timing : m_timings)
+        timings << QString("%1: %2ms%3").arg(timing.name).arg(timing.elapsed).arg(timing.succeeded ? "" : " (failed)");
+    qDebug() << "display transaction" << (succeeded ? "finished" : "rolled back") << "in" << m_elapsed.elapsed() << "ms," << timings;
+
+    Q_EMIT finished(succeeded, m_timings);
+}
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DISPLAYTRANSACTION_H
+#define DISPLAYTRANSACTION_H
+
+#include <QDBusPendingCall>
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+#include <com_deepin_daemon_display.h>
+
+#include <functional>
+
+using DisplayInter = com::deepin::daemon::Display;
+
+class QDBusPendingCallWatcher;
+
+namespace dcc {
+
+namespace display {
+
+/**
+ * @brief The DisplayTransaction class
+ * 收集位置、分辨率、旋转、缩放、主屏等修改，提交时所有修改同时异步发送，
+ * 全部返回后再依次调用一次 ApplyChanges 和 Save。
+ * 任意一个修改或者 ApplyChanges 失败时，按相反的顺序发送已成功修改的回滚调用，
+ * 每一步的耗时通过 finished 信号返回，整个过程不阻塞界面线程
+ */
+class DisplayTransaction : public QObject
+{
+    Q_OBJECT
+public:
+    typedef std::function<QDBusPendingCall()> Call;
+
+    enum CommitFlag {
+        NoFlags = 0x0,
+        Apply = 0x1,
+        Save = 0x2
+    };
+    Q_DECLARE_FLAGS(CommitFlags, CommitFlag)
+
+    struct StepTiming {
+        QString name;
+        qint64 elapsed = 0;     // 从发送到返回的时间，毫秒
+        bool succeeded = false;
+    };
+
+    explicit DisplayTransaction(DisplayInter *displayInter, QObject *parent = nullptr);
+
+    // 同名的修改只发送最后一次，回滚到第一次修改前的值；rollback 可以为空
+    void addStep(const QString &name, const Call &apply, const Call &rollback);
+    inline bool isEmpty() const { return m_steps.isEmpty(); }
+    inline bool isRunning() const { return m_running; }
+
+    void commit(CommitFlags flags);
+
+Q_SIGNALS:
+    void finished(bool succeeded, const QList<DisplayTransaction::StepTiming> &timings);
+
+private:
+    struct Step {
+        QString name;
+        Call apply;
+        Call rollback;
+        bool succeeded = false;
+    };
+
+    void send(const QString &name, const Call &call, const std::function<void(bool)> &done);
+    void onStepsFinished();
+    void applyAndSave();
+    void rollback();
+    void finish(bool succeeded);
+
+private:
+    QPointer<DisplayInter> m_displayInter;
+    QList<Step> m_steps;
+    QList<StepTiming> m_timings;
+    CommitFlags m_flags;
+    bool m_running;
+    int m_waitingCount;
+    QElapsedTimer m_elapsed;
+};
+
+} // namespace display
+
+} // namespace dcc
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(dcc::display::DisplayTransaction::CommitFlags)
+
+#endif // DISPLAYTRANSACTION_H
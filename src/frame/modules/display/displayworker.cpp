@@ -5,11 +5,12 @@
 #include "displayworker.h"
 #include "displaymodel.h"
 #include "widgets/utils.h"
+#include "modules/dbuspropertybinder.h"
 
 #include <DApplicationHelper>
 
 #include <QDebug>
-#include <QtConcurrent>
+#include <QTimer>
 
 using namespace dcc;
 using namespace dcc::display;
@@ -32,12 +33,22 @@ DisplayWorker::DisplayWorker(DisplayModel *model, QObject *parent, bool isSync)
                                             QDBusConnection::sessionBus(), this))
     , m_updateScale(false)
     , m_timer(new QTimer(this))
+    , m_previewTimer(new QTimer(this))
     , m_powerInter(new PowerInter("com.deepin.daemon.Power", "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
+    , m_writeCoalescer(new DBusWriteCoalescer(this))
+    , m_transaction(nullptr)
+    , m_committing(nullptr)
+    , m_commitFlags(DisplayTransaction::NoFlags)
+    , m_commitPending(false)
 {
     m_displayInter.setSync(isSync);
     m_appearanceInter->setSync(isSync);
+    if (!isSync)
+        m_prefetched = DBusPropertyBinder::takePrefetched(DisplayInterface, "/com/deepin/daemon/Display", DisplayInterface);
     m_timer->setSingleShot(true);
     m_timer->setInterval(200);
+    m_previewTimer->setSingleShot(true);
+    m_previewTimer->setInterval(0);
 
     m_displayDBusInter = new QDBusInterface("com.deepin.daemon.Display",
                                             "/com/deepin/daemon/Display",
@@ -61,8 +72,12 @@ DisplayWorker::DisplayWorker(DisplayModel *model, QObject *parent, bool isSync)
     connect(m_powerInter, &PowerInter::HasAmbientLightSensorChanged, m_model, &DisplayModel::autoLightAdjustVaildChanged);
     connect(m_dccSettings, &QGSettings::changed, this, &DisplayWorker::onGSettingsChanged);
     connect(m_timer, &QTimer::timeout, this, [=] {
-        m_displayInter.ApplyChanges().waitForFinished();
-        m_displayInter.Save().waitForFinished();
+        commitChanges(DisplayTransaction::Apply | DisplayTransaction::Save);
+    });
+    connect(m_previewTimer, &QTimer::timeout, this, [=] {
+        // 已经调用了 applyChanges 时，修改随那一次提交生效和保存
+        if (!m_timer->isActive())
+            commitChanges(DisplayTransaction::Apply);
     });
 }
 
@@ -86,19 +101,28 @@ void DisplayWorker::active()
     QDBusPendingCallWatcher *screenscaleswatcher = new QDBusPendingCallWatcher(m_appearanceInter->GetScreenScaleFactors());
     connect(screenscaleswatcher, &QDBusPendingCallWatcher::finished, this, &DisplayWorker::onGetScreenScalesFinished);
 
-    onMonitorsBrightnessChanged(m_displayInter.brightness());
-    m_model->setBrightnessMap(m_displayInter.brightness());
-    onMonitorListChanged(m_displayInter.monitors());
-
-    m_model->setDisplayMode(m_displayInter.displayMode());
-    m_model->setTouchscreenList(m_displayInter.touchscreensV2());
-    m_model->setTouchMap(m_displayInter.touchMap());
-    m_model->setPrimary(m_displayInter.primary());
-    m_model->setScreenHeight(m_displayInter.screenHeight());
-    m_model->setScreenWidth(m_displayInter.screenWidth());
-    m_model->setAdjustCCTmode(m_displayInter.colorTemperatureMode());
-    m_model->setColorTemperature(m_displayInter.colorTemperatureManual());
-    m_model->setmaxBacklightBrightness(m_displayInter.maxBacklightBrightness());
+    // 第一次激活时使用 prefetch 在线程池中读取的属性，之后通过代理读取
+    const QVariantMap prefetched = m_prefetched;
+    m_prefetched.clear();
+    auto property = [&prefetched](const QString &name, auto getter) {
+        typedef decltype(getter()) Type;
+        return prefetched.contains(name) ? qdbus_cast<Type>(prefetched.value(name)) : getter();
+    };
+
+    const auto brightness = property("Brightness", [this] { return m_displayInter.brightness(); });
+    onMonitorsBrightnessChanged(brightness);
+    m_model->setBrightnessMap(brightness);
+    onMonitorListChanged(property("Monitors", [this] { return m_displayInter.monitors(); }));
+
+    m_model->setDisplayMode(property("DisplayMode", [this] { return m_displayInter.displayMode(); }));
+    m_model->setTouchscreenList(property("TouchscreensV2", [this] { return m_displayInter.touchscreensV2(); }));
+    m_model->setTouchMap(property("TouchMap", [this] { return m_displayInter.touchMap(); }));
+    m_model->setPrimary(property("Primary", [this] { return m_displayInter.primary(); }));
+    m_model->setScreenHeight(property("ScreenHeight", [this] { return m_displayInter.screenHeight(); }));
+    m_model->setScreenWidth(property("ScreenWidth", [this] { return m_displayInter.screenWidth(); }));
+    m_model->setAdjustCCTmode(property("ColorTemperatureMode", [this] { return m_displayInter.colorTemperatureMode(); }));
+    m_model->setColorTemperature(property("ColorTemperatureManual", [this] { return m_displayInter.colorTemperatureManual(); }));
+    m_model->setmaxBacklightBrightness(property("MaxBacklightBrightness", [this] { return m_displayInter.maxBacklightBrightness(); }));
     m_model->setAutoLightAdjustIsValid(m_powerInter->hasAmbientLightSensor());
 
     bool isRedshiftValid = true;
@@ -117,7 +141,7 @@ void DisplayWorker::active()
 
 void DisplayWorker::saveChanges()
 {
-    m_displayInter.Save().waitForFinished();
+    commitChanges(DisplayTransaction::Save);
     if (m_updateScale)
         setUiScale(m_currentScale);
     m_updateScale = false;
@@ -125,7 +149,10 @@ void DisplayWorker::saveChanges()
 
 void DisplayWorker::switchMode(const int mode, const QString &name)
 {
-    m_displayInter.SwitchMode(static_cast<uchar>(mode), name).waitForFinished();;
+    transaction()->addStep("SwitchMode", [this, mode, name] {
+        return m_displayInter.SwitchMode(static_cast<uchar>(mode), name);
+    }, nullptr);
+    commitChanges(DisplayTransaction::NoFlags);
 }
 
 void DisplayWorker::onMonitorListChanged(const QList<QDBusObjectPath> &mons)
@@ -186,29 +213,49 @@ void DisplayWorker::onGetScreenScalesFinished(QDBusPendingCallWatcher *w)
 #ifndef DCC_DISABLE_ROTATE
 void DisplayWorker::setMonitorRotate(Monitor *mon, const quint16 rotate)
 {
+    auto setRotation = [this, rotate](Monitor *m) {
+        const quint16 lastRotate = m->rotate();
+        addMonitorStep(m, "SetRotation", [rotate](MonitorInter *inter) {
+            return inter->SetRotation(rotate);
+        }, [lastRotate](MonitorInter *inter) {
+            return inter->SetRotation(lastRotate);
+        });
+    };
+
     if (m_model->displayMode() == MERGE_MODE) {
-        for (auto *m : m_monitors) {
-            m->SetRotation(rotate).waitForFinished();
+        for (auto *m : m_monitors.keys()) {
+            setRotation(m);
         }
     } else {
-        MonitorInter *inter = m_monitors.value(mon);
-        inter->SetRotation(rotate).waitForFinished();
+        setRotation(mon);
     }
+
+    previewChanges();
 }
 #endif
 
 void DisplayWorker::setPrimary(const QString &name)
 {
     // 延时调用，避免卡在下拉框未收回时的一帧画面
+    const QString lastPrimary = m_model->primary();
     QTimer::singleShot(150, this, [=] {
-        m_displayInter.SetPrimary(name);
+        transaction()->addStep("SetPrimary", [this, name] {
+            return m_displayInter.SetPrimary(name);
+        }, [this, lastPrimary] {
+            return m_displayInter.SetPrimary(lastPrimary);
+        });
+        commitChanges(DisplayTransaction::NoFlags);
     });
 }
 
 void DisplayWorker::setMonitorEnable(Monitor *monitor, const bool enable)
 {
-    MonitorInter *inter = m_monitors.value(monitor);
-    inter->Enable(enable).waitForFinished();
+    const bool lastEnable = monitor->enable();
+    addMonitorStep(monitor, "Enable", [enable](MonitorInter *inter) {
+        return inter->Enable(enable);
+    }, [lastEnable](MonitorInter *inter) {
+        return inter->Enable(lastEnable);
+    });
     applyChanges();
 }
 
@@ -221,7 +268,10 @@ void DisplayWorker::applyChanges()
 
 void DisplayWorker::setColorTemperature(int value)
 {
-    m_displayInter.SetColorTemperature(value).waitForFinished();
+    // 拖动滑动条时只发送最新的色温
+    m_writeCoalescer->write(this, "ColorTemperature", [this, value] {
+        return m_displayInter.SetColorTemperature(value);
+    });
 }
 
 void DisplayWorker::SetMethodAdjustCCT(int mode)
@@ -238,9 +288,14 @@ void DisplayWorker::setCurrentFillMode(Monitor *mon,const QString fillMode)
 
 void DisplayWorker::setMonitorResolution(Monitor *mon, const int mode)
 {
-    MonitorInter *inter = m_monitors.value(mon);
-    Q_ASSERT(inter);
-    inter->SetMode(static_cast<uint>(mode)).waitForFinished();
+    Q_ASSERT(m_monitors.contains(mon));
+    const uint lastMode = static_cast<uint>(mon->currentMode().id());
+    addMonitorStep(mon, "SetMode", [mode](MonitorInter *inter) {
+        return inter->SetMode(static_cast<uint>(mode));
+    }, [lastMode](MonitorInter *inter) {
+        return inter->SetMode(lastMode);
+    });
+    previewChanges();
 }
 
 void DisplayWorker::setMonitorBrightness(Monitor *mon, const double brightness)
@@ -249,65 +304,27 @@ void DisplayWorker::setMonitorBrightness(Monitor *mon, const double brightness)
     double value = std::max(brightness, m_model->minimumBrightnessScale());
     qDebug() << "setMonitorBrightness: receive request" << mon->name() << value;
 
-    //前面亮度设置未完成，只记录最新请求
-    QMutexLocker loker(&m_brightness.m_brightnessMutex);
-    m_brightness.m_hasWaitingRequest = true;
-    m_brightness.m_brightnessValue = value;
-    m_brightness.m_monitorName = mon->name();
-    if (!m_brightness.m_hasPendingRequest) {
-        QTimer::singleShot(0, this, &DisplayWorker::handleSetBrightnessRequest);
-    }
-}
-
-void DisplayWorker::handleSetBrightnessRequest() {
-    qDebug() << "setMonitorBrightness enter";
-    QMutexLocker loker(&m_brightness.m_brightnessMutex);
-    if (m_brightness.m_hasPendingRequest) {
-        return;
-    }
-    if (!m_brightness.m_hasWaitingRequest) {
-        return;
-    }
-
-    QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-    connect(watcher, &QFutureWatcher<QDBusPendingReply<>>::finished, [this, watcher] {
-        QMutexLocker loker(&m_brightness.m_brightnessMutex);
-        m_brightness.m_hasPendingRequest = false;
-        qDebug() << "setMonitorBrightness: finish";
-        if (m_brightness.m_hasWaitingRequest) {
-            QTimer::singleShot(0, this, &DisplayWorker::handleSetBrightnessRequest);
-        }
-        watcher->deleteLater();
-    });
-
-    QFuture<void> future = QtConcurrent::run([this] {
-        QMutexLocker loker(&m_brightness.m_brightnessMutex);
-        if (m_brightness.m_hasPendingRequest) {
-            return;
-        }
-        if (!m_brightness.m_hasWaitingRequest) {
-            return;
-        }
-        m_brightness.m_hasPendingRequest = true;
-        m_brightness.m_hasWaitingRequest = false;
-        QString name = m_brightness.m_monitorName;
-        double value = m_brightness.m_brightnessValue;
-        m_brightness.m_monitorName = "";
-        m_brightness.m_brightnessValue = 0;
-        loker.unlock();
+    //前面亮度设置未完成，只记录最新请求，每个屏幕分别合并
+    const QString name = mon->name();
+    m_writeCoalescer->write(mon, "Brightness", [this, name, value] {
         qDebug() << "setMonitorBrightness: begin, " << name << value;
-        m_displayInter.SetAndSaveBrightness(name, value).waitForFinished();
+        return m_displayInter.SetAndSaveBrightness(name, value);
     });
-
-    watcher->setFuture(future);
 }
 
 void DisplayWorker::setMonitorPosition(QHash<Monitor *, QPair<int, int>> monitorPosition)
 {
     for (auto it(monitorPosition.cbegin()); it != monitorPosition.cend(); ++it) {
-        MonitorInter *inter = m_monitors.value(it.key());
-        Q_ASSERT(inter);
-        inter->SetPosition(static_cast<short>(it.value().first), static_cast<short>(it.value().second)).waitForFinished();
+        Q_ASSERT(m_monitors.contains(it.key()));
+        const short x = static_cast<short>(it.value().first);
+        const short y = static_cast<short>(it.value().second);
+        const short lastX = static_cast<short>(it.key()->x());
+        const short lastY = static_cast<short>(it.key()->y());
+        addMonitorStep(it.key(), "SetPosition", [x, y](MonitorInter *inter) {
+            return inter->SetPosition(x, y);
+        }, [lastX, lastY](MonitorInter *inter) {
+            return inter->SetPosition(lastX, lastY);
+        });
     }
     applyChanges();
 }
@@ -324,11 +341,12 @@ void DisplayWorker::setUiScale(const double value)
     QDBusPendingCall call = m_appearanceInter->SetScaleFactor(rv);
 
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    watcher->waitForFinished();
-    if (!watcher->isError()) {
-        m_model->setUIScale(rv);
-    }
-    watcher->deleteLater();
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, rv] {
+        if (!watcher->isError()) {
+            m_model->setUIScale(rv);
+        }
+        watcher->deleteLater();
+    });
 }
 
 void DisplayWorker::setIndividualScaling(Monitor *m, const double scaling)
@@ -497,16 +515,71 @@ void DisplayWorker::setTouchScreenAssociation(const QString &monitor, const QStr
 
 void DisplayWorker::setMonitorResolutionBySize(Monitor *mon, const int width, const int height)
 {
-    MonitorInter *inter = m_monitors.value(mon);
-    Q_ASSERT(inter);
+    Q_ASSERT(m_monitors.contains(mon));
+
+    // 和 SetMode 是同一个修改，回滚到原来的模式
+    const uint lastMode = static_cast<uint>(mon->currentMode().id());
+    addMonitorStep(mon, "SetMode", [width, height](MonitorInter *inter) {
+        return inter->SetModeBySize(static_cast<ushort>(width), static_cast<ushort>(height));
+    }, [lastMode](MonitorInter *inter) {
+        return inter->SetMode(lastMode);
+    });
+    previewChanges();
+}
 
-    QDBusPendingCall call = inter->SetModeBySize(static_cast<ushort>(width), static_cast<ushort>(height));
-    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
-        if (call.isError()) {
-            qDebug() << call.error().message();
-        }
-        watcher->deleteLater();
+DisplayTransaction *DisplayWorker::transaction()
+{
+    if (!m_transaction)
+        m_transaction = new DisplayTransaction(&m_displayInter, this);
+    return m_transaction;
+}
+
+void DisplayWorker::addMonitorStep(Monitor *mon, const QString &method, const MonitorCall &apply, const MonitorCall &rollback)
+{
+    QPointer<MonitorInter> inter = m_monitors.value(mon);
+    if (!inter)
+        return;
+
+    auto bind = [inter](const MonitorCall &call) -> DisplayTransaction::Call {
+        if (!call)
+            return nullptr;
+        return [inter, call]() -> QDBusPendingCall {
+            if (!inter)
+                return QDBusPendingCall::fromError(QDBusError(QDBusError::UnknownObject, "monitor has been removed"));
+            return call(inter);
+        };
+    };
+
+    transaction()->addStep(method + ":" + mon->name(), bind(apply), bind(rollback));
+}
+
+void DisplayWorker::commitChanges(DisplayTransaction::CommitFlags flags)
+{
+    // 上一次提交还没有完成时，合并到下一次提交
+    m_commitFlags |= flags;
+    m_commitPending = true;
+    if (m_committing)
+        return;
+
+    DisplayTransaction *trans = transaction();
+    const DisplayTransaction::CommitFlags commitFlags = m_commitFlags;
+    m_transaction = nullptr;
+    m_commitFlags = DisplayTransaction::NoFlags;
+    m_commitPending = false;
+
+    m_committing = trans;
+    connect(trans, &DisplayTransaction::finished, this, [this, trans] {
+        trans->deleteLater();
+        m_committing = nullptr;
+        if (m_commitPending)
+            commitChanges(DisplayTransaction::NoFlags);
     });
-    watcher->waitForFinished();
+    trans->commit(commitFlags);
+}
+
+void DisplayWorker::previewChanges()
+{
+    // 同一轮事件中的修改（如复制模式下每个屏幕的分辨率）合并到一个事务，
+    // 和 ApplyChanges 一起提交用于预览，ApplyChanges 失败时一起回滚；确认后由 saveChanges 保存
+    m_previewTimer->start();
 }
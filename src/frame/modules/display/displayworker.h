@@ -6,6 +6,8 @@
 #define DISPLAYWORKER_H
 
 #include "monitor.h"
+#include "displaytransaction.h"
+#include "modules/dbuswritecoalescer.h"
 
 #include <QObject>
 
@@ -14,8 +16,6 @@
 #include <com_deepin_daemon_power.h>
 
 #include <QGSettings>
-#include <QMutex>
-#include <QMutexLocker>
 
 using DisplayInter = com::deepin::daemon::Display;
 using AppearanceInter = com::deepin::daemon::Appearance;
@@ -68,7 +68,13 @@ private Q_SLOTS:
 private:
     void monitorAdded(const QString &path);
     void monitorRemoved(const QString &path);
-    void handleSetBrightnessRequest();
+
+    typedef std::function<QDBusPendingCall(MonitorInter *)> MonitorCall;
+    // 当前收集修改的事务，提交后重新创建
+    DisplayTransaction *transaction();
+    void addMonitorStep(Monitor *mon, const QString &method, const MonitorCall &apply, const MonitorCall &rollback);
+    void commitChanges(DisplayTransaction::CommitFlags flags);
+    void previewChanges();
 
 Q_SIGNALS:
     void requestUpdateModeList();
@@ -83,15 +89,15 @@ private:
     double m_currentScale;
     bool m_updateScale;
     QTimer *m_timer;
+    QTimer *m_previewTimer;
 
     PowerInter *m_powerInter;
-    struct {
-        QMutex  m_brightnessMutex;
-        bool    m_hasPendingRequest = false;
-        bool    m_hasWaitingRequest = false;
-        double  m_brightnessValue = 0;
-        QString m_monitorName;
-    }m_brightness;
+    DBusWriteCoalescer *m_writeCoalescer;
+    DisplayTransaction *m_transaction;
+    DisplayTransaction *m_committing;
+    DisplayTransaction::CommitFlags m_commitFlags;
+    bool m_commitPending;
+    QVariantMap m_prefetched;   // prefetch 在线程池中读取的属性，第一次 active 时使用
 };
 
 } // namespace display
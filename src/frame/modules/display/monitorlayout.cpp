@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "monitorlayout.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <math.h>
+
+using namespace dcc::display;
+
+constexpr qreal MonitorLayout::Tolerance;
+constexpr qreal MonitorLayout::Inset;
+constexpr qreal MonitorLayout::SnapDistance;
+
+namespace {
+// 包含边界的相交判断，和 QPolygonF::intersects 一致，边或者点接触也算相交
+bool touches(const QRectF &r1, const QRectF &r2)
+{
+    return r1.left() <= r2.right() && r2.left() <= r1.right()
+            && r1.top() <= r2.bottom() && r2.top() <= r1.bottom();
+}
+
+// 并查集，按大小合并并压缩路径
+class UnionFind
+{
+public:
+    explicit UnionFind(int size)
+        : m_parent(size)
+        , m_size(size, 1)
+    {
+        std::iota(m_parent.begin(), m_parent.end(), 0);
+    }
+
+    int find(int i)
+    {
+        while (m_parent[i] != i) {
+            m_parent[i] = m_parent[m_parent[i]];
+            i = m_parent[i];
+        }
+        return i;
+    }
+
+    void unite(int i, int j)
+    {
+        i = find(i);
+        j = find(j);
+        if (i == j)
+            return;
+        if (m_size[i] < m_size[j])
+            std::swap(i, j);
+        m_parent[j] = i;
+        m_size[i] += m_size[j];
+    }
+
+private:
+    QVector<int> m_parent;
+    QVector<int> m_size;
+};
+}
+
+MonitorLayout::Adjacency MonitorLayout::adjacency(const QVector<QRectF> &rects)
+{
+    Adjacency result;
+    result.neighbours.resize(rects.size());
+
+    // 按左边界排序后扫描，只比较 x 区间(包括外扩部分)重叠的屏幕
+    QVector<int> order(rects.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&rects](int i, int j) {
+        return rects[i].left() < rects[j].left();
+    });
+
+    auto isNeighbour = [&rects](int i, int j) {
+        const QRectF ex = rects[i].adjusted(-Tolerance, -Tolerance, Tolerance, Tolerance);
+        const QRectF inner = rects[i].adjusted(Inset, Inset, -Inset, -Inset);
+        return ex.intersects(rects[j]) && !inner.intersects(rects[j]);
+    };
+    auto isOverlapped = [&rects](int i, int j) {
+        return rects[i].adjusted(Inset, Inset, -Inset, -Inset).intersects(rects[j]);
+    };
+
+    QVector<int> active;
+    for (int i : order) {
+        const qreal left = rects[i].left() - Tolerance;
+        active.erase(std::remove_if(active.begin(), active.end(), [&rects, left](int j) {
+            return rects[j].right() + Tolerance < left;
+        }), active.end());
+
+        for (int j : active) {
+            if (isNeighbour(i, j))
+                result.neighbours[i] << j;
+            if (isNeighbour(j, i))
+                result.neighbours[j] << i;
+            if (isOverlapped(i, j) || isOverlapped(j, i))
+                result.overlapped = true;
+        }
+        active << i;
+    }
+
+    for (QVector<int> &neighbours : result.neighbours)
+        std::sort(neighbours.begin(), neighbours.end());
+
+    return result;
+}
+
+QVector<int> MonitorLayout::components(const QVector<QVector<int>> &neighbours, int *count)
+{
+    UnionFind unionFind(neighbours.size());
+    for (int i = 0; i < neighbours.size(); ++i) {
+        for (int j : neighbours[i])
+            unionFind.unite(i, j);
+    }
+
+    QVector<int> result(neighbours.size(), -1);
+    QVector<int> ids(neighbours.size(), -1);
+    int next = 0;
+    for (int i = 0; i < neighbours.size(); ++i) {
+        int &id = ids[unionFind.find(i)];
+        if (id < 0)
+            id = next++;
+        result[i] = id;
+    }
+
+    if (count)
+        *count = next;
+    return result;
+}
+
+bool MonitorLayout::isConnected(const QVector<QVector<int>> &neighbours)
+{
+    int count = 0;
+    components(neighbours, &count);
+    return count <= 1;
+}
+
+QVector<int> MonitorLayout::connectedDomain(const QVector<QVector<int>> &neighbours, int index)
+{
+    QVector<int> result;
+    if (index < 0 || index >= neighbours.size())
+        return result;
+
+    QVector<bool> visited(neighbours.size(), false);
+    visited[index] = true;
+    for (int head = -1; head < result.size(); ++head) {
+        const int current = head < 0 ? index : result[head];
+        for (int j : neighbours[current]) {
+            if (!visited[j]) {
+                visited[j] = true;
+                result << j;
+            }
+        }
+    }
+
+    result << index;
+    return result;
+}
+
+QPointF MonitorLayout::snapOffset(const QRectF &moving, const QVector<QRectF> &others, qreal distance)
+{
+    // 每个方向上吸附到边缘的距离，以及吸附后边对齐的距离
+    qreal top = 0.0;
+    qreal bottom = 0.0;
+    qreal right = 0.0;
+    qreal left = 0.0;
+
+    qreal topLeft = 0.0;
+    qreal topRight = 0.0;
+    qreal bottomLeft = 0.0;
+    qreal bottomRight = 0.0;
+    qreal rightTop = 0.0;
+    qreal rightBottom = 0.0;
+    qreal leftTop = 0.0;
+    qreal leftBottom = 0.0;
+
+    auto minMoveLen = [](qreal temp, qreal &len) {
+        if (fabs(len) > 0.0) {
+            if (fabs(temp) < fabs(len)) len = temp;
+        } else {
+            len = temp;
+        }
+    };
+
+    for (const QRectF &item : others) {
+        if (touches(moving, item))
+            return QPointF(0.0, 0.0);
+
+        if (touches(moving, QRectF(QPointF(item.left(), item.top() - distance), item.topRight()))) {
+            //上相交
+            minMoveLen(item.top() - moving.bottom(), top);
+            minMoveLen(item.right() - moving.right(), topLeft);
+            minMoveLen(item.left() - moving.left(), topRight);
+        } else if (touches(moving, QRectF(item.bottomLeft(), QPointF(item.right(), item.bottom() + distance)))) {
+            //下相交
+            minMoveLen(item.bottom() - moving.top(), bottom);
+            minMoveLen(item.right() - moving.right(), bottomLeft);
+            minMoveLen(item.left() - moving.left(), bottomRight);
+        } else if (touches(moving, QRectF(QPointF(item.left() - distance, item.top()), item.bottomLeft()))) {
+            //左相交
+            minMoveLen(item.left() - moving.right(), left);
+            minMoveLen(item.top() - moving.top(), leftTop);
+            minMoveLen(item.bottom() - moving.bottom(), leftBottom);
+        } else if (touches(moving, QRectF(item.topRight(), QPointF(item.right() + distance, item.bottom())))) {
+            //右相交
+            minMoveLen(item.right() - moving.left(), right);
+            minMoveLen(item.top() - moving.top(), rightTop);
+            minMoveLen(item.bottom() - moving.bottom(), rightBottom);
+        }
+    }
+
+    auto edgeAlignment = [distance](qreal x1, qreal x2) {
+        if (fabs(x1) > fabs(x2))
+            return fabs(x2) < distance ? x2 : 0;
+        else
+            return fabs(x1) < distance ? x1 : 0;
+    };
+
+    QPointF autoAdsorptionPos(0.0, 0.0), edgeAlignmentPos(0.0, 0.0);
+
+    if (qFuzzyIsNull(top)) {
+        edgeAlignmentPos.setX(edgeAlignment(bottomRight, bottomLeft));
+        autoAdsorptionPos.setY(bottom);
+    } else if (qFuzzyIsNull(bottom)) {
+        edgeAlignmentPos.setX(edgeAlignment(topRight, topLeft));
+        autoAdsorptionPos.setY(top);
+    } else {
+        autoAdsorptionPos.setY((fabs(top) < fabs(bottom)) ? top : bottom);
+        edgeAlignmentPos.setX((fabs(top) < fabs(bottom)) ? edgeAlignment(topRight, topLeft) : edgeAlignment(bottomRight, bottomLeft));
+    }
+
+    if (qFuzzyIsNull(left)) {
+        autoAdsorptionPos.setX(right);
+        edgeAlignmentPos.setY(edgeAlignment(rightTop, rightBottom));
+    } else if (qFuzzyIsNull(right)) {
+        autoAdsorptionPos.setX(left);
+        edgeAlignmentPos.setY(edgeAlignment(leftTop, leftBottom));
+    } else {
+        autoAdsorptionPos.setX((fabs(left) < fabs(right)) ? left : right);
+        edgeAlignmentPos.setY((fabs(left) < fabs(right)) ? edgeAlignment(leftTop, leftBottom) : edgeAlignment(rightTop, rightBottom));
+    }
+
+    if (!qFuzzyIsNull(autoAdsorptionPos.x()))
+        edgeAlignmentPos.setX(0.0);
+
+    if (!qFuzzyIsNull(autoAdsorptionPos.y()))
+        edgeAlignmentPos.setY(0.0);
+
+    return edgeAlignmentPos + autoAdsorptionPos;
+}
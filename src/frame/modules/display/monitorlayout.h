@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MONITORLAYOUT_H
+#define MONITORLAYOUT_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+namespace dcc {
+
+namespace display {
+
+/**
+ * @brief The MonitorLayout class
+ * 多屏拼接的几何计算，不依赖界面，传入的都是场景坐标下的屏幕矩形。
+ * 相邻关系按 x 方向的区间扫描计算，只比较 x 区间重叠的屏幕；连通性用并查集计算
+ */
+class MonitorLayout
+{
+public:
+    // 外扩的距离，规避由于计算导致精度丢失或者坐标值完全一致的情况下不能判定为相交的情况
+    static constexpr qreal Tolerance = 0.05;
+    // 内缩的距离，内缩后仍然相交说明两个屏幕重叠
+    static constexpr qreal Inset = 1;
+    // 拖动时自动吸附和边对齐的范围
+    static constexpr qreal SnapDistance = 200;
+
+    struct Adjacency {
+        QVector<QVector<int>> neighbours;  // 每个屏幕相邻(边或者点接触，不重叠)的屏幕，按下标升序
+        bool overlapped = false;           // 是否有屏幕重叠
+    };
+
+    static Adjacency adjacency(const QVector<QRectF> &rects);
+
+    // 每个屏幕所在连通域的编号，编号按第一次出现的顺序从 0 开始
+    static QVector<int> components(const QVector<QVector<int>> &neighbours, int *count = nullptr);
+    static bool isConnected(const QVector<QVector<int>> &neighbours);
+    // index 所在的连通域，按广度优先的顺序排列，最后一个是 index 本身
+    static QVector<int> connectedDomain(const QVector<QVector<int>> &neighbours, int index);
+
+    // 拖动 moving 时自动吸附到其他屏幕边缘需要移动的距离，和其他屏幕相交时不移动
+    static QPointF snapOffset(const QRectF &moving, const QVector<QRectF> &others, qreal distance = SnapDistance);
+};
+
+} // namespace display
+
+} // namespace dcc
+
+#endif // MONITORLAYOUT_H
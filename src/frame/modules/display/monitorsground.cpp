@@ -5,6 +5,7 @@
 #include "monitorsground.h"
 #include "monitorproxywidget.h"
 #include "displaymodel.h"
+#include "monitorlayout.h"
 #include "window/dconfigwatcher.h"
 
 #include <math.h>
@@ -20,6 +21,7 @@ const int MAX_W = 726; //窗口的最大宽度
 MonitorsGround::MonitorsGround(int activateHeight, QWidget *parent)
     : DGraphicsView(parent)
     , m_scrollArea(nullptr)
+    , m_isConnected(true)
     , m_refershTimer(new QTimer(this))
     , m_effectiveTimer(new QTimer(this))
     , m_isSingleDisplay(false)
@@ -87,6 +89,8 @@ void MonitorsGround::setModel(DisplayModel *model, Monitor *moni)
     m_lstItems.clear();
     m_mapItemConnectedState.clear();
     m_mapInitItemConnectedState.clear();
+    m_connectedNeighbours.clear();
+    m_isConnected = true;
     m_lstSortItems.clear();
     m_graphicsScene.clear();
     m_model = model;
@@ -1026,7 +1030,7 @@ void MonitorsGround::multiScreenAutoAdjust()
     updateConnectedState();
 
     //判断是否为全连通状态
-    if (getConnectedDomain(m_movingItem).size() == m_lstItems.size()) {
+    if (m_isConnected) {
         updateConnectedState(true);
         return;
     }
@@ -1040,24 +1044,19 @@ void MonitorsGround::multiScreenAutoAdjust()
         return;
 
     QMap<MonitorProxyWidget *,QList<MonitorProxyWidget *>> maplstItems;
-    QMap<MonitorProxyWidget *, bool> mapItemsNeedMove;
-    QList<MonitorProxyWidget *> itemTemp;
 
     //这个列表是存放的就是所有移动块相关的块
     //判断改变连通的块与移动块的剩余联通块是否存在连接
     //【这种是在移动块初始连接块是两个及以上的情况下触发的，如果是一个连通块的话不会改变连通状态的】
 
-    //获取屏幕集群
-    for (auto iter : m_lstItems) {
-
-        if (!lstChangedItems.contains(iter))
-            continue;
-
-        itemTemp = getConnectedDomain(iter);
-        for (auto k : itemTemp) {
-            if (lstChangedItems.contains(k) && k != iter) {
-                lstChangedItems.removeOne(k);
-            }
+    //获取屏幕集群，每个连通域保留第一个块
+    const QVector<int> components = MonitorLayout::components(m_connectedNeighbours);
+    QVector<bool> componentFound(m_lstItems.size(), false);
+    lstChangedItems.clear();
+    for (int i = 0; i < m_lstItems.size() && i < components.size(); i++) {
+        if (!componentFound[components[i]]) {
+            componentFound[components[i]] = true;
+            lstChangedItems.append(m_lstItems[i]);
         }
     }
 
@@ -1115,70 +1114,47 @@ void MonitorsGround::multiScreenAutoAdjust()
 //更新上一次拼接完成的值
 bool MonitorsGround::updateConnectedState(bool isInit)
 {
-    bool isIntersect = false;
-    QList<MonitorProxyWidget *> m_lstItemsTemp;
-    for (int i = 0; i < m_lstItems.size(); i++) {
-        m_lstItemsTemp.clear();
+    QVector<QRectF> rects;
+    rects.reserve(m_lstItems.size());
+    for (auto item : m_lstItems) {
+        rects.append(item->mapRectToScene(item->boundingRect()));
+    }
 
-        for (int j = 0; j < m_lstItems.size(); j++) {
-            if (j != i && m_lstItems[i]->mapRectToScene(m_lstItems[i]->boundingRectEx()).intersects(m_lstItems[j]->mapRectToScene(m_lstItems[j]->boundingRect()))
-                   && !m_lstItemsTemp.contains(m_lstItems[j])
-                   && !m_lstItems[i]->mapRectToScene(m_lstItems[i]->justIntersectRect()).intersects(m_lstItems[j]->mapRectToScene(m_lstItems[j]->boundingRect()))) {
-                m_lstItemsTemp.append(m_lstItems[j]);
-            }
-            if (j != i && m_lstItems[i]->mapRectToScene(m_lstItems[i]->justIntersectRect()).intersects(m_lstItems[j]->mapRectToScene(m_lstItems[j]->boundingRect()))) {
-                isIntersect = true;
-            }
+    const MonitorLayout::Adjacency adjacency = MonitorLayout::adjacency(rects);
+    m_connectedNeighbours = adjacency.neighbours;
+    m_isConnected = MonitorLayout::isConnected(m_connectedNeighbours);
+
+    for (int i = 0; i < m_lstItems.size(); i++) {
+        QList<MonitorProxyWidget *> lstItemsTemp;
+        for (int j : adjacency.neighbours[i]) {
+            lstItemsTemp.append(m_lstItems[j]);
         }
 
         if (isInit) {
-            m_mapInitItemConnectedState.insert(m_lstItems[i],m_lstItemsTemp);
+            m_mapInitItemConnectedState.insert(m_lstItems[i], lstItemsTemp);
         }
 
-        m_mapItemConnectedState.insert(m_lstItems[i],m_lstItemsTemp);
+        m_mapItemConnectedState.insert(m_lstItems[i], lstItemsTemp);
     }
 
-    return isIntersect;
+    return adjacency.overlapped;
 }
 
 //获取连通域
 QList<MonitorProxyWidget *> MonitorsGround::getConnectedDomain(MonitorProxyWidget *item)
 {
-   QList<MonitorProxyWidget *> lstTemp1Items;
-
-   QList<MonitorProxyWidget *> lstTemp;
-   QList<MonitorProxyWidget *> lstItems;
-
-   lstItems.append(item);
-
-   for (auto iter : m_lstItems) /*标记循环次数*/ {
-       Q_UNUSED(iter)
-
-       lstTemp.clear();
-       //获取所有的value
-       for (auto a : lstItems) {
-           for (auto t : m_mapItemConnectedState[a]) {
-               if (!lstTemp1Items.contains(t))
-                   lstTemp.append(t);
-           }
-       }
-
-       //去重插入
-       for (auto t : lstTemp) {
-           if (!lstTemp1Items.contains(t) && t != item)
-               lstTemp1Items.append(t);
-           else {
-               lstTemp.removeOne(t);
-           }
-       }
-
-       lstItems.clear();
-       lstItems.append(lstTemp);
-   }
+    QList<MonitorProxyWidget *> lstItems;
+    const int index = m_lstItems.indexOf(item);
+    if (index < 0 || index >= m_connectedNeighbours.size()) {
+        lstItems.append(item);
+        return lstItems;
+    }
 
-    lstTemp1Items.append(item);
+    for (int i : MonitorLayout::connectedDomain(m_connectedNeighbours, index)) {
+        lstItems.append(m_lstItems[i]);
+    }
 
-    return lstTemp1Items;
+    return lstItems;
 }
 
 
@@ -1265,7 +1241,7 @@ void MonitorsGround::onRequestKeyPress(MonitorProxyWidget *pw, int keyValue)
                     pw->moveBy(1, 0); //此处为：判定为重叠时，回退距离为内缩的距离
                     break;
                 }
-                if (getConnectedDomain(m_movingItem).size() != m_lstItems.size()) {
+                if (!m_isConnected) {
                     pw->moveBy(recision, 0);
                     break;
                 }
@@ -1282,7 +1258,7 @@ void MonitorsGround::onRequestKeyPress(MonitorProxyWidget *pw, int keyValue)
                     pw->moveBy(-1, 0);
                     break;
                 }
-                if (getConnectedDomain(m_movingItem).size() != m_lstItems.size()) {
+                if (!m_isConnected) {
                     pw->moveBy(-recision, 0);
                     break;
                 }
@@ -1299,7 +1275,7 @@ void MonitorsGround::onRequestKeyPress(MonitorProxyWidget *pw, int keyValue)
                     pw->moveBy(0, 1);
                     break;
                 }
-                if (getConnectedDomain(m_movingItem).size() != m_lstItems.size()) {
+                if (!m_isConnected) {
                     pw->moveBy(0, recision);
                     break;
                 }
@@ -1316,7 +1292,7 @@ void MonitorsGround::onRequestKeyPress(MonitorProxyWidget *pw, int keyValue)
                     pw->moveBy(0, -1);
                     break;
                 }
-                if (getConnectedDomain(m_movingItem).size() != m_lstItems.size()) {
+                if (!m_isConnected) {
                     pw->moveBy(0, -recision);
                     break;
                 }
@@ -1345,131 +1321,15 @@ void MonitorsGround::onRequestMouseMove(MonitorProxyWidget *pw)
 
     //当鼠标移动的时候开始响应并执行自动吸附的逻辑
     //保证 bufferboundingRect 相交且 boundingRect 不相交，保证移动的块item始终在其他item的外边缘移动
-
-    qreal top = 0.0;
-    qreal bottom = 0.0;
-    qreal right = 0.0;
-    qreal left = 0.0;
-
-    qreal topLeft = 0.0;
-    qreal topRight = 0.0;
-    qreal bottomLeft = 0.0;
-    qreal bottomRight = 0.0;
-    qreal rightTop = 0.0;
-    qreal rightBottom = 0.0;
-    qreal leftTop = 0.0;
-    qreal leftBottom = 0.0;
-    
-    int space = 200;
-
-    auto minMoveLen = [=](qreal temp, qreal &len) {
-        if (fabs(len) > 0.0) {
-            if (fabs(temp) < fabs(len)) len = temp;
-        }
-        else {
-            len = temp;
-        }
-    };
-
+    QVector<QRectF> others;
+    others.reserve(m_lstItems.size());
     for (auto item : m_lstItems) {
-        if (item == pw)
-            continue;
-
-        if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->boundingRect())))
-            return;
-
-        //与boundingRect 不相交
-        if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectTop()))) {
-            //上相交
-            qreal temp =  item->mapToScene(item->boundingRect().topRight()).y() - pw->mapToScene(pw->boundingRect().bottomLeft()).y();
-            minMoveLen(temp,top);
-
-            //判断边对齐
-            temp =  item->mapToScene(item->boundingRect().topRight()).x() - pw->mapToScene(pw->boundingRect().bottomRight()).x();
-            minMoveLen(temp,topLeft);
-            temp =  item->mapToScene(item->boundingRect().topLeft()).x() - pw->mapToScene(pw->boundingRect().bottomLeft()).x();
-            minMoveLen(temp,topRight);
-        }
-        else if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectBottom()))) {
-            //下相交
-            qreal temp =  item->mapToScene(item->boundingRect().bottomLeft()).y() - pw->mapToScene(pw->boundingRect().topLeft()).y();
-            minMoveLen(temp,bottom);
-
-            //判断边对齐的可能
-            temp =  item->mapToScene(item->boundingRect().topRight()).x() - pw->mapToScene(pw->boundingRect().bottomRight()).x();
-            minMoveLen(temp,bottomLeft);
-            temp =  item->mapToScene(item->boundingRect().topLeft()).x() - pw->mapToScene(pw->boundingRect().bottomLeft()).x();
-            minMoveLen(temp,bottomRight);
-        }
-        else if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectLeft()))) {
-            //左相交
-            qreal temp =  item->mapToScene(item->boundingRect().bottomLeft()).x() - pw->mapToScene(pw->boundingRect().bottomRight()).x();
-            minMoveLen(temp,left);
-
-            //判断边对齐的可能
-            temp =  item->mapToScene(item->boundingRect().topRight()).y() - pw->mapToScene(pw->boundingRect().topRight()).y();
-            minMoveLen(temp,leftTop);
-            temp =  item->mapToScene(item->boundingRect().bottomLeft()).y() - pw->mapToScene(pw->boundingRect().bottomLeft()).y();
-            minMoveLen(temp,leftBottom);
-        }
-        else if (pw->mapToScene(pw->boundingRect()).intersects(item->mapToScene(item->bufferboundingRectRight()))) {
-            //右相交
-            qreal temp = item->mapToScene(item->boundingRect().bottomRight()).x() - pw->mapToScene(pw->boundingRect().bottomLeft()).x();
-            minMoveLen(temp,right);
-
-            //判断边对齐的可能
-            temp =  item->mapToScene(item->boundingRect().topRight()).y() - pw->mapToScene(pw->boundingRect().topRight()).y();
-            minMoveLen(temp,rightTop);
-            temp =  item->mapToScene(item->boundingRect().bottomLeft()).y() - pw->mapToScene(pw->boundingRect().bottomLeft()).y();
-            minMoveLen(temp,rightBottom);
-        }
+        if (item != pw)
+            others.append(item->mapRectToScene(item->boundingRect()));
     }
 
-    auto edgeAlignment = [=](qreal x1, qreal x2) {
-        if(fabs(x1) > fabs(x2))
-            return fabs(x2) < space ? x2 : 0;
-        else
-            return fabs(x1) < space ? x1 : 0;
-    };
-
-    QPointF autoAdsorptionPos(0.0,0.0),edgeAlignmentPos(0.0,0.0);
-
-    if (qFuzzyIsNull(top)) {
-        edgeAlignmentPos.setX(edgeAlignment(bottomRight,bottomLeft));
-        autoAdsorptionPos.setY(bottom);
-    }
-    else if (qFuzzyIsNull(bottom)) {
-        edgeAlignmentPos.setX(edgeAlignment(topRight,topLeft));
-        autoAdsorptionPos.setY(top);
-    } 
-    else {
-        autoAdsorptionPos.setY((fabs(top) < fabs(bottom)) ? top : bottom);
-        edgeAlignmentPos.setX((fabs(top) < fabs(bottom)) ? edgeAlignment(topRight,topLeft) : edgeAlignment(bottomRight,bottomLeft));
-    }
-
-
-    if (qFuzzyIsNull(left)) {
-        autoAdsorptionPos.setX(right);
-        edgeAlignmentPos.setY(edgeAlignment(rightTop,rightBottom));
-    }   
-    else if (qFuzzyIsNull(right)) {
-        autoAdsorptionPos.setX(left);
-        edgeAlignmentPos.setY(edgeAlignment(leftTop,leftBottom));
-    } 
-    else {
-        autoAdsorptionPos.setX((fabs(left) < fabs(right)) ? left : right);
-        edgeAlignmentPos.setY((fabs(left) < fabs(right)) ? edgeAlignment(leftTop,leftBottom) : edgeAlignment(rightTop,rightBottom));
-    }
-
-    if(!qFuzzyIsNull(autoAdsorptionPos.x())) {
-        edgeAlignmentPos.setX(0.0);
-    }
-
-    if(!qFuzzyIsNull(autoAdsorptionPos.y())) {
-        edgeAlignmentPos.setY(0.0);
-    }
-    
-    pw->moveBy(edgeAlignmentPos.x() + autoAdsorptionPos.x(), edgeAlignmentPos.y() + autoAdsorptionPos.y());
+    const QPointF offset = MonitorLayout::snapOffset(pw->mapRectToScene(pw->boundingRect()), others);
+    pw->moveBy(offset.x(), offset.y());
 }
 
 //更新缩放比例
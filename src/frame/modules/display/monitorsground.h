@@ -84,6 +84,8 @@ private:
     QList<QPair<MonitorProxyWidget *, qreal>> m_lstMoveingItemToCenterPosLen;           //所有块的中心点到移动点的距离
     QMap<MonitorProxyWidget *, QList<MonitorProxyWidget *>> m_mapItemConnectedState;    //所有块的实时连通状态
     QMap<MonitorProxyWidget *, QList<MonitorProxyWidget *>> m_mapInitItemConnectedState; //所有块的初始连通状态
+    QVector<QVector<int>> m_connectedNeighbours;                                        //m_lstItems 中每个块相邻块的下标
+    bool m_isConnected;                                                                 //所有块是否连通
 
     QTimer *m_refershTimer;
     QTimer *m_effectiveTimer;
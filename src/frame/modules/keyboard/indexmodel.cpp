@@ -8,6 +8,10 @@
 #include <QDBusInterface>
 #include <com_deepin_daemon_inputdevice_keyboard.h>
 
+#include <DPinyin>
+
+#include <algorithm>
+
 DWIDGET_USE_NAMESPACE
 
 namespace dcc {
@@ -92,6 +96,49 @@ QDebug &operator<<(QDebug dbg, const MetaData &md)
     return dbg.maybeSpace();
 }
 
+QString toPinyin(const QString &text)
+{
+    QString pinyin;
+    for (const QChar &ch : text) {
+        if (ch.unicode() < 0x80) {
+            pinyin.append(ch);
+            continue;
+        }
+
+        // 只去掉汉字转换结果末尾的声调数字，标题中原有的数字保留
+        QString syllable = DTK_CORE_NAMESPACE::Chinese2Pinyin(ch);
+        if (syllable.size() > 1 && syllable.at(syllable.size() - 1) >= '1' && syllable.at(syllable.size() - 1) <= '5')
+            syllable.chop(1);
+        pinyin.append(syllable);
+    }
+    return pinyin;
+}
+
+QList<MetaData> sortByPinyin(const QList<MetaData> &datas, QList<QString> &letters)
+{
+    // 先计算每一项的排序关键字，再一次排序
+    QList<QPair<QString, MetaData>> pinyinKeys;
+    for (const MetaData &md : datas)
+        pinyinKeys << qMakePair(md.pinyin().toLower(), md);
+
+    std::stable_sort(pinyinKeys.begin(), pinyinKeys.end(), [](const QPair<QString, MetaData> &a, const QPair<QString, MetaData> &b) {
+        return a.first < b.first;
+    });
+
+    QList<MetaData> sorted;
+    QChar ch = '\0';
+    for (const auto &key : pinyinKeys) {
+        const QChar flag = key.second.pinyin().at(0).toUpper();
+        if (flag != ch) {
+            ch = flag;
+            letters.append(ch);
+            sorted.append(MetaData(ch, true));
+        }
+        sorted.append(key.second);
+    }
+    return sorted;
+}
+
 IndexModel::IndexModel(QObject *parent)
     : QStandardItemModel(parent)
 {
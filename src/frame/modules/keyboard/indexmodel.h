@@ -50,6 +50,11 @@ private:
 
 QDebug &operator<<(QDebug dbg, const MetaData &md);
 
+// 逐个汉字转换为拼音并去掉声调，其他字符保持不变
+QString toPinyin(const QString &text);
+// 按拼音排序，并在每个首字母前插入分组项，letters 返回所有分组的首字母
+QList<MetaData> sortByPinyin(const QList<MetaData> &datas, QList<QString> &letters);
+
 class IndexModel : public QStandardItemModel
 {
     Q_OBJECT
@@ -12,6 +12,8 @@
 #include <QCoreApplication>
 #include <QGuiApplication>
 
+#include <algorithm>
+
 namespace dcc {
 namespace keyboard{
 
@@ -510,70 +512,51 @@ void KeyboardWorker::onPinyin()
 {
     m_letters.clear();
     m_metaDatas.clear();
-    QDBusInterface dbus_pinyin("com.deepin.api.Pinyin", "/com/deepin/api/Pinyin",
-                               "com.deepin.api.Pinyin");
 
-    Q_FOREACH(const QString &str, m_model->kbLayout().keys()) {
+    QLocale locale;
+    const bool isChinese = locale.language() == QLocale::Chinese;
+
+    // 先计算每一项的排序关键字，再一次排序
+    QCollator collator;
+    QList<QPair<QCollatorSortKey, MetaData>> textKeys;
+    QList<MetaData> pinyinDatas;
+
+    const QMap<QString, QString> &layouts = m_model->kbLayout();
+    for (auto it = layouts.cbegin(); it != layouts.cend(); ++it) {
         MetaData md;
-        QString title = m_model->kbLayout()[str];
+        const QString &title = it.value();
         md.setText(title);
-        md.setKey(str);
-        QChar letterFirst = title[0];
-        QStringList letterFirstList;
+        md.setKey(it.key());
+        if (title.isEmpty())
+            continue;
+
+        const QChar letterFirst = title[0];
         if (letterFirst.isLower() || letterFirst.isUpper()) {
-            letterFirstList << QString(letterFirst);
             md.setPinyin(title);
         } else {
-            QDBusMessage message = dbus_pinyin.call("Query", title);
-            letterFirstList = message.arguments()[0].toStringList();
-            md.setPinyin(letterFirstList.at(0));
+            md.setPinyin(toPinyin(title));
         }
 
-        append(md);
+        if (isChinese)
+            pinyinDatas << md;
+        else
+            textKeys << qMakePair(collator.sortKey(title), md);
     }
 
-    QLocale locale;
-
-    if (locale.language() == QLocale::Chinese) {
-        QChar ch = '\0';
-        for (int i(0); i != m_metaDatas.size(); ++i)
-        {
-            const QChar flag = m_metaDatas[i].pinyin().at(0).toUpper();
-            if (flag == ch)
-                continue;
-            ch = flag;
-
-            m_letters.append(ch);
-            m_metaDatas.insert(i, MetaData(ch, true));
-        }
+    if (isChinese) {
+        m_metaDatas = sortByPinyin(pinyinDatas, m_letters);
     } else {
-        qSort(m_metaDatas.begin(), m_metaDatas.end(), caseInsensitiveLessThan);
+        std::stable_sort(textKeys.begin(), textKeys.end(), [](const QPair<QCollatorSortKey, MetaData> &a, const QPair<QCollatorSortKey, MetaData> &b) {
+            return a.first.compare(b.first) < 0;
+        });
+
+        for (const auto &key : textKeys)
+            m_metaDatas.append(key.second);
     }
 
     Q_EMIT onDatasChanged(m_metaDatas);
     Q_EMIT onLettersChanged(m_letters);
 }
-
-void KeyboardWorker::append(const MetaData &md)
-{
-    if(m_metaDatas.count() == 0)
-    {
-        m_metaDatas.append(md);
-        return;
-    }
-
-    int index = 0;
-    for (int i = 0; i != m_metaDatas.size(); ++i) {
-        if(m_metaDatas.at(i) > md)
-        {
-            m_metaDatas.insert(index,md);
-            return;
-        }
-        index++;
-    }
-
-    m_metaDatas.append(md);
-}
 #endif
 
 #ifndef DCC_DISABLE_LANGUAGE
@@ -109,7 +109,6 @@ public Q_SLOTS:
     void onPinyin();
     void onSearchShortcuts(const QString &searchKey);
     void onSearchFinished(QDBusPendingCallWatcher *watch);
-    void append(const MetaData& md);
 #endif
 
 #ifndef DCC_DISABLE_LANGUAGE
@@ -37,6 +37,12 @@ void NotificationModel::appAdded(AppItemModel *item)
     Q_EMIT appListChanged();
 }
 
+void NotificationModel::appsAdded(const QList<AppItemModel *> &items)
+{
+    m_appItemModels.append(items);
+    Q_EMIT appListChanged();
+}
+
 void NotificationModel::appRemoved(const QString &appName)
 {
     for (int i = 0; i < m_appItemModels.size(); i++) {
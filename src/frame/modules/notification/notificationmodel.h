@@ -30,6 +30,8 @@ public:
 
 public Q_SLOTS:
     void appAdded(AppItemModel* item);
+    // 批量加入，只发出一次 appListChanged
+    void appsAdded(const QList<AppItemModel *> &items);
     void appRemoved(const QString &appName);
 
 Q_SIGNALS:
@@ -5,8 +5,12 @@
 #include "notificationworker.h"
 #include "model/appitemmodel.h"
 #include "model/sysitemmodel.h"
+#include "window/tracer.h"
 
 #include <QtConcurrent>
+#include <QDBusPendingCallWatcher>
+#include <QDebug>
+#include <QSharedPointer>
 
 const QString Path    = "/com/deepin/dde/Notification";
 
@@ -17,14 +21,18 @@ NotificationWorker::NotificationWorker(NotificationModel *model, QObject *parent
     , m_model(model)
     , m_dbus(new Notification(Notification::staticInterfaceName(), Path, QDBusConnection::sessionBus(), this))
     , m_theme(new Appearance(Appearance::staticInterfaceName(), "/com/deepin/daemon/Appearance", QDBusConnection::sessionBus(), this))
+    , m_loadSerial(0)
 {
     connect(m_dbus, &Notification::AppAddedSignal, this, &NotificationWorker::onAppAdded);
     connect(m_dbus, &Notification::AppRemovedSignal, this, &NotificationWorker::onAppRemoved);
+    connect(m_dbus, &Notification::AppInfoChanged, this, &NotificationWorker::onAppInfoChanged);
 }
 
 void NotificationWorker::active(bool sync)
 {
     if (sync) {
+        ++m_loadSerial;
+        m_appItems.clear();
         m_model->clearModel();
         initAllSetting();
     }
@@ -44,44 +52,127 @@ void NotificationWorker::initAllSetting()
 void NotificationWorker::initSystemSetting()
 {
     SysItemModel *item = new SysItemModel(this);
-    item->setTimeStart(m_dbus->GetSystemInfo(SysItemModel::STARTTIME).value().variant().toString());
-    item->setTimeEnd(m_dbus->GetSystemInfo(SysItemModel::ENDTIME).value().variant().toString());
-    item->setDisturbMode(m_dbus->GetSystemInfo(SysItemModel::DNDMODE).value().variant().toBool());
-    item->setLockScreen(m_dbus->GetSystemInfo(SysItemModel::LOCKSCREENOPENDNDMODE).value().variant().toBool());
-    item->setTimeSlot(m_dbus->GetSystemInfo(SysItemModel::OPENBYTIMEINTERVAL).value().variant().toBool());
     connect(m_dbus, &Notification::SystemInfoChanged, item, &SysItemModel::onSettingChanged);
     m_model->setSysSetting(item);
+
+    // 所有配置项的请求同时发出，不逐个等待返回
+    QPointer<SysItemModel> itemPtr(item);
+    const QList<uint> configItems { SysItemModel::STARTTIME, SysItemModel::ENDTIME, SysItemModel::DNDMODE,
+                                    SysItemModel::LOCKSCREENOPENDNDMODE, SysItemModel::OPENBYTIMEINTERVAL };
+    for (uint configItem : configItems) {
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dbus->GetSystemInfo(configItem), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [itemPtr, configItem](QDBusPendingCallWatcher *w) {
+            w->deleteLater();
+            QDBusPendingReply<QDBusVariant> reply = *w;
+            if (reply.isError()) {
+                qWarning() << "get system notification setting failed:" << configItem << reply.error().message();
+                return;
+            }
+            if (itemPtr)
+                itemPtr->onSettingChanged(configItem, reply.value());
+        });
+    }
 }
 
 void NotificationWorker::initAppSetting()
 {
-    QStringList appList = m_dbus->GetAppList();
-    for (int i = 0; i < appList.size(); i++) {
-        onAppAdded(appList[i]);
-    }
+    const int serial = m_loadSerial;
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dbus->GetAppList(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, serial](QDBusPendingCallWatcher *w) {
+        w->deleteLater();
+        QDBusPendingReply<QStringList> reply = *w;
+        if (serial != m_loadSerial)
+            return;
+        if (reply.isError()) {
+            qWarning() << "get notification app list failed:" << reply.error().message();
+            return;
+        }
+        loadApps(reply.value());
+    });
 }
 
 void NotificationWorker::onAppAdded(const QString &id)
 {
-    AppItemModel *item = new AppItemModel(this);
-    item->setActName(id);
-    item->setSoftName(m_dbus->GetAppInfo(id, AppItemModel::APPNAME).value().variant().toString());
-    item->setIcon(m_dbus->GetAppInfo(id, AppItemModel::APPICON).value().variant().toString());
-    item->setAllowNotify(m_dbus->GetAppInfo(id, AppItemModel::ENABELNOTIFICATION).value().variant().toBool());
-    item->setShowNotifyPreview(m_dbus->GetAppInfo(id, AppItemModel::ENABELPREVIEW).value().variant().toBool());
-    item->setNotifySound(m_dbus->GetAppInfo(id, AppItemModel::ENABELSOUND).value().variant().toBool());
-    item->setShowInNotifyCenter(m_dbus->GetAppInfo(id, AppItemModel::SHOWINNOTIFICATIONCENTER).value().variant().toBool());
-    item->setLockShowNotify(m_dbus->GetAppInfo(id, AppItemModel::LOCKSCREENSHOWNOTIFICATION).value().variant().toBool());
-
-    connect(m_dbus, &Notification::AppInfoChanged, item, &AppItemModel::onSettingChanged);
-    m_model->appAdded(item);
+    loadApps({ id });
+}
+
+void NotificationWorker::loadApps(const QStringList &ids)
+{
+    struct Batch {
+        int serial;
+        int pending;
+        QList<QPointer<AppItemModel>> items;
+    };
+    QSharedPointer<Batch> batch(new Batch { m_loadSerial, 0, {} });
+
+    for (const QString &id : ids) {
+        if (m_appItems.contains(id))
+            continue;
+
+        AppItemModel *item = new AppItemModel(this);
+        item->setActName(id);
+        m_appItems.insert(id, item);
+        batch->items << item;
+    }
+
+    if (batch->items.isEmpty())
+        return;
+
+    // 一次发出所有应用所有配置项的请求，全部返回后一起加入 model，列表只刷新一次
+    QSharedPointer<DCC_NAMESPACE::TraceSpan> span(new DCC_NAMESPACE::TraceSpan("dbus", "GetAppInfo", QString::number(batch->items.size())));
+    auto finish = [this, batch, span] {
+        span->finish();
+        QList<AppItemModel *> items;
+        for (const QPointer<AppItemModel> &item : batch->items) {
+            if (!item)
+                continue;
+            // 加载过程中应用被移除或者重新加载了
+            if (batch->serial != m_loadSerial || m_appItems.value(item->getActName()).data() != item.data()) {
+                item->deleteLater();
+                continue;
+            }
+            items << item;
+        }
+        if (!items.isEmpty())
+            m_model->appsAdded(items);
+    };
+
+    const QList<uint> configItems { AppItemModel::APPNAME, AppItemModel::APPICON, AppItemModel::ENABELNOTIFICATION,
+                                    AppItemModel::ENABELPREVIEW, AppItemModel::ENABELSOUND,
+                                    AppItemModel::SHOWINNOTIFICATIONCENTER, AppItemModel::LOCKSCREENSHOWNOTIFICATION };
+    for (const QPointer<AppItemModel> &item : batch->items) {
+        const QString id = item->getActName();
+        for (uint configItem : configItems) {
+            ++batch->pending;
+            QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dbus->GetAppInfo(id, configItem), this);
+            connect(watcher, &QDBusPendingCallWatcher::finished, this, [item, id, configItem, batch, finish](QDBusPendingCallWatcher *w) {
+                w->deleteLater();
+                QDBusPendingReply<QDBusVariant> reply = *w;
+                if (reply.isError())
+                    qWarning() << "get notification setting failed:" << id << configItem << reply.error().message();
+                else if (item)
+                    item->onSettingChanged(id, configItem, reply.value());
+
+                if (--batch->pending == 0)
+                    finish();
+            });
+        }
+    }
 }
 
 void NotificationWorker::onAppRemoved(const QString &id)
 {
+    m_appItems.remove(id);
     m_model->appRemoved(id);
 }
 
+void NotificationWorker::onAppInfoChanged(const QString &id, uint item, const QDBusVariant &var)
+{
+    AppItemModel *model = m_appItems.value(id);
+    if (model)
+        model->onSettingChanged(id, item, var);
+}
+
 void NotificationWorker::setAppSetting(const QString &id, uint item, QVariant var)
 {
     m_dbus->SetAppInfo(id, item, QDBusVariant(var));
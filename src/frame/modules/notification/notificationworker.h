@@ -10,6 +10,8 @@
 #include <com_deepin_daemon_appearance.h>
 
 #include <QObject>
+#include <QHash>
+#include <QPointer>
 
 using Notification = com::deepin::dde::Notification;
 using Appearance = com::deepin::daemon::Appearance;
@@ -18,6 +20,7 @@ namespace dcc {
 namespace notification {
 
 class NotificationModel;
+class AppItemModel;
 class NotificationWorker : public QObject
 {
     Q_OBJECT
@@ -33,13 +36,21 @@ public Q_SLOTS:
     void initAppSetting();
     void onAppAdded(const QString &id);
     void onAppRemoved(const QString &id);
+    void onAppInfoChanged(const QString &id, uint item, const QDBusVariant &var);
     void setAppSetting(const QString &id, uint item, QVariant var);
     void setSystemSetting(uint item, QVariant var);
 
+private:
+    void loadApps(const QStringList &ids);
+
 private:
     NotificationModel *m_model;
     Notification *m_dbus;
     Appearance *m_theme;
+    // 按应用 id 分发 AppInfoChanged，只通知对应的 AppItemModel
+    QHash<QString, QPointer<AppItemModel>> m_appItems;
+    // 每次重新加载时递增，丢弃之前未返回的请求
+    int m_loadSerial;
 };
 
 }// namespace msgnotify
@@ -6,7 +6,9 @@
 #include "model/thememodel.h"
 #include "model/fontmodel.h"
 #include "model/fontsizemodel.h"
+#include "thumbnailloader.h"
 
+#include <QCollator>
 #include <QGuiApplication>
 #include <QScreen>
 #include <QDebug>
@@ -41,7 +43,8 @@ PersonalizationWork::PersonalizationWork(PersonalizationModel *model, QObject *p
       m_dbus(new Appearance(Service, Path, QDBusConnection::sessionBus(), this)),
       m_wmSwitcher(new WMSwitcher("com.deepin.WMSwitcher", "/com/deepin/WMSwitcher", QDBusConnection::sessionBus(), this)),
       m_wm(new WM("com.deepin.wm", "/com/deepin/wm", QDBusConnection::sessionBus(), this)),
-      m_effects(new Effects("org.kde.KWin", "/Effects", QDBusConnection::sessionBus(), this))
+      m_effects(new Effects("org.kde.KWin", "/Effects", QDBusConnection::sessionBus(), this)),
+      m_thumbnailLoader(new ThumbnailLoader(m_dbus, this))
 {
     ThemeModel *cursorTheme      = m_model->getMouseModel();
     ThemeModel *windowTheme      = m_model->getWindowModel();
@@ -57,6 +60,7 @@ PersonalizationWork::PersonalizationWork(PersonalizationModel *model, QObject *p
     connect(m_dbus, &Appearance::StandardFontChanged,  fontStand,     &FontModel::setFontName);
     connect(m_dbus, &Appearance::FontSizeChanged, this, &PersonalizationWork::FontSizeChanged);
     connect(m_dbus, &Appearance::Refreshed, this, &PersonalizationWork::onRefreshedChanged);
+    connect(m_thumbnailLoader, &ThumbnailLoader::thumbnailReady, this, &PersonalizationWork::onThumbnailReady);
 
     //connect(m_wmSwitcher, &WMSwitcher::WMChanged, this, &PersonalizationWork::onToggleWM);
     connect(m_dbus, &Appearance::OpacityChanged, this, &PersonalizationWork::refreshOpacity);
@@ -156,28 +160,27 @@ QList<QJsonObject> PersonalizationWork::converToList(const QString &type, const
 void PersonalizationWork::addList(ThemeModel *model, const QString &type, const QJsonArray &array)
 {
     QList<QString> list;
-    QList<QJsonObject> objList;
+    // sort for display name, sort keys are computed once for each theme
+    QCollator collator;
+    QList<QPair<QCollatorSortKey, QJsonObject>> objList;
     for (int i = 0; i != array.size(); i++) {
         QJsonObject object = array.at(i).toObject();
         object.insert("type", QJsonValue(type));
-        objList << object;
+        objList << qMakePair(collator.sortKey(object["Id"].toString()), object);
         list.append(object["Id"].toString());
-
-        QDBusPendingReply<QString> pic = m_dbus->Thumbnail(type, object["Id"].toString());
-        QDBusPendingCallWatcher *picWatcher = new QDBusPendingCallWatcher(pic, this);
-        picWatcher->setProperty("category", type);
-        picWatcher->setProperty("id", object["Id"].toString());
-        connect(picWatcher, &QDBusPendingCallWatcher::finished, this, &PersonalizationWork::onGetPicFinished);
     }
 
-    // sort for display name
-    std::sort(objList.begin(), objList.end(), [=] (const QJsonObject &obj1, const QJsonObject &obj2) {
-        QCollator qc;
-        return qc.compare(obj1["Id"].toString(), obj2["Id"].toString()) < 0;
+    std::stable_sort(objList.begin(), objList.end(), [] (const QPair<QCollatorSortKey, QJsonObject> &obj1, const QPair<QCollatorSortKey, QJsonObject> &obj2) {
+        return obj1.first.compare(obj2.first) < 0;
     });
 
-    for (const QJsonObject &obj : objList) {
-        model->addItem(obj["Id"].toString(), obj);
+    for (const auto &obj : objList) {
+        model->addItem(obj.second["Id"].toString(), obj.second);
+    }
+
+    // 缩略图优先从本地缓存读取，缓存中没有的再并发请求后端
+    for (const auto &obj : objList) {
+        m_thumbnailLoader->request(type, obj.second["Id"].toString(), obj.second["Path"].toString());
     }
 
     for (const QString &id : model->getList().keys()) {
@@ -230,20 +233,9 @@ void PersonalizationWork::onGetThemeFinished(QDBusPendingCallWatcher *w)
     w->deleteLater();
 }
 
-void PersonalizationWork::onGetPicFinished(QDBusPendingCallWatcher *w)
+void PersonalizationWork::onThumbnailReady(const QString &type, const QString &id, const QString &path)
 {
-    QDBusPendingReply<QString> reply = *w;
-
-    if (!reply.isError()) {
-        const QString &category = w->property("category").toString();
-        const QString &id = w->property("id").toString();
-
-        m_themeModels[category]->addPic(id, reply.value());
-    } else {
-        qDebug() << reply.error();
-    }
-
-    w->deleteLater();
+    m_themeModels[type]->addPic(id, path);
 }
 
 void PersonalizationWork::onGetActiveColorFinished(QDBusPendingCallWatcher *w)
@@ -338,13 +330,22 @@ void PersonalizationWork::setFontList(FontModel *model, const QString &type, con
 
             QJsonArray arrayValue = QJsonDocument::fromJson(r.value().toLocal8Bit().data()).array();
 
-            QList<QJsonObject> list = converToList(type, arrayValue);
-            // sort for display name
-            std::sort(list.begin(), list.end(), [=] (const QJsonObject &obj1, const QJsonObject &obj2) {
-                QCollator qc;
-                return qc.compare(obj1["Name"].toString(), obj2["Name"].toString()) < 0;
+            const QList<QJsonObject> &fonts = converToList(type, arrayValue);
+            // sort for display name, sort keys are computed once for each font
+            QCollator collator;
+            QList<QPair<QCollatorSortKey, QJsonObject>> keys;
+            for (const QJsonObject &obj : fonts) {
+                keys << qMakePair(collator.sortKey(obj["Name"].toString()), obj);
+            }
+            std::stable_sort(keys.begin(), keys.end(), [] (const QPair<QCollatorSortKey, QJsonObject> &obj1, const QPair<QCollatorSortKey, QJsonObject> &obj2) {
+                return obj1.first.compare(obj2.first) < 0;
             });
 
+            QList<QJsonObject> list;
+            for (const auto &key : keys) {
+                list << key.second;
+            }
+
             model->setFontList(list);
         } else {
             qDebug() << w->error();
@@ -28,6 +28,7 @@ namespace dcc
 namespace personalization
 {
 class ThemeModel;
+class ThumbnailLoader;
 class PersonalizationWork : public QObject
 {
     Q_OBJECT
@@ -55,7 +56,7 @@ private Q_SLOTS:
     void FontSizeChanged(const double value) const;
     void onGetFontFinished(QDBusPendingCallWatcher *w);
     void onGetThemeFinished(QDBusPendingCallWatcher *w);
-    void onGetPicFinished(QDBusPendingCallWatcher *w);
+    void onThumbnailReady(const QString &type, const QString &id, const QString &path);
     void onGetActiveColorFinished(QDBusPendingCallWatcher *w);
     void onRefreshedChanged(const QString &type);
     void onToggleWM(const QString &wm);
@@ -90,6 +91,7 @@ private:
     QMap<QString, ThemeModel*> m_themeModels;
     QMap<QString, FontModel*> m_fontModels;
     QGSettings *m_setting;
+    ThumbnailLoader *m_thumbnailLoader;
 };
 }
 }
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "thumbnailloader.h"
+#include "window/tracer.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDBusPendingCallWatcher>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSharedPointer>
+#include <QStandardPaths>
+
+using namespace dcc;
+using namespace dcc::personalization;
+
+// 后端生成缩略图比较耗时，限制同时进行的请求数量，避免阻塞 Appearance 的其他调用
+static const int MaxRunning = 4;
+
+// 缓存文件名中的主题修改时间
+static qint64 cacheTime(const QString &file)
+{
+    return file.section('-', 1).section('.', 0, 0).toLongLong();
+}
+
+ThumbnailLoader::ThumbnailLoader(com::deepin::daemon::Appearance *dbus, QObject *parent)
+    : QObject(parent)
+    , m_dbus(dbus)
+    , m_cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/theme-thumbnails")
+    , m_cacheLoaded(false)
+    , m_running(0)
+{
+}
+
+void ThumbnailLoader::request(const QString &type, const QString &id, const QString &themePath)
+{
+    const QString key = type + "/" + id;
+    if (m_pending.contains(key))
+        return;
+
+    Request request { type, id, 0 };
+    if (!themePath.isEmpty())
+        request.mtime = QFileInfo(themePath).lastModified().toMSecsSinceEpoch();
+
+    const QString &path = findCache(request);
+    if (!path.isEmpty()) {
+        Q_EMIT thumbnailReady(type, id, path);
+        return;
+    }
+
+    m_pending.insert(key);
+    m_queue.enqueue(request);
+    startNext();
+}
+
+void ThumbnailLoader::startNext()
+{
+    while (m_running < MaxRunning && !m_queue.isEmpty()) {
+        const Request request = m_queue.dequeue();
+
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dbus->Thumbnail(request.type, request.id), this);
+        watcher->setProperty("category", request.type);
+        watcher->setProperty("id", request.id);
+        watcher->setProperty("mtime", request.mtime);
+        QSharedPointer<DCC_NAMESPACE::TraceSpan> span(new DCC_NAMESPACE::TraceSpan("dbus", "Thumbnail", request.type + "/" + request.id));
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, span](QDBusPendingCallWatcher *w) {
+            span->finish();
+            onThumbnailFinished(w);
+        });
+        ++m_running;
+    }
+}
+
+void ThumbnailLoader::onThumbnailFinished(QDBusPendingCallWatcher *w)
+{
+    QDBusPendingReply<QString> reply = *w;
+    const Request request { w->property("category").toString(), w->property("id").toString(), w->property("mtime").toLongLong() };
+
+    --m_running;
+    m_pending.remove(request.type + "/" + request.id);
+
+    if (!reply.isError()) {
+        // 缓存失败时仍然使用后端返回的路径
+        const QString &path = saveCache(request, reply.value());
+        Q_EMIT thumbnailReady(request.type, request.id, path.isEmpty() ? reply.value() : path);
+    } else {
+        qDebug() << reply.error();
+    }
+
+    w->deleteLater();
+    startNext();
+}
+
+QString ThumbnailLoader::cacheName(const QString &type, const QString &id) const
+{
+    // 主题 id 可能包含空格等字符，使用哈希作为文件名
+    return QCryptographicHash::hash((type + "/" + id).toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+void ThumbnailLoader::loadCacheFiles()
+{
+    if (m_cacheLoaded)
+        return;
+    m_cacheLoaded = true;
+
+    // 只读取一次缓存目录，文件名为 cacheName-mtime[.suffix]
+    QDir dir(m_cacheDir);
+    for (const QString &file : dir.entryList(QDir::Files)) {
+        const QString &name = file.section('-', 0, 0);
+        // 同一个主题有多个缓存时，保留修改时间最新的
+        const QString &old = m_cacheFiles.value(name);
+        if (!old.isEmpty()) {
+            const bool newer = cacheTime(file) > cacheTime(old);
+            dir.remove(newer ? old : file);
+            if (!newer)
+                continue;
+        }
+        m_cacheFiles.insert(name, file);
+    }
+}
+
+QString ThumbnailLoader::findCache(const Request &request)
+{
+    if (request.mtime <= 0)
+        return QString();
+
+    loadCacheFiles();
+
+    const QString &file = m_cacheFiles.value(cacheName(request.type, request.id));
+    if (file.isEmpty() || cacheTime(file) != request.mtime)
+        return QString();
+
+    // 缓存文件可能被用户清理
+    const QString &path = m_cacheDir + "/" + file;
+    return QFile::exists(path) ? path : QString();
+}
+
+QString ThumbnailLoader::saveCache(const Request &request, const QString &source)
+{
+    if (request.mtime <= 0 || source.isEmpty())
+        return QString();
+
+    QDir dir(m_cacheDir);
+    if (!dir.mkpath("."))
+        return QString();
+
+    // 删除主题更新前的缩略图
+    loadCacheFiles();
+    const QString &name = cacheName(request.type, request.id);
+    const QString &old = m_cacheFiles.take(name);
+    if (!old.isEmpty())
+        dir.remove(old);
+
+    // 保留后缀，svg 和 png 的缩略图使用不同的方式加载
+    QString fileName = QString("%1-%2").arg(name).arg(request.mtime);
+    const QString &suffix = QFileInfo(source).suffix();
+    if (!suffix.isEmpty())
+        fileName += "." + suffix;
+
+    const QString &target = dir.filePath(fileName);
+    if (!QFile::copy(source, target)) {
+        qWarning() << "failed to cache theme thumbnail:" << source;
+        return QString();
+    }
+
+    m_cacheFiles.insert(name, fileName);
+    return target;
+}
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef THUMBNAILLOADER_H
+#define THUMBNAILLOADER_H
+
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+
+#include <com_deepin_daemon_appearance.h>
+
+class QDBusPendingCallWatcher;
+
+namespace dcc {
+namespace personalization {
+
+/**
+ * @brief The ThumbnailLoader class
+ * 获取主题缩略图。缩略图复制到用户缓存目录，以主题类型、id 和主题目录的修改时间区分，
+ * 主题没有变化时直接使用缓存，不再调用 Thumbnail；
+ * 缓存中没有的缩略图排队请求，同时进行的请求数量不超过 MaxRunning
+ */
+class ThumbnailLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ThumbnailLoader(com::deepin::daemon::Appearance *dbus, QObject *parent = nullptr);
+
+    // themePath 为主题目录，用于判断缓存是否过期，为空时不使用缓存
+    void request(const QString &type, const QString &id, const QString &themePath);
+
+Q_SIGNALS:
+    void thumbnailReady(const QString &type, const QString &id, const QString &path);
+
+private Q_SLOTS:
+    void onThumbnailFinished(QDBusPendingCallWatcher *w);
+
+private:
+    struct Request {
+        QString type;
+        QString id;
+        qint64 mtime;
+    };
+
+    void startNext();
+    QString cacheName(const QString &type, const QString &id) const;
+    void loadCacheFiles();
+    QString findCache(const Request &request);
+    QString saveCache(const Request &request, const QString &source);
+
+private:
+    com::deepin::daemon::Appearance *m_dbus;
+    QString m_cacheDir;
+    bool m_cacheLoaded;
+    QHash<QString, QString> m_cacheFiles;   // cacheName -> 缓存目录中的文件名
+    QQueue<Request> m_queue;
+    QSet<QString> m_pending;    // 排队或者正在请求的主题，避免重复请求
+    int m_running;
+};
+
+}
+}
+
+#endif // THUMBNAILLOADER_H
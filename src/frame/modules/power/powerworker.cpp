@@ -23,102 +23,54 @@ PowerWorker::PowerWorker(PowerModel *model, QObject *parent)
     , m_sysPowerInter(new SysPowerInter("com.deepin.system.Power", "/com/deepin/system/Power", QDBusConnection::systemBus(), this))
     , m_login1ManagerInter(new Login1ManagerInter("org.freedesktop.login1", "/org/freedesktop/login1", QDBusConnection::systemBus(), this))
     , m_powerManager(new PowerManager("com.deepin.daemon.PowerManager", "/com/deepin/daemon/PowerManager", QDBusConnection::systemBus(), this))
+    , m_powerBinder(new DBusPropertyBinder("com.deepin.daemon.Power", "/com/deepin/daemon/Power", "com.deepin.daemon.Power", QDBusConnection::sessionBus(), this))
+    , m_sysPowerBinder(new DBusPropertyBinder("com.deepin.system.Power", "/com/deepin/system/Power", "com.deepin.system.Power", QDBusConnection::systemBus(), this))
 {
     m_powerInter->setSync(false);
     m_sysPowerInter->setSync(false);
     m_login1ManagerInter->setSync(false);
 
-    connect(m_powerInter, &PowerInter::ScreenBlackLockChanged, m_powerModel, &PowerModel::setScreenBlackLock);
-    connect(m_powerInter, &PowerInter::SleepLockChanged, m_powerModel, &PowerModel::setSleepLock);
-    connect(m_powerInter, &PowerInter::LidIsPresentChanged, m_powerModel, &PowerModel::setLidPresent);
-    connect(m_powerInter, &PowerInter::LidClosedSleepChanged, m_powerModel, &PowerModel::setSleepOnLidOnPowerClose);
-//    connect(m_powerInter, &PowerInter::BatteryLidClosedSleepChanged, m_powerModel, &PowerModel::setSleepOnLidOnBatteryClose);
-    connect(m_powerInter, &PowerInter::LinePowerScreenBlackDelayChanged, this, &PowerWorker::setScreenBlackDelayToModelOnPower);
-    connect(m_powerInter, &PowerInter::LinePowerSleepDelayChanged, this, &PowerWorker::setSleepDelayToModelOnPower);
-    connect(m_powerInter, &PowerInter::BatteryScreenBlackDelayChanged, this, &PowerWorker::setScreenBlackDelayToModelOnBattery);
-    connect(m_powerInter, &PowerInter::BatterySleepDelayChanged, this, &PowerWorker::setSleepDelayToModelOnBattery);
-    connect(m_powerInter, &PowerInter::BatteryLockDelayChanged, this, &PowerWorker::setResponseBatteryLockScreenDelay);
-    connect(m_powerInter, &PowerInter::LinePowerLockDelayChanged, this, &PowerWorker::setResponsePowerLockScreenDelay);
-    connect(m_powerInter, &PowerInter::IsHighPerformanceSupportedChanged, this, &PowerWorker::setHighPerformanceSupported);
+    // 属性通过 GetAll 一次读取，之后只处理 PropertiesChanged 中变化的属性
+    m_powerBinder->bind("ScreenBlackLock", m_powerModel, &PowerModel::setScreenBlackLock);
+    m_powerBinder->bind("SleepLock", m_powerModel, &PowerModel::setSleepLock);
+    m_powerBinder->bind("LidIsPresent", m_powerModel, &PowerModel::setLidPresent);
+    m_powerBinder->bind("LidClosedSleep", m_powerModel, &PowerModel::setSleepOnLidOnPowerClose);
+    m_powerBinder->bind("LinePowerScreenBlackDelay", this, &PowerWorker::setScreenBlackDelayToModelOnPower);
+    m_powerBinder->bind("LinePowerSleepDelay", this, &PowerWorker::setSleepDelayToModelOnPower);
+    m_powerBinder->bind("BatteryScreenBlackDelay", this, &PowerWorker::setScreenBlackDelayToModelOnBattery);
+    m_powerBinder->bind("BatterySleepDelay", this, &PowerWorker::setSleepDelayToModelOnBattery);
+    m_powerBinder->bind("BatteryLockDelay", this, &PowerWorker::setResponseBatteryLockScreenDelay);
+    m_powerBinder->bind("LinePowerLockDelay", this, &PowerWorker::setResponsePowerLockScreenDelay);
+    m_powerBinder->bind("IsHighPerformanceSupported", this, &PowerWorker::setHighPerformanceSupported);
+    m_powerBinder->bind("LinePowerPressPowerBtnAction", m_powerModel, &PowerModel::setLinePowerPressPowerBtnAction);
+    m_powerBinder->bind("LinePowerLidClosedAction", m_powerModel, &PowerModel::setLinePowerLidClosedAction);
+    m_powerBinder->bind("BatteryPressPowerBtnAction", m_powerModel, &PowerModel::setBatteryPressPowerBtnAction);
+    m_powerBinder->bind("BatteryLidClosedAction", m_powerModel, &PowerModel::setBatteryLidClosedAction);
+    m_powerBinder->bind("LowPowerNotifyEnable", m_powerModel, &PowerModel::setLowPowerNotifyEnable);
+    m_powerBinder->bind("LowPowerNotifyThreshold", m_powerModel, &PowerModel::setLowPowerNotifyThreshold);
+    m_powerBinder->bind("LowPowerAutoSleepThreshold", m_powerModel, &PowerModel::setLowPowerAutoSleepThreshold);
 
 #ifndef DCC_DISABLE_POWERSAVE
-    connect(m_sysPowerInter, &SysPowerInter::PowerSavingModeAutoChanged, m_powerModel, &PowerModel::setAutoPowerSaveMode);
-    connect(m_sysPowerInter, &SysPowerInter::PowerSavingModeEnabledChanged, m_powerModel, &PowerModel::setPowerSaveMode);
+    m_sysPowerBinder->bind("PowerSavingModeAuto", m_powerModel, &PowerModel::setAutoPowerSaveMode);
+    m_sysPowerBinder->bind("PowerSavingModeEnabled", m_powerModel, &PowerModel::setPowerSaveMode);
 #endif
-    connect(m_sysPowerInter, &SysPowerInter::HasBatteryChanged, m_powerModel, &PowerModel::setHaveBettary);
-    connect(m_sysPowerInter, &SysPowerInter::BatteryPercentageChanged, m_powerModel, &PowerModel::setBatteryPercentage);
-
-
-    //--------------------sp2 add----------------------------
-    connect(m_sysPowerInter, &SysPowerInter::PowerSavingModeAutoWhenBatteryLowChanged, m_powerModel, &PowerModel::setPowerSavingModeAutoWhenQuantifyLow);
-    connect(m_sysPowerInter, &SysPowerInter::PowerSavingModeAutoChanged, m_powerModel, &PowerModel::setPowerSavingModeAuto);
-    connect(m_sysPowerInter, &SysPowerInter::PowerSavingModeBrightnessDropPercentChanged, m_powerModel, &PowerModel::setPowerSavingModeLowerBrightnessThreshold);
-    connect(m_powerInter, &PowerInter::LinePowerPressPowerBtnActionChanged, m_powerModel, &PowerModel::setLinePowerPressPowerBtnAction);
-    connect(m_powerInter, &PowerInter::LinePowerLidClosedActionChanged, m_powerModel, &PowerModel::setLinePowerLidClosedAction);
-    connect(m_powerInter, &PowerInter::BatteryPressPowerBtnActionChanged, m_powerModel, &PowerModel::setBatteryPressPowerBtnAction);
-    connect(m_powerInter, &PowerInter::BatteryLidClosedActionChanged, m_powerModel, &PowerModel::setBatteryLidClosedAction);
-    connect(m_powerInter, &PowerInter::LowPowerNotifyEnableChanged, m_powerModel, &PowerModel::setLowPowerNotifyEnable);
-    connect(m_powerInter, &PowerInter::LowPowerNotifyThresholdChanged, m_powerModel, &PowerModel::setLowPowerNotifyThreshold);
-    connect(m_powerInter, &PowerInter::LowPowerAutoSleepThresholdChanged, m_powerModel, &PowerModel::setLowPowerAutoSleepThreshold);
-    //-------------------------------------------------------
-    connect(m_sysPowerInter, &SysPowerInter::ModeChanged, m_powerModel, &PowerModel::setPowerPlan);
-
-    bool value = false;
-    QDBusInterface interface("com.deepin.system.Power",
-                             "/com/deepin/system/Power",
-                             "org.freedesktop.DBus.Properties",
-                             QDBusConnection::systemBus());
-    QDBusMessage reply = interface.call("Get", "com.deepin.system.Power", "IsBalanceSupported");
-    QList<QVariant> outArgs = reply.arguments();
-    if (outArgs.length() > 0) {
-        value = outArgs.at(0).value<QDBusVariant>().variant().toBool();
-        m_powerModel->setBalanceSupported(value);
-    }
-
-    reply = interface.call("Get", "com.deepin.system.Power", "IsPowerSaveSupported");
-    outArgs = reply.arguments();
-    if (outArgs.length() > 0) {
-        value = outArgs.at(0).value<QDBusVariant>().variant().toBool();
-        m_powerModel->setPowerSaveSupported(value);
-    }
+    m_sysPowerBinder->bind("HasBattery", m_powerModel, &PowerModel::setHaveBettary);
+    m_sysPowerBinder->bind("BatteryPercentage", m_powerModel, &PowerModel::setBatteryPercentage);
+    m_sysPowerBinder->bind("PowerSavingModeAutoWhenBatteryLow", m_powerModel, &PowerModel::setPowerSavingModeAutoWhenQuantifyLow);
+    m_sysPowerBinder->bind("PowerSavingModeAuto", m_powerModel, &PowerModel::setPowerSavingModeAuto);
+    m_sysPowerBinder->bind("PowerSavingModeBrightnessDropPercent", m_powerModel, &PowerModel::setPowerSavingModeLowerBrightnessThreshold);
+    m_sysPowerBinder->bind("Mode", m_powerModel, &PowerModel::setPowerPlan);
+    m_sysPowerBinder->bind("IsBalanceSupported", m_powerModel, &PowerModel::setBalanceSupported);
+    m_sysPowerBinder->bind("IsPowerSaveSupported", m_powerModel, &PowerModel::setPowerSaveSupported);
+    m_sysPowerBinder->refresh();
 }
 
 void PowerWorker::active()
 {
-    m_powerInter->blockSignals(false);
-
     // refersh data
-    m_powerModel->setScreenBlackLock(m_powerInter->screenBlackLock());
-    m_powerModel->setSleepLock(m_powerInter->sleepLock());
-    m_powerModel->setLidPresent(m_powerInter->lidIsPresent());
-    m_powerModel->setSleepOnLidOnPowerClose(m_powerInter->lidClosedSleep());
-    m_powerModel->setHaveBettary(m_sysPowerInter->hasBattery());
-    m_powerModel->setPowerSavingModeAutoWhenQuantifyLow(m_sysPowerInter->powerSavingModeAutoWhenBatteryLow());
-    m_powerModel->setPowerSavingModeLowerBrightnessThreshold(m_sysPowerInter->powerSavingModeBrightnessDropPercent());
-    m_powerModel->setLowPowerNotifyEnable(m_powerInter->lowPowerNotifyEnable());
-    m_powerModel->setLowPowerAutoSleepThreshold(m_powerInter->lowPowerAutoSleepThreshold());
-    m_powerModel->setLowPowerNotifyThreshold(m_powerInter->lowPowerNotifyThreshold());
-    m_powerModel->setLinePowerPressPowerBtnAction(m_powerInter->linePowerPressPowerBtnAction());
-    m_powerModel->setLinePowerLidClosedAction(m_powerInter->linePowerLidClosedAction());
-    m_powerModel->setBatteryPressPowerBtnAction(m_powerInter->batteryPressPowerBtnAction());
-    m_powerModel->setBatteryLidClosedAction(m_powerInter->batteryLidClosedAction());
-    m_powerModel->setPowerPlan(m_sysPowerInter->mode());
-
-    setHighPerformanceSupported(m_powerInter->isHighPerformanceSupported());
-
-    setScreenBlackDelayToModelOnPower(m_powerInter->linePowerScreenBlackDelay());
-    setSleepDelayToModelOnPower(m_powerInter->linePowerSleepDelay());
-
-    setScreenBlackDelayToModelOnBattery(m_powerInter->batteryScreenBlackDelay());
-    setSleepDelayToModelOnBattery(m_powerInter->batterySleepDelay());
-
-    setResponseBatteryLockScreenDelay(m_powerInter->batteryLockDelay());
-    setResponsePowerLockScreenDelay(m_powerInter->linePowerLockDelay());
-
-#ifndef DCC_DISABLE_POWERSAVE
-    m_powerModel->setAutoPowerSaveMode(m_sysPowerInter->powerSavingModeAuto());
-    m_powerModel->setPowerSaveMode(m_sysPowerInter->powerSavingModeEnabled());
-#endif
+    m_powerBinder->setActive(true);
+    m_powerBinder->refresh();
+    m_sysPowerBinder->refresh();
 
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     const bool confVal = valueByQSettings<bool>(DCC_CONFIG_FILES, "Power", "sleep", true);
@@ -158,7 +110,7 @@ void PowerWorker::active()
 
 void PowerWorker::deactive()
 {
-    m_powerInter->blockSignals(true);
+    m_powerBinder->setActive(false);
 }
 
 void PowerWorker::setScreenBlackLock(const bool lock)
@@ -9,6 +9,8 @@
 #include <com_deepin_system_systempower.h>
 #include <org_freedesktop_login1.h>
 #include <com_deepin_daemon_powermanager.h>
+#include "modules/dbuspropertybinder.h"
+
 #include <QObject>
 
 using PowerInter = com::deepin::daemon::Power;
@@ -78,6 +80,8 @@ private:
     SysPowerInter *m_sysPowerInter;
     Login1ManagerInter *m_login1ManagerInter;
     PowerManager *m_powerManager;
+    DBusPropertyBinder *m_powerBinder;
+    DBusPropertyBinder *m_sysPowerBinder;
 };
 
 }
@@ -25,13 +25,14 @@ SoundWorker::SoundWorker(SoundModel *model, QObject *parent)
     , m_defaultSink(nullptr)
     , m_defaultSource(nullptr)
     , m_sourceMeter(nullptr)
-    , m_powerInter(new SystemPowerInter("com.deepin.system.Power", "/com/deepin/system/Power", QDBusConnection::systemBus(), this))
+    , m_audioBinder(new DBusPropertyBinder("com.deepin.daemon.Audio", "/com/deepin/daemon/Audio", Audio::staticInterfaceName(), QDBusConnection::sessionBus(), this))
+    , m_sysPowerBinder(new DBusPropertyBinder("com.deepin.system.Power", "/com/deepin/system/Power", SystemPowerInter::staticInterfaceName(), QDBusConnection::systemBus(), this))
     , m_dccSettings(new QGSettings("com.deepin.dde.control-center", QByteArray(), this))
     , m_pingTimer(new QTimer(this))
     , m_inter(QDBusConnection::sessionBus().interface())
+    , m_writeCoalescer(new DBusWriteCoalescer(this))
 {
     m_audioInter->setSync(false);
-    m_powerInter->setSync(false);
 
     m_pingTimer->setInterval(5000);
     m_pingTimer->setSingleShot(false);
@@ -58,29 +59,22 @@ void SoundWorker::initConnect()
     connect(m_model, &SoundModel::defaultSourceChanged, this, &SoundWorker::defaultSourceChanged);
     connect(m_model, &SoundModel::audioCardsChanged, this, &SoundWorker::cardsChanged);
 
-    connect(m_audioInter, &Audio::DefaultSinkChanged, m_model, &SoundModel::setDefaultSink);
-    connect(m_audioInter, &Audio::DefaultSourceChanged, m_model, &SoundModel::setDefaultSource);
-    connect(m_audioInter, &Audio::MaxUIVolumeChanged, m_model, &SoundModel::setMaxUIVolume);
-    connect(m_audioInter, &Audio::IncreaseVolumeChanged, m_model, &SoundModel::setIncreaseVolume);
-    connect(m_audioInter, &Audio::CardsWithoutUnavailableChanged, m_model, &SoundModel::setAudioCards);
-    connect(m_audioInter, &Audio::ReduceNoiseChanged, m_model, &SoundModel::setReduceNoise);
-    connect(m_audioInter, &Audio::BluetoothAudioModeOptsChanged, m_model, &SoundModel::setBluetoothAudioModeOpts);
-    connect(m_audioInter, &Audio::BluetoothAudioModeChanged, m_model, &SoundModel::setCurrentBluetoothAudioMode);
+    m_audioBinder->bind("DefaultSink", m_model, &SoundModel::setDefaultSink);
+    m_audioBinder->bind("DefaultSource", m_model, &SoundModel::setDefaultSource);
+    m_audioBinder->bind("MaxUIVolume", m_model, &SoundModel::setMaxUIVolume);
+    m_audioBinder->bind("IncreaseVolume", m_model, &SoundModel::setIncreaseVolume);
+    m_audioBinder->bind("CardsWithoutUnavailable", m_model, &SoundModel::setAudioCards);
+    m_audioBinder->bind("ReduceNoise", m_model, &SoundModel::setReduceNoise);
+    m_audioBinder->bind("BluetoothAudioModeOpts", m_model, &SoundModel::setBluetoothAudioModeOpts);
+    m_audioBinder->bind("BluetoothAudioMode", m_model, &SoundModel::setCurrentBluetoothAudioMode);
+    m_sysPowerBinder->bind("HasBattery", m_model, &SoundModel::setIsLaptop);
     connect(m_soundEffectInter, &SoundEffect::EnabledChanged, m_model, &SoundModel::setEnableSoundEffect);
 
     connect(m_pingTimer, &QTimer::timeout, [this] { if (m_sourceMeter) m_sourceMeter->Tick(); });
-    connect(m_powerInter, &SystemPowerInter::HasBatteryChanged, m_model, &SoundModel::setIsLaptop);
     connect(m_dccSettings, &QGSettings::changed, this, &SoundWorker::onGsettingsChanged);
 
-    m_model->setDefaultSink(m_audioInter->defaultSink());
-    m_model->setDefaultSource(m_audioInter->defaultSource());
-    m_model->setAudioCards(m_audioInter->cardsWithoutUnavailable());
-    m_model->setIsLaptop(m_powerInter->hasBattery());
-    m_model->setMaxUIVolume(m_audioInter->maxUIVolume());
-    m_model->setIncreaseVolume(m_audioInter->increaseVolume());
-    m_model->setReduceNoise(m_audioInter->reduceNoise());
-    m_model->setBluetoothAudioModeOpts(m_audioInter->bluetoothAudioModeOpts());
-    m_model->setCurrentBluetoothAudioMode(m_audioInter->bluetoothAudioMode());
+    m_audioBinder->refresh();
+    m_sysPowerBinder->refresh();
     m_model->setWaitSoundReceiptTime(m_waitSoundPortReceipt);
 }
 
@@ -88,10 +82,11 @@ void SoundWorker::activate()
 {
     m_pingTimer->start();
 
-    m_audioInter->blockSignals(false);
-    if (m_defaultSink) m_defaultSink->blockSignals(false);
-    if (m_defaultSource) m_defaultSource->blockSignals(false);
-    if (m_sourceMeter) m_sourceMeter->blockSignals(false);
+    m_audioBinder->setActive(true);
+    m_audioBinder->refresh();
+    if (m_sinkBinder) m_sinkBinder->setActive(true);
+    if (m_sourceBinder) m_sourceBinder->setActive(true);
+    if (m_meterBinder) m_meterBinder->setActive(true);
 
     defaultSinkChanged(m_model->defaultSink());
     defaultSourceChanged(m_model->defaultSource());
@@ -102,10 +97,10 @@ void SoundWorker::deactivate()
 {
     m_pingTimer->stop();
 
-    m_audioInter->blockSignals(true);
-    if (m_defaultSink) m_defaultSink->blockSignals(true);
-    if (m_defaultSource) m_defaultSource->blockSignals(true);
-    if (m_sourceMeter) m_sourceMeter->blockSignals(true);
+    m_audioBinder->setActive(false);
+    if (m_sinkBinder) m_sinkBinder->setActive(false);
+    if (m_sourceBinder) m_sourceBinder->setActive(false);
+    if (m_meterBinder) m_meterBinder->setActive(false);
 }
 
 void SoundWorker::refreshSoundEffect()
@@ -140,7 +135,10 @@ void SoundWorker::setPortEnabled(unsigned int cardid, QString portName, bool ena
 void SoundWorker::setSinkBalance(double balance)
 {
     if (m_defaultSink) {
-        m_defaultSink->SetBalance(balance, true);
+        QPointer<Sink> sink = m_defaultSink;
+        m_writeCoalescer->write(sink, "Balance", [sink, balance] {
+            return sink->SetBalance(balance, true);
+        });
         qDebug() << "set balance to " << balance;
     }
 }
@@ -148,7 +146,10 @@ void SoundWorker::setSinkBalance(double balance)
 void SoundWorker::setSourceVolume(double volume)
 {
     if (m_defaultSource) {
-        m_defaultSource->SetVolume(volume, true);
+        QPointer<Source> source = m_defaultSource;
+        m_writeCoalescer->write(source, "Volume", [source, volume] {
+            return source->SetVolume(volume, true);
+        });
         qDebug() << "set source volume to " << volume;
     }
 }
@@ -156,7 +157,10 @@ void SoundWorker::setSourceVolume(double volume)
 void SoundWorker::setSinkVolume(double volume)
 {
     if (m_defaultSink) {
-        m_defaultSink->SetVolume(volume, true);
+        QPointer<Sink> sink = m_defaultSink;
+        m_writeCoalescer->write(sink, "Volume", [sink, volume] {
+            return sink->SetVolume(volume, true);
+        });
         qDebug() << "set sink volume to " << volume;
     }
 }
@@ -226,23 +230,21 @@ void SoundWorker::defaultSinkChanged(const QDBusObjectPath &path)
     if (path.path().isEmpty() || path.path() == "/" )
         return; //路径为空
 
+    // 旧的 binder 立即销毁，避免旧 sink 的属性覆盖新的
+    delete m_sinkBinder;
     if (m_defaultSink)
         m_defaultSink->deleteLater();
     m_defaultSink = new Sink("com.deepin.daemon.Audio", path.path(), QDBusConnection::sessionBus(), this);
 
-    connect(m_defaultSink, &Sink::MuteChanged, [this](bool mute) { m_model->setSpeakerOn(mute);});
-    connect(m_defaultSink, &Sink::BalanceChanged, m_model, &SoundModel::setSpeakerBalance);
-    connect(m_defaultSink, &Sink::VolumeChanged, m_model, &SoundModel::setSpeakerVolume);
-    connect(m_defaultSink, &Sink::ActivePortChanged, this, &SoundWorker::activeSinkPortChanged);
-    connect(m_defaultSink, &Sink::CardChanged, this, &SoundWorker::onSinkCardChanged);
-
-    m_model->setSpeakerOn(m_defaultSink->mute());
-    m_model->setSpeakerBalance(m_defaultSink->balance());
-    m_model->setSpeakerVolume(m_defaultSink->volume());
-    m_model->setSpeakerName(m_defaultSink->name());
-
-    activeSinkPortChanged(m_defaultSink->activePort());
-    onSinkCardChanged(m_defaultSink->card());
+    m_sinkBinder = new DBusPropertyBinder("com.deepin.daemon.Audio", path.path(), Sink::staticInterfaceName(), QDBusConnection::sessionBus(), m_defaultSink);
+    m_sinkBinder->setActive(m_audioBinder->isActive());
+    m_sinkBinder->bind("Mute", m_model, &SoundModel::setSpeakerOn);
+    m_sinkBinder->bind("Balance", m_model, &SoundModel::setSpeakerBalance);
+    m_sinkBinder->bind("Volume", m_model, &SoundModel::setSpeakerVolume);
+    m_sinkBinder->bind("Name", m_model, &SoundModel::setSpeakerName);
+    m_sinkBinder->bind("ActivePort", this, &SoundWorker::activeSinkPortChanged);
+    m_sinkBinder->bind("Card", this, &SoundWorker::onSinkCardChanged);
+    m_sinkBinder->refresh();
 }
 
 void SoundWorker::defaultSourceChanged(const QDBusObjectPath &path)
@@ -250,19 +252,18 @@ void SoundWorker::defaultSourceChanged(const QDBusObjectPath &path)
     qDebug() << "source default path:" << path.path();
     if (path.path().isEmpty() || path.path() == "/" ) return; //路径为空
 
+    delete m_sourceBinder;
     if (m_defaultSource) m_defaultSource->deleteLater();
     m_defaultSource = new Source("com.deepin.daemon.Audio", path.path(), QDBusConnection::sessionBus(), this);
 
-    connect(m_defaultSource, &Source::MuteChanged, [this](bool mute) { m_model->setMicrophoneOn(mute); });
-    connect(m_defaultSource, &Source::VolumeChanged, m_model, &SoundModel::setMicrophoneVolume);
-    connect(m_defaultSource, &Source::ActivePortChanged, this, &SoundWorker::activeSourcePortChanged);
-    connect(m_defaultSource, &Source::CardChanged, this, &SoundWorker::onSourceCardChanged);
-
-    m_model->setMicrophoneOn(m_defaultSource->mute());
-    m_model->setMicrophoneVolume(m_defaultSource->volume());
-    activeSourcePortChanged(m_defaultSource->activePort());
-    onSourceCardChanged(m_defaultSource->card());
-    m_model->setMicrophoneName(m_defaultSource->name());
+    m_sourceBinder = new DBusPropertyBinder("com.deepin.daemon.Audio", path.path(), Source::staticInterfaceName(), QDBusConnection::sessionBus(), m_defaultSource);
+    m_sourceBinder->setActive(m_audioBinder->isActive());
+    m_sourceBinder->bind("Mute", m_model, &SoundModel::setMicrophoneOn);
+    m_sourceBinder->bind("Volume", m_model, &SoundModel::setMicrophoneVolume);
+    m_sourceBinder->bind("ActivePort", this, &SoundWorker::activeSourcePortChanged);
+    m_sourceBinder->bind("Card", this, &SoundWorker::onSourceCardChanged);
+    m_sourceBinder->bind("Name", m_model, &SoundModel::setMicrophoneName);
+    m_sourceBinder->refresh();
 
 #ifndef DCC_DISABLE_FEEDBACK
     QDBusPendingCall call = m_defaultSource->GetMeter();
@@ -272,14 +273,17 @@ void SoundWorker::defaultSourceChanged(const QDBusObjectPath &path)
             QDBusReply<QDBusObjectPath> reply = call.reply();
             QDBusObjectPath path = reply.value();
 
+            delete m_meterBinder;
             if (m_sourceMeter) {
                 m_sourceMeter->deleteLater();
             }
 
             m_sourceMeter = new Meter("com.deepin.daemon.Audio", path.path(), QDBusConnection::sessionBus(), this);
             m_sourceMeter->setSync(false);
-            connect(m_sourceMeter, &Meter::VolumeChanged, m_model, &SoundModel::setMicrophoneFeedback);
-            m_model->setMicrophoneFeedback(m_sourceMeter->volume());
+            m_meterBinder = new DBusPropertyBinder("com.deepin.daemon.Audio", path.path(), Meter::staticInterfaceName(), QDBusConnection::sessionBus(), m_sourceMeter);
+            m_meterBinder->setActive(m_audioBinder->isActive());
+            m_meterBinder->bind("Volume", m_model, &SoundModel::setMicrophoneFeedback);
+            m_meterBinder->refresh();
         } else {
             qDebug() << "get meter failed " << call.error().message();
         }
@@ -15,6 +15,8 @@
 #include <com_deepin_system_systempower.h>
 
 #include "modules/moduleworker.h"
+#include "modules/dbuswritecoalescer.h"
+#include "modules/dbuspropertybinder.h"
 #include "soundmodel.h"
 
 #include <DDesktopServices>
@@ -93,12 +95,19 @@ private:
     QPointer<Meter> m_sourceMeter;
     QList<Sink*> m_sinks;
     QList<Source*> m_sources;
-    SystemPowerInter *m_powerInter;
+    // 属性通过一次 GetAll 读取，之后只处理 PropertiesChanged，生成的接口只用于调用方法
+    DBusPropertyBinder *m_audioBinder;
+    DBusPropertyBinder *m_sysPowerBinder;
+    QPointer<DBusPropertyBinder> m_sinkBinder;
+    QPointer<DBusPropertyBinder> m_sourceBinder;
+    QPointer<DBusPropertyBinder> m_meterBinder;
     QGSettings *m_dccSettings;
 
     QTimer *m_pingTimer;
     QDBusConnectionInterface *m_inter;
     int m_waitSoundPortReceipt;
+    // 拖动滑动条时只发送最新的音量和平衡
+    DBusWriteCoalescer *m_writeCoalescer;
 };
 
 }
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mirrorprober.h"
+
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+
+using namespace dcc::update;
+
+namespace {
+const int DefaultConcurrency = 6;
+const int DefaultTimeout = 3000;
+const int DefaultSampleCount = 3;
+
+quint16 defaultPort(const QString &scheme)
+{
+    if (scheme == "https")
+        return 443;
+    if (scheme == "ftp")
+        return 21;
+    return 80;
+}
+}
+
+MirrorProber::MirrorProber(QObject *parent)
+    : QObject(parent)
+    , m_concurrency(DefaultConcurrency)
+    , m_timeout(DefaultTimeout)
+    , m_sampleCount(DefaultSampleCount)
+    , m_finishedCount(0)
+{
+
+}
+
+MirrorProber::~MirrorProber()
+{
+    abort();
+}
+
+void MirrorProber::setConcurrency(int concurrency)
+{
+    m_concurrency = qMax(1, concurrency);
+}
+
+void MirrorProber::setTimeout(int msec)
+{
+    m_timeout = qMax(1, msec);
+}
+
+void MirrorProber::setSampleCount(int count)
+{
+    m_sampleCount = qMax(1, count);
+}
+
+void MirrorProber::probe(const QStringList &urls)
+{
+    abort();
+
+    for (int i = 0; i < urls.size(); ++i) {
+        const QUrl url(urls.at(i));
+        Mirror mirror;
+        mirror.host = url.host();
+        mirror.port = quint16(url.port(defaultPort(url.scheme())));
+        m_mirrors << mirror;
+        m_waiting << i;
+    }
+
+    startNext();
+}
+
+void MirrorProber::abort()
+{
+    for (Probe *probe : m_probes)
+        releaseProbe(probe);
+    m_probes.clear();
+    m_waiting.clear();
+    m_mirrors.clear();
+    m_finishedCount = 0;
+}
+
+MirrorProber::Result MirrorProber::computeResult(QList<int> samples, int failed)
+{
+    Result result;
+    result.succeeded = samples.size();
+    result.failed = failed;
+    if (samples.isEmpty())
+        return result;
+
+    std::sort(samples.begin(), samples.end());
+    const int count = samples.size();
+    result.latency = count % 2 ? samples.at(count / 2) : (samples.at(count / 2 - 1) + samples.at(count / 2)) / 2;
+
+    int deviation = 0;
+    for (int sample : samples)
+        deviation += qAbs(sample - result.latency);
+    result.jitter = deviation / count;
+
+    return result;
+}
+
+void MirrorProber::startNext()
+{
+    while (m_probes.size() < m_concurrency && !m_waiting.isEmpty())
+        startSample(m_waiting.takeFirst());
+}
+
+void MirrorProber::startSample(int mirror)
+{
+    if (m_mirrors.at(mirror).host.isEmpty()) {
+        ++m_mirrors[mirror].failed;
+        ++m_finishedCount;
+        Q_EMIT resultReady(mirror, computeResult({}, m_mirrors.at(mirror).failed));
+        if (!isRunning())
+            Q_EMIT finished();
+        return;
+    }
+
+    Probe *probe = new Probe;
+    probe->mirror = mirror;
+    probe->socket = new QTcpSocket(this);
+    probe->timer = new QTimer(probe->socket);
+    probe->timer->setSingleShot(true);
+    m_probes << probe;
+
+    connect(probe->socket, &QTcpSocket::connected, this, [this, probe] {
+        finishSample(probe, true);
+    });
+    connect(probe->socket, static_cast<void (QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error), this, [this, probe] {
+        finishSample(probe, false);
+    });
+    connect(probe->timer, &QTimer::timeout, this, [this, probe] {
+        finishSample(probe, false);
+    });
+
+    probe->elapsed.start();
+    probe->timer->start(m_timeout);
+    probe->socket->connectToHost(m_mirrors.at(mirror).host, m_mirrors.at(mirror).port);
+}
+
+void MirrorProber::finishSample(Probe *probe, bool connected)
+{
+    if (!m_probes.removeOne(probe))
+        return;
+
+    const int elapsed = int(probe->elapsed.elapsed());
+    const int mirror = probe->mirror;
+    releaseProbe(probe);
+
+    Mirror &info = m_mirrors[mirror];
+    if (connected)
+        info.samples << elapsed;
+    else
+        ++info.failed;
+
+    // 同一个镜像的样本依次测试，避免互相影响；第一次就连接失败的镜像不再重试
+    if (!info.samples.isEmpty() && info.samples.size() + info.failed < m_sampleCount) {
+        startSample(mirror);
+        return;
+    }
+
+    const Result result = computeResult(info.samples, info.failed);
+    ++m_finishedCount;
+    Q_EMIT resultReady(mirror, result);
+
+    if (isRunning())
+        startNext();
+    else
+        Q_EMIT finished();
+}
+
+void MirrorProber::releaseProbe(Probe *probe)
+{
+    // 先停止并销毁超时定时器，避免释放 socket 后定时器仍然触发
+    probe->timer->stop();
+    probe->timer->disconnect(this);
+    delete probe->timer;
+
+    probe->socket->disconnect(this);
+    probe->socket->abort();
+    probe->socket->deleteLater();
+    delete probe;
+}
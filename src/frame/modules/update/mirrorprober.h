@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MIRRORPROBER_H
+#define MIRRORPROBER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QStringList>
+
+class QTcpSocket;
+class QTimer;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief The MirrorProber class
+ * 测试镜像源的延迟：对每个镜像多次建立非阻塞的 TCP 连接，取连接耗时的中位数和抖动。
+ * 完全由事件循环驱动，不占用线程池，同时测试的镜像数量有上限
+ */
+class MirrorProber : public QObject
+{
+    Q_OBJECT
+public:
+    // 无法连接时的延迟，和界面上“超时”的判断一致
+    static const int TimeoutLatency = 10000;
+
+    struct Result {
+        int latency = TimeoutLatency;   // 成功样本的中位数，毫秒
+        int jitter = 0;                 // 成功样本与中位数的平均偏差，毫秒
+        int succeeded = 0;
+        int failed = 0;
+    };
+
+    explicit MirrorProber(QObject *parent = nullptr);
+    ~MirrorProber();
+
+    void setConcurrency(int concurrency);
+    void setTimeout(int msec);
+    void setSampleCount(int count);
+
+    // 开始测试，之前未完成的测试会被取消
+    void probe(const QStringList &urls);
+    void abort();
+    inline bool isRunning() const { return m_finishedCount < m_mirrors.size(); }
+
+    static Result computeResult(QList<int> samples, int failed);
+
+Q_SIGNALS:
+    // index 为 probe() 传入的镜像序号
+    void resultReady(int index, const Result &result);
+    void finished();
+
+private:
+    struct Mirror {
+        QString host;
+        quint16 port = 0;
+        QList<int> samples;
+        int failed = 0;
+    };
+
+    struct Probe {
+        int mirror = -1;
+        QTcpSocket *socket = nullptr;
+        QTimer *timer = nullptr;
+        QElapsedTimer elapsed;
+    };
+
+    void startNext();
+    void startSample(int mirror);
+    void finishSample(Probe *probe, bool connected);
+    void releaseProbe(Probe *probe);
+
+private:
+    int m_concurrency;
+    int m_timeout;
+    int m_sampleCount;
+
+    QList<Mirror> m_mirrors;
+    QList<int> m_waiting;       // 等待测试的镜像
+    QList<Probe *> m_probes;    // 正在进行的连接
+    int m_finishedCount;
+};
+
+}
+}
+
+#endif // MIRRORPROBER_H
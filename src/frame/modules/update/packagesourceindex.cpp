@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "packagesourceindex.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QUrl>
+#include <QDebug>
+
+using namespace dcc::update;
+
+namespace {
+const QByteArray PackageField = "Package:";
+const QByteArray VersionField = "Version:";
+const QByteArray StatusField = "Status:";
+const QByteArray InstalledStatus = "install ok installed";
+
+// 读取 "Field: value" 格式的值
+inline QString fieldValue(const QByteArray &line, const QByteArray &field)
+{
+    return QString::fromUtf8(line.mid(field.size()).trimmed());
+}
+}
+
+PackageSourceIndex::PackageSourceIndex(const QString &statusFile, const QString &listsDir)
+    : m_statusFile(statusFile)
+    , m_listsDir(listsDir)
+{
+
+}
+
+bool PackageSourceIndex::refresh()
+{
+    const FileStamps stamps = currentStamps();
+    if (stamps == m_stamps && !m_stamps.isEmpty())
+        return false;
+
+    m_stamps = stamps;
+    m_installed.clear();
+    m_sources.clear();
+
+    loadStatus();
+    for (auto it = stamps.cbegin(); it != stamps.cend(); ++it) {
+        if (it.key() != m_statusFile)
+            loadList(it.key());
+    }
+
+    qDebug() << "package index refreshed, installed:" << m_installed.size() << ", available:" << m_sources.size();
+    return true;
+}
+
+QStringList PackageSourceIndex::sources(const QString &package, const QString &version) const
+{
+    QStringList sources;
+    for (const auto &entry : m_sources.value(package)) {
+        if ((version.isEmpty() || entry.first == version) && !sources.contains(entry.second))
+            sources << entry.second;
+    }
+    return sources;
+}
+
+QString PackageSourceIndex::normalizeSource(const QString &url)
+{
+    QString source = url.trimmed();
+    const int schemeEnd = source.indexOf("://");
+    if (schemeEnd >= 0)
+        source = source.mid(schemeEnd + 3);
+
+    // apt 的文件名中不包含用户名和密码
+    const int slash = source.indexOf('/');
+    const int at = source.lastIndexOf('@', slash);
+    if (at >= 0)
+        source = source.mid(at + 1);
+
+    while (source.endsWith('/'))
+        source.chop(1);
+    return source;
+}
+
+QString PackageSourceIndex::sourceOfListFile(const QString &fileName)
+{
+    QString name = fileName;
+    const int dists = name.indexOf("_dists_");
+    if (dists >= 0) {
+        name.truncate(dists);
+    } else if (name.endsWith("_Packages")) {
+        // 没有 dists 的平铺仓库
+        name.chop(QString("_Packages").size());
+    }
+
+    // apt 将 / 转为 _，原有的 _ 转为 %5f
+    name.replace('_', '/');
+    return normalizeSource(QUrl::fromPercentEncoding(name.toUtf8()));
+}
+
+PackageSourceIndex::FileStamps PackageSourceIndex::currentStamps() const
+{
+    FileStamps stamps;
+    auto addStamp = [&stamps](const QFileInfo &info) {
+        stamps.insert(info.absoluteFilePath(), qMakePair(info.lastModified().toMSecsSinceEpoch(), info.size()));
+    };
+
+    QFileInfo status(m_statusFile);
+    if (status.exists())
+        stamps.insert(m_statusFile, qMakePair(status.lastModified().toMSecsSinceEpoch(), status.size()));
+
+    const QFileInfoList lists = QDir(m_listsDir).entryInfoList({ "*_Packages" }, QDir::Files);
+    for (const QFileInfo &info : lists)
+        addStamp(info);
+
+    return stamps;
+}
+
+void PackageSourceIndex::loadStatus()
+{
+    QFile file(m_statusFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "open dpkg status failed:" << m_statusFile << file.errorString();
+        return;
+    }
+
+    Package package;
+    bool installed = false;
+    auto finishStanza = [&] {
+        if (installed && !package.name.isEmpty() && !package.version.isEmpty())
+            m_installed << package;
+        package = Package();
+        installed = false;
+    };
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.trimmed().isEmpty()) {
+            finishStanza();
+        } else if (line.startsWith(PackageField)) {
+            package.name = fieldValue(line, PackageField);
+        } else if (line.startsWith(VersionField)) {
+            package.version = fieldValue(line, VersionField);
+        } else if (line.startsWith(StatusField)) {
+            installed = line.mid(StatusField.size()).trimmed() == InstalledStatus;
+        }
+    }
+    finishStanza();
+}
+
+void PackageSourceIndex::loadList(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "open package list failed:" << filePath << file.errorString();
+        return;
+    }
+
+    // 同一个文件中的包共享一个仓库字符串
+    const QString source = sourceOfListFile(QFileInfo(filePath).fileName());
+    QString name;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.startsWith(PackageField)) {
+            name = fieldValue(line, PackageField);
+        } else if (line.startsWith(VersionField) && !name.isEmpty()) {
+            m_sources[name].append(qMakePair(fieldValue(line, VersionField), source));
+            name.clear();
+        }
+    }
+}
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PACKAGESOURCEINDEX_H
+#define PACKAGESOURCEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief The PackageSourceIndex class
+ * 直接解析 dpkg 的 status 文件和 apt lists 目录中的 Packages 文件，建立 包名 -> (版本, 仓库) 的索引，
+ * 代替逐个包执行 dpkg -l 和 apt-cache madison。
+ * 文件的修改时间或大小变化后，refresh() 会重新读取
+ */
+class PackageSourceIndex
+{
+public:
+    struct Package {
+        QString name;
+        QString version;
+    };
+
+    explicit PackageSourceIndex(const QString &statusFile = "/var/lib/dpkg/status",
+                                const QString &listsDir = "/var/lib/apt/lists");
+
+    // 文件有变化时重新建立索引，返回是否重新读取了
+    bool refresh();
+
+    inline const QList<Package> &installedPackages() const { return m_installed; }
+    // 提供该包的仓库，version 为空时返回所有版本的仓库，和 apt-cache madison 的结果一致
+    QStringList sources(const QString &package, const QString &version = QString()) const;
+
+    // 仓库地址去掉协议和结尾的 /，例如 https://a.com/deepin/ -> a.com/deepin
+    static QString normalizeSource(const QString &url);
+    // 由 lists 目录中的文件名得到仓库地址，例如 a.com_deepin_dists_apricot_main_binary-amd64_Packages -> a.com/deepin
+    static QString sourceOfListFile(const QString &fileName);
+
+private:
+    typedef QHash<QString, QPair<qint64, qint64>> FileStamps;   // 文件 -> (修改时间, 大小)
+
+    FileStamps currentStamps() const;
+    void loadStatus();
+    void loadList(const QString &filePath);
+
+private:
+    QString m_statusFile;
+    QString m_listsDir;
+    FileStamps m_stamps;
+    QList<Package> m_installed;
+    QHash<QString, QList<QPair<QString, QString>>> m_sources;   // 包名 -> (版本, 仓库)
+};
+
+}
+}
+
+#endif // PACKAGESOURCEINDEX_H
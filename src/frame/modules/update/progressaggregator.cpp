@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "progressaggregator.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+
+using namespace dcc::update;
+
+namespace {
+// 获取不到屏幕刷新率时使用
+const qreal DefaultRate = 30;
+
+qreal screenRefreshRate()
+{
+    const QScreen *screen = qobject_cast<QGuiApplication *>(QCoreApplication::instance()) ? QGuiApplication::primaryScreen() : nullptr;
+    if (!screen || screen->refreshRate() < 1)
+        return DefaultRate;
+    return screen->refreshRate();
+}
+}
+
+ProgressAggregator::ProgressAggregator(const Handler &handler, QObject *parent)
+    : QObject(parent)
+    , m_handler(handler)
+    , m_timer(new QTimer(this))
+    , m_maxRate(0)
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &ProgressAggregator::onTimeout);
+
+    setMaxRate(0);
+}
+
+void ProgressAggregator::setMaxRate(qreal hz)
+{
+    m_maxRate = hz > 0 ? hz : screenRefreshRate();
+    m_timer->setInterval(qMax(1, qRound(1000 / m_maxRate)));
+}
+
+void ProgressAggregator::update(int type, Phase phase, double value)
+{
+    const Key key(type, phase);
+    m_pending[key] = value;
+
+    // 完成时不等待，避免界面状态已经变化而进度还没有到 100%
+    if (value >= 1.0) {
+        flush(type, phase);
+        return;
+    }
+
+    // 周期内的进度合并到下一次通知
+    if (m_timer->isActive())
+        return;
+
+    flush(type, phase);
+    m_timer->start();
+}
+
+void ProgressAggregator::flush()
+{
+    // 通知时可能会重新调用 update 或者 clear
+    const QMap<Key, double> pending = m_pending;
+    m_pending.clear();
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it)
+        notify(it.key(), it.value());
+}
+
+void ProgressAggregator::flush(int type, Phase phase)
+{
+    const Key key(type, phase);
+    if (!m_pending.contains(key))
+        return;
+
+    notify(key, m_pending.take(key));
+}
+
+void ProgressAggregator::clear()
+{
+    m_timer->stop();
+    m_pending.clear();
+    m_notified.clear();
+}
+
+void ProgressAggregator::notify(const Key &key, double value)
+{
+    auto it = m_notified.find(key);
+    if (it != m_notified.end() && it.value() == value)
+        return;
+
+    // 设置失败时(如下载信息还没有加载)不记录，之后相同的进度仍然会通知
+    if (m_handler(key.first, key.second, value))
+        m_notified[key] = value;
+}
+
+void ProgressAggregator::onTimeout()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    flush();
+    m_timer->start();
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PROGRESSAGGREGATOR_H
+#define PROGRESSAGGREGATOR_H
+
+#include <QObject>
+#include <QMap>
+#include <QPair>
+
+#include <functional>
+
+class QTimer;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief The ProgressAggregator class
+ * 合并各个更新任务的进度，按屏幕刷新率或者设置的频率通知界面。
+ * 每个更新类型的下载和安装进度分别只保留最新的，第一次变化立即通知，之后每个周期最多通知一次；
+ * 进度完成时立即通知，和上次设置成功的进度相同时不再通知
+ */
+class ProgressAggregator : public QObject
+{
+    Q_OBJECT
+public:
+    enum Phase {
+        Download,
+        Install
+    };
+
+    // 设置进度，返回是否设置成功；失败时不记录，之后相同的进度仍然会通知
+    typedef std::function<bool(int type, Phase phase, double value)> Handler;
+
+    explicit ProgressAggregator(const Handler &handler, QObject *parent = nullptr);
+
+    // 每秒最多通知的次数，小于等于 0 时使用屏幕刷新率
+    void setMaxRate(qreal hz);
+    inline qreal maxRate() const { return m_maxRate; }
+
+    void update(int type, Phase phase, double value);
+    // 立即通知还没有通知的进度
+    void flush();
+    void flush(int type, Phase phase);
+    // 丢弃还没有通知的进度，下次相同的进度也会通知
+    void clear();
+
+private:
+    typedef QPair<int, Phase> Key;
+
+    void notify(const Key &key, double value);
+    void onTimeout();
+
+private:
+    Handler m_handler;
+    QTimer *m_timer;
+    qreal m_maxRate;
+    QMap<Key, double> m_pending;
+    QMap<Key, double> m_notified;
+};
+
+}
+}
+
+#endif // PROGRESSAGGREGATOR_H
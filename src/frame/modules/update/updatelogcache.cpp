@@ -0,0 +1,248 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "updatelogcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+using namespace dcc::update;
+
+namespace {
+const quint32 UpdateLogCacheMagic = 0x44434c47; // "DCLG"
+const quint32 UpdateLogCacheVersion = 1;
+// 缓存的有效时间，秒
+const int DefaultMaxAge = 30 * 60;
+
+// 不依赖服务器返回来日志顺序，用systemVersion进行排序
+// 如果systemVersion版本号相同，则用发布时间排序；不考虑版本号相同且发布时间相同的情况，这种情况应该由运维人员避免
+bool newerThan(const UpdateLogItem &v1, const UpdateLogItem &v2)
+{
+    int compareRet = v1.systemVersion.compare(v2.systemVersion);
+    if (compareRet == 0) {
+        return v1.publishTime.compare(v2.publishTime) > 0;
+    }
+    return compareRet > 0;
+}
+
+bool sameItem(const UpdateLogItem &v1, const UpdateLogItem &v2)
+{
+    return v1.id == v2.id && v1.platformType == v2.platformType && v1.serverType == v2.serverType
+            && v1.logType == v2.logType && v1.systemVersion == v2.systemVersion && v1.cnLog == v2.cnLog
+            && v1.enLog == v2.enLog && v1.publishTime == v2.publishTime;
+}
+}
+
+namespace dcc {
+namespace update {
+QDataStream &operator<<(QDataStream &out, const UpdateLogItem &item)
+{
+    return out << item.id << item.platformType << item.serverType << item.logType
+               << item.systemVersion << item.cnLog << item.enLog << item.publishTime;
+}
+
+QDataStream &operator>>(QDataStream &in, UpdateLogItem &item)
+{
+    return in >> item.id >> item.platformType >> item.serverType >> item.logType
+              >> item.systemVersion >> item.cnLog >> item.enLog >> item.publishTime;
+}
+}
+}
+
+UpdateLogCache::UpdateLogCache(const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , m_fileName(fileName.isEmpty() ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/update-logs.cache" : fileName)
+    , m_http(nullptr)
+    , m_maxAge(DefaultMaxAge)
+    , m_fetching(false)
+{
+
+}
+
+bool UpdateLogCache::load()
+{
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != UpdateLogCacheMagic || version != UpdateLogCacheVersion) {
+        qWarning() << "invalid update log cache:" << m_fileName;
+        return false;
+    }
+
+    in.setVersion(QDataStream::Qt_5_11);
+    QByteArray key, etag, bodyHash;
+    QDateTime fetchTime;
+    QList<UpdateLogItem> logs;
+    in >> key >> etag >> bodyHash >> fetchTime >> logs;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    m_key = key;
+    m_etag = etag;
+    m_bodyHash = bodyHash;
+    m_fetchTime = fetchTime;
+    m_logs = logs;
+    return true;
+}
+
+bool UpdateLogCache::save() const
+{
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << UpdateLogCacheMagic << UpdateLogCacheVersion;
+    out.setVersion(QDataStream::Qt_5_11);
+    out << m_key << m_etag << m_bodyHash << m_fetchTime << m_logs;
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+void UpdateLogCache::fetch(const QUrl &url, const QByteArray &body)
+{
+    const QByteArray key = requestKey(url, body);
+    if (m_fetching) {
+        if (key == m_fetchingKey) {
+            m_pendingUrl.clear();
+            m_pendingBody.clear();
+        } else {
+            m_pendingUrl = url;
+            m_pendingBody = body;
+        }
+        return;
+    }
+
+    if (key == m_key && m_fetchTime.isValid() && m_fetchTime.secsTo(QDateTime::currentDateTimeUtc()) < m_maxAge) {
+        qInfo() << "Update logs are up to date, fetched at" << m_fetchTime;
+        return;
+    }
+
+    if (!m_http)
+        m_http = new QNetworkAccessManager(this);
+
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    if (key == m_key && !m_etag.isEmpty())
+        request.setRawHeader("If-None-Match", m_etag);
+
+    m_fetching = true;
+    m_fetchingKey = key;
+    QNetworkReply *reply = m_http->post(request, body);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, key] {
+        reply->deleteLater();
+        m_fetching = false;
+        handleReply(reply, key);
+
+        if (!m_pendingUrl.isEmpty()) {
+            const QUrl url = m_pendingUrl;
+            const QByteArray body = m_pendingBody;
+            m_pendingUrl.clear();
+            m_pendingBody.clear();
+            fetch(url, body);
+        }
+    });
+    qInfo() << "Post request to get update log, request body: " << body;
+}
+
+void UpdateLogCache::handleReply(QNetworkReply *reply, const QByteArray &key)
+{
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "Network Error" << reply->errorString();
+        return;
+    }
+
+    const bool sameRequest = key == m_key;
+    if (sameRequest && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        qInfo() << "Update logs are not modified";
+        m_fetchTime = QDateTime::currentDateTimeUtc();
+        save();
+        return;
+    }
+
+    const QByteArray respondBody = reply->readAll();
+    if (respondBody.isEmpty()) {
+        qWarning() << "Request body is empty";
+        return;
+    }
+
+    // 内容和上次相同时不再解析
+    const QByteArray bodyHash = QCryptographicHash::hash(respondBody, QCryptographicHash::Sha1);
+    if (!sameRequest || bodyHash != m_bodyHash) {
+        const QJsonObject &obj = QJsonDocument::fromJson(respondBody).object();
+        if (obj.isEmpty()) {
+            qWarning() << "Request body json object is empty";
+            return;
+        }
+        if (obj.value("code").toInt() != 0) {
+            qWarning() << "Request update log failed";
+            return;
+        }
+
+        // 服务器返回的是完整的日志列表，已经删除的日志不再保留
+        if (replaceLogs(obj.value("data").toArray()))
+            Q_EMIT logsChanged();
+    }
+
+    m_key = key;
+    m_etag = reply->rawHeader("ETag");
+    m_bodyHash = bodyHash;
+    m_fetchTime = QDateTime::currentDateTimeUtc();
+    save();
+}
+
+bool UpdateLogCache::replaceLogs(const QJsonArray &array)
+{
+    QList<UpdateLogItem> logs;
+    for (const QJsonValue &value : array) {
+        const QJsonObject obj = value.toObject();
+        if (obj.isEmpty())
+            continue;
+
+        UpdateLogItem item;
+        item.id = obj.value("id").toInt();
+        item.systemVersion = obj.value("systemVersion").toString();
+        item.cnLog = obj.value("cnLog").toString();
+        item.enLog = obj.value("enLog").toString();
+        item.publishTime = obj.value("publishTime").toString();
+        item.platformType = obj.value("platformType").toInt();
+        item.serverType = obj.value("serverType").toInt();
+        item.logType = obj.value("logType").toInt();
+        logs << item;
+    }
+    std::stable_sort(logs.begin(), logs.end(), newerThan);
+
+    const bool changed = logs.size() != m_logs.size()
+            || !std::equal(logs.cbegin(), logs.cend(), m_logs.cbegin(), sameItem);
+    m_logs = logs;
+    return changed;
+}
+
+QByteArray UpdateLogCache::requestKey(const QUrl &url, const QByteArray &body)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(url.adjusted(QUrl::RemoveQuery).toEncoded());
+    hash.addData(body);
+    return hash.result();
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef UPDATELOGCACHE_H
+#define UPDATELOGCACHE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QList>
+#include <QUrl>
+
+class QJsonArray;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief 更新日志中一个版本的信息
+ *
+ * 示例数据：
+ * {
+        "id": 1,
+        "platformType": 1,
+        "cnLog": "<p>中文日志</p>",
+        "enLog": "<p>英文日志</p>",
+        "serverType": 0,
+        "systemVersion": "1070U1",
+        "createdAt": "2022-08-10T17:45:54+08:00",
+        "logType": 1,
+        "publishTime": "2022-08-06T00:00:00+08:00"
+    }
+ */
+struct UpdateLogItem
+{
+    int id = -1;
+    int platformType = 1;
+    int serverType = 0;
+    int logType = 1;
+    QString systemVersion = "";
+    QString cnLog = "";
+    QString enLog = "";
+    QString publishTime = "";
+
+    bool isValid() const { return -1 != id; }
+};
+
+/**
+ * @brief The UpdateLogCache class
+ * 更新日志的本地缓存，按版本号和发布时间降序保存，读取后不需要再解析和排序。
+ * 请求参数不变且缓存未过期时不请求服务器；请求时带上 If-None-Match，服务器返回 304 或者
+ * 和上次相同的内容时不重新解析，内容变化时用服务器返回的日志替换缓存
+ */
+class UpdateLogCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit UpdateLogCache(const QString &fileName = QString(), QObject *parent = nullptr);
+
+    bool load();
+    // 已经排好序，publishTime 为服务器返回的原始时间
+    inline const QList<UpdateLogItem> &logs() const { return m_logs; }
+
+    inline void setMaxAge(int secs) { m_maxAge = secs; }
+    // url 中的查询参数不影响是否使用缓存；请求过程中参数变化时，完成后再用新的参数请求
+    void fetch(const QUrl &url, const QByteArray &body);
+
+Q_SIGNALS:
+    void logsChanged();
+
+private:
+    void handleReply(QNetworkReply *reply, const QByteArray &key);
+    bool replaceLogs(const QJsonArray &array);
+    bool save() const;
+    static QByteArray requestKey(const QUrl &url, const QByteArray &body);
+
+private:
+    QString m_fileName;
+    QNetworkAccessManager *m_http;
+    int m_maxAge;
+    bool m_fetching;
+    QByteArray m_fetchingKey;
+    QUrl m_pendingUrl;          // 请求过程中收到的新请求，只保留最后一个
+    QByteArray m_pendingBody;
+
+    QByteArray m_key;           // 请求地址和参数的摘要
+    QByteArray m_etag;
+    QByteArray m_bodyHash;      // 上次返回内容的摘要
+    QDateTime m_fetchTime;
+    QList<UpdateLogItem> m_logs;
+};
+
+}
+}
+
+#endif // UPDATELOGCACHE_H
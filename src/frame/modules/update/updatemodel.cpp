@@ -45,7 +45,6 @@ UpdateModel::UpdateModel(QObject *parent)
     , m_sourceCheck(false)
 #endif
     , m_lowBattery(false)
-    , m_netselectExist(false)
     , m_autoCleanCache(false)
     , m_autoDownloadUpdates(false)
     , m_autoInstallUpdates(false)
@@ -290,22 +289,6 @@ void UpdateModel::setUpdateProgress(double updateProgress)
     }
 }
 
-bool UpdateModel::netselectExist() const
-{
-    return m_netselectExist;
-}
-
-void UpdateModel::setNetselectExist(bool netselectExist)
-{
-    if (m_netselectExist == netselectExist) {
-        return;
-    }
-
-    m_netselectExist = netselectExist;
-
-    Q_EMIT netselectExistChanged(netselectExist);
-}
-
 
 void UpdateModel::setAutoCheckUpdates(bool autoCheckUpdates)
 {
@@ -129,9 +129,6 @@ public:
     void setSourceCheck(bool sourceCheck);
 #endif
 
-    bool netselectExist() const;
-    void setNetselectExist(bool netselectExist);
-
     inline bool autoCheckUpdates() const { return m_autoCheckUpdates; }
     void setAutoCheckUpdates(bool autoCheckUpdates);
 
@@ -272,7 +269,6 @@ Q_SIGNALS:
     void updateProgressChanged(const double &updateProgress);
     void upgradeProgressChanged(const double &upgradeProgress);
     void autoCleanCacheChanged(const bool autoCleanCache);
-    void netselectExistChanged(const bool netselectExist);
     void autoCheckUpdatesChanged(const bool autoCheckUpdates);
     void autoCheckSystemUpdatesChanged(const bool autoCheckSystemUpdate);
     void autoCheckAppUpdatesChanged(const bool autoCheckAppUpdate);
@@ -312,7 +308,6 @@ private:
 #endif
 
     bool m_lowBattery;
-    bool m_netselectExist;
     bool m_autoCleanCache;
     bool m_autoDownloadUpdates;
     bool m_autoInstallUpdates;
@@ -28,7 +28,6 @@ using namespace DCC_NAMESPACE;
 const QString TestingChannelPackage = "deepin-unstable-source";
 const QString ChangeLogFile = "/usr/share/deepin/release-note/UpdateInfo.json";
 const QString ChangeLogDic = "/usr/share/deepin/";
-const QString UpdateLogTmpFile = "/tmp/deepin-update-log.json";
 
 const int LogTypeSystem = 1;    // 系统更新
 const int LogTypeSecurity = 2;  // 安全更新
@@ -41,47 +40,6 @@ const QString DDEId = "dde";
 
 namespace dcc {
 namespace update {
-static int TestMirrorSpeedInternal(const QString &url, QPointer<QObject> baseObject)
-{
-    if (!baseObject || QCoreApplication::closingDown()) {
-        return -1;
-    }
-
-    QStringList args;
-    args << url << "-s" << "1";
-
-    QProcess process;
-    process.start("netselect", args);
-
-    if (!process.waitForStarted()) {
-        return 10000;
-    }
-
-    do {
-        if (!baseObject || QCoreApplication::closingDown()) {
-            process.kill();
-            process.terminate();
-            process.waitForFinished(1000);
-
-            return -1;
-        }
-
-        if (process.waitForFinished(500))
-            break;
-    } while (process.state() == QProcess::Running);
-
-    const QString output = process.readAllStandardOutput().trimmed();
-    const QStringList result = output.split(' ');
-
-    qDebug() << "speed of url" << url << "is" << result.first();
-
-    if (!result.first().isEmpty()) {
-        return result.first().toInt();
-    }
-
-    return 10000;
-}
-
 static int getPlatform()
 {
     if (DCC_NAMESPACE::IsServerSystem) {
@@ -123,8 +81,18 @@ UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
     , m_iconThemeState("")
     , m_backupStatus(BackupStatus::NoBackup)
     , m_backupingClassifyType(ClassifyUpdateType::Invalid)
-{
-
+    , m_packageIndex(new PackageSourceIndex)
+    , m_testingChannelCheckWatcher(nullptr)
+    , m_mirrorProber(nullptr)
+    , m_updateLogCache(new UpdateLogCache(QString(), this))
+    // 下载和安装的进度按屏幕刷新率合并后再通知界面
+    , m_progressAggregator(new ProgressAggregator([this](int type, ProgressAggregator::Phase, double value) {
+        return onProgressChanged(type, value);
+    }, this))
+{
+    connect(m_updateLogCache, &UpdateLogCache::logsChanged, this, [this] {
+        setUpdateLogs(m_updateLogCache->logs());
+    });
 }
 
 UpdateWorker::~UpdateWorker()
@@ -413,29 +381,11 @@ void UpdateWorker::setUpdateInfo()
         }
     }
 
-    // 如果内存中没有日志数据，那么从文件里面读取
-    do {
-        if (!m_updateLogs.isEmpty() || !QFile::exists(UpdateLogTmpFile))
-            break;
-
-        qInfo() << "Update log is empty, read logs from temporary file";
-        QFile logFile(UpdateLogTmpFile);
-        if (!logFile.open(QFile::ReadOnly)) {
-            qWarning() << "Can not open update log file:" << UpdateLogTmpFile;
-            break;
-        }
-
-        QJsonParseError err_rpt;
-        QJsonDocument updateInfoDoc = QJsonDocument::fromJson(logFile.readAll(), &err_rpt);
-        logFile.close();
-        if (err_rpt.error != QJsonParseError::NoError) {
-            qWarning() << "Parse update log error: " << err_rpt.errorString();
-            break;
-        }
-        setUpdateLogs(updateInfoDoc.array());
+    // 如果内存中没有日志数据，那么从缓存里面读取
+    if (m_updateLogs.isEmpty() && m_updateLogCache->load()) {
+        setUpdateLogs(m_updateLogCache->logs());
         qInfo() << "Update logs size: " << m_updateLogs.size();
-    } while(0);
-
+    }
 
     QMap<ClassifyUpdateType, UpdateItemInfo *> updateInfoMap = getAllUpdateInfo();
     m_model->setAllDownloadInfo(updateInfoMap);
@@ -530,23 +480,11 @@ QMap<ClassifyUpdateType, UpdateItemInfo *> UpdateWorker::getAllUpdateInfo()
 void UpdateWorker::requestUpdateLog()
 {
     qInfo() << "Get update info";
-    // 接收并处理respond
-    QNetworkAccessManager *http = new QNetworkAccessManager(this);
-    connect(http, &QNetworkAccessManager::finished, this, [ this, http ] (QNetworkReply *reply) {
-        reply->deleteLater();
-        http->deleteLater();
-
-        handleUpdateLogsReply(reply);
-    });
-
     // 请求头
-    QNetworkRequest request;
     QUrl url(getUpdateLogAddress());
     QUrlQuery urlQuery;
     urlQuery.addQueryItem("rt", QByteArray::number(QDateTime::currentDateTime().toTime_t()));
     url.setQuery(urlQuery);
-    request.setUrl(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     // 请求体
     // TODO 增加过滤参数，避免每次请求全量更新日志，这个需要web端配合
@@ -555,48 +493,13 @@ void UpdateWorker::requestUpdateLog()
     requestBody["isUnstable"] = isUnstableResource();
     QJsonDocument doc;
     doc.setObject(requestBody);
-    const QByteArray &body = doc.toJson();
 
-    http->post(request, body);
-    qInfo() << "Pose request to get update log, request body: " << body;
+    // 缓存未过期或者服务器内容没有变化时不会重新解析
+    if (m_updateLogs.isEmpty() && m_updateLogCache->load())
+        setUpdateLogs(m_updateLogCache->logs());
+    m_updateLogCache->fetch(url, doc.toJson());
 }
 
-void UpdateWorker::handleUpdateLogsReply(QNetworkReply *reply)
-{
-    qInfo() << "Handle reply of update log";
-    if (reply->error() != QNetworkReply::NoError) {
-        qWarning() << "Network Error" << reply->errorString();
-        return;
-    }
-    QByteArray respondBody = reply->readAll();
-    if (respondBody.isEmpty()) {
-        qWarning() << "Request body is empty";
-        return;
-    }
-
-    const QJsonDocument &doc = QJsonDocument::fromJson(respondBody);
-    const QJsonObject &obj = doc.object();
-    if (obj.isEmpty()) {
-        qWarning() << "Request body json object is empty";
-        return;
-    }
-    if (obj.value("code").toInt() != 0) {
-        qWarning() << "Request update log failed";
-        return;
-    }
-
-    const QJsonArray array = obj.value("data").toArray();
-    setUpdateLogs(array);
-    // 保存一个临时文件，在没有获取到在线日志的时候展示文件中的内容
-    QFile::remove(UpdateLogTmpFile);
-    QFile file(UpdateLogTmpFile);
-    if (file.open(QIODevice::WriteOnly)) {
-        QJsonDocument dataDoc;
-        dataDoc.setArray(array);
-        file.write(dataDoc.toJson());
-        file.close();
-    }}
-
 QString UpdateWorker::getUpdateLogAddress() const
 {
     const DConfig *dconfig = DConfigWatcher::instance()->getModulesConfig(DConfigWatcher::update);
@@ -704,6 +607,7 @@ void UpdateWorker::resetDownloadInfo(bool state)
     m_unknownPackages.clear();
 
     if (!state) {
+        m_progressAggregator->clear();
         deleteJob(m_sysUpdateDownloadJob);
         deleteJob(m_sysUpdateInstallJob);
         deleteJob(m_safeUpdateDownloadJob);
@@ -930,74 +834,39 @@ QString UpdateWorker::getTestingChannelSource()
     }
     return "";
 }
-// get all sources of the package
-QStringList UpdateWorker::getSourcesOfPackage(const QString pkg, const QString version)
-{
-    QStringList sources;
-    QProcess aptCacheProcess;
-    QStringList args;
-    args.append("madison");
-    args.append(pkg);
-    // exec apt-cache madison $pkg
-    aptCacheProcess.start("apt-cache", args);
-    aptCacheProcess.waitForFinished();
-    while (aptCacheProcess.canReadLine()) {
-        QString line(aptCacheProcess.readLine());
-        auto fields = line.split("|", QString::SkipEmptyParts);
-        for (QString &field : fields) {
-            field = field.trimmed();
-        }
-        if (fields.length() <= 2) {
-            continue;
-        }
-        auto p = fields[0], ver = fields[1], src = fields[2];
-        src.truncate(fields[2].indexOf(" "));
-        if (p == pkg) {
-            if (version.length() == 0 || version == ver) {
-                sources.append(src);
-            }
-        }
-    }
-    return sources.toSet().toList();
-}
-
 // checkCanExitTestingChannel check if the current env can exit internal test channel
 void UpdateWorker::checkCanExitTestingChannel()
 {
-    auto testingChannelSource = getTestingChannelSource();
-    QProcess dpkgProcess;
-    // exec dpkg -l
-    dpkgProcess.start("dpkg", QStringList("-l"));
-    dpkgProcess.waitForStarted();
-    // read stdout by line
-    while (dpkgProcess.state() == QProcess::Running) {
-        dpkgProcess.waitForReadyRead();
-        while (dpkgProcess.canReadLine()) {
-            QString line(dpkgProcess.readLine());
-            // skip uninstalled
-            if (!line.startsWith("ii")) {
-                continue;
-            }
-            auto field = line.split(" ", QString::SkipEmptyParts);
-            // skip unknown format line
-            if (field.length() <= 2) {
-                continue;
-            }
-            auto pkg = field[1], version = field[2];
+    if (m_testingChannelCheckWatcher)
+        return;
+
+    const QString testingChannelSource = PackageSourceIndex::normalizeSource(getTestingChannelSource());
+    QSharedPointer<PackageSourceIndex> packageIndex = m_packageIndex;
+
+    m_testingChannelCheckWatcher = new QFutureWatcher<bool>(this);
+    connect(m_testingChannelCheckWatcher, &QFutureWatcher<bool>::finished, this, [this] {
+        m_model->setCanExitTestingChannel(m_testingChannelCheckWatcher->result());
+        m_testingChannelCheckWatcher->deleteLater();
+        m_testingChannelCheckWatcher = nullptr;
+    });
+
+    // 索引在后台线程中读取，只有 dpkg 或 apt 的文件变化后才重新解析
+    m_testingChannelCheckWatcher->setFuture(QtConcurrent::run([packageIndex, testingChannelSource] {
+        packageIndex->refresh();
+        for (const PackageSourceIndex::Package &package : packageIndex->installedPackages()) {
+            const QString &pkg = package.name;
             // skip non system software
             if (!pkg.contains("dde") && !pkg.contains("deepin") && !pkg.contains("dtk") && !pkg.contains("uos")) {
                 continue;
             }
             // Does the package exists only in the internal test source
-            auto sources = getSourcesOfPackage(pkg, version);
+            const QStringList sources = packageIndex->sources(pkg, package.version);
             if (sources.length() == 1 && sources[0].contains(testingChannelSource)) {
-                m_model->setCanExitTestingChannel(false);
-                return;
+                return false;
             }
         }
-    }
-    m_model->setCanExitTestingChannel(true);
-    return;
+        return true;
+    }));
 }
 
 #ifndef DISABLE_SYS_UPDATE_SOURCE_CHECK
@@ -1019,40 +888,18 @@ void UpdateWorker::testMirrorSpeed()
     // reset the data;
     m_model->setMirrorSpeedInfo(QMap<QString, int>());
 
-    QFutureWatcher<int> *watcher = new QFutureWatcher<int>();
-    connect(watcher, &QFutureWatcher<int>::resultReadyAt, [this, urlList, watcher, mirrors](int index) {
-        QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
-
-        int result = watcher->resultAt(index);
-        QString mirrorId = mirrors.at(index).m_id;
-        speedInfo[mirrorId] = result;
+    if (!m_mirrorProber) {
+        m_mirrorProber = new MirrorProber(this);
+    }
 
+    // 重新测试时丢弃上一次的结果
+    m_mirrorProber->disconnect(this);
+    connect(m_mirrorProber, &MirrorProber::resultReady, this, [this, mirrors](int index, const MirrorProber::Result &result) {
+        QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
+        speedInfo[mirrors.at(index).m_id] = result.latency;
         m_model->setMirrorSpeedInfo(speedInfo);
     });
-
-    QPointer<QObject> guest(this);
-    QFuture<int> future = QtConcurrent::mapped(urlList, std::bind(TestMirrorSpeedInternal, std::placeholders::_1, guest));
-    watcher->setFuture(future);
-}
-
-void UpdateWorker::checkNetselect()
-{
-    QProcess *process = new QProcess;
-    process->start("netselect", QStringList() << "127.0.0.1");
-    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
-        if ((error == QProcess::FailedToStart) || (error == QProcess::Crashed)) {
-            m_model->setNetselectExist(false);
-            process->deleteLater();
-        }
-    });
-    connect(process, static_cast<void (QProcess::*)(int)>(&QProcess::finished), this, [this, process](int result) {
-        bool isNetselectExist = 0 == result;
-        if (!isNetselectExist) {
-            qDebug() << "[wubw UpdateWorker] netselect 127.0.0.1 : " << isNetselectExist;
-        }
-        m_model->setNetselectExist(isNetselectExist);
-        process->deleteLater();
-    });
+    m_mirrorProber->probe(urlList);
 }
 
 void UpdateWorker::setSmartMirror(bool enable)
@@ -1196,6 +1043,8 @@ void UpdateWorker::setDownloadJob(const QString &jobPath, ClassifyUpdateType upd
     }
 
     connect(job, &__Job::StatusChanged, this, [ = ](QString status) {
+        // 状态变化前先更新合并中的进度
+        m_progressAggregator->flush(updateType, ProgressAggregator::Download);
         onClassityDownloadStatusChanged(updateType, status);
     });
 
@@ -1229,6 +1078,7 @@ void UpdateWorker::setDistUpgradeJob(const QString &jobPath, ClassifyUpdateType
     }
 
     connect(job, &__Job::StatusChanged, this, [ = ](QString status) {
+        m_progressAggregator->flush(updateType, ProgressAggregator::Install);
         onClassityInstallStatusChanged(updateType, status);
     });
 
@@ -1236,21 +1086,22 @@ void UpdateWorker::setDistUpgradeJob(const QString &jobPath, ClassifyUpdateType
     job->ProgressChanged(job->progress());
 }
 
-void UpdateWorker::setUpdateItemProgress(UpdateItemInfo *itemInfo, double value)
+bool UpdateWorker::setUpdateItemProgress(UpdateItemInfo *itemInfo, double value)
 {
     //异步加载数据,会导致下载信息还未获取就先取到了下载进度
     if (itemInfo) {
         if (!getNotUpdateState()) {
             qDebug() << " Now can't to update continue...";
             resetDownloadInfo();
-            return;
+            return false;
         }
         itemInfo->setDownloadProgress(value);
-
-    } else {
-        //等待下载信息加载后,再通过 onNotifyDownloadInfoChanged() 设置"UpdatesStatus::Downloading"状态
-        qDebug() << "[wubw download] DownloadInfo is nullptr , waitfor download info";
+        return true;
     }
+
+    //等待下载信息加载后,再通过 onNotifyDownloadInfoChanged() 设置"UpdatesStatus::Downloading"状态
+    qDebug() << "[wubw download] DownloadInfo is nullptr , waitfor download info";
+    return false;
 }
 
 bool UpdateWorker::hasBackedUp()
@@ -1339,55 +1190,58 @@ void UpdateWorker::onJobListChanged(const QList<QDBusObjectPath> &jobs)
 
 void UpdateWorker::onSysUpdateDownloadProgressChanged(double value)
 {
-    UpdateItemInfo *itemInfo = m_model->systemDownloadInfo();
-    setUpdateItemProgress(itemInfo, value);
+    m_progressAggregator->update(ClassifyUpdateType::SystemUpdate, ProgressAggregator::Download, value);
 }
 
 void UpdateWorker::onSafeUpdateDownloadProgressChanged(double value)
 {
-    UpdateItemInfo *itemInfo = m_model->safeDownloadInfo();
-
-    setUpdateItemProgress(itemInfo, value);
+    m_progressAggregator->update(ClassifyUpdateType::SecurityUpdate, ProgressAggregator::Download, value);
 }
 
 void UpdateWorker::onUnkonwnUpdateDownloadProgressChanged(double value)
 {
-    UpdateItemInfo *itemInfo = m_model->unknownDownloadInfo();
-
-    setUpdateItemProgress(itemInfo, value);
-
+    m_progressAggregator->update(ClassifyUpdateType::UnknownUpdate, ProgressAggregator::Download, value);
 }
 
 void UpdateWorker::onSysUpdateInstallProgressChanged(double value)
 {
-    UpdateItemInfo *itemInfo = m_model->systemDownloadInfo();
-    if (itemInfo == nullptr || qFuzzyIsNull(value)) {
+    if (qFuzzyIsNull(value)) {
         return;
     }
 
-    setUpdateItemProgress(itemInfo, value);
-
+    m_progressAggregator->update(ClassifyUpdateType::SystemUpdate, ProgressAggregator::Install, value);
 }
 
 void UpdateWorker::onSafeUpdateInstallProgressChanged(double value)
 {
-    UpdateItemInfo *itemInfo = m_model->safeDownloadInfo();
-    if (itemInfo == nullptr || qFuzzyIsNull(value)) {
+    if (qFuzzyIsNull(value)) {
         return;
     }
 
-    setUpdateItemProgress(itemInfo, value);
+    m_progressAggregator->update(ClassifyUpdateType::SecurityUpdate, ProgressAggregator::Install, value);
 }
 
 void UpdateWorker::onUnkonwnUpdateInstallProgressChanged(double value)
 {
-    UpdateItemInfo *itemInfo = m_model->unknownDownloadInfo();
-    if (itemInfo == nullptr || qFuzzyIsNull(value)) {
+    if (qFuzzyIsNull(value)) {
         return;
     }
 
-    qDebug() << "onUnkonwnUpdateInstallProgressChanged : " << value;
-    setUpdateItemProgress(itemInfo, value);
+    m_progressAggregator->update(ClassifyUpdateType::UnknownUpdate, ProgressAggregator::Install, value);
+}
+
+bool UpdateWorker::onProgressChanged(int type, double value)
+{
+    switch (type) {
+    case ClassifyUpdateType::SystemUpdate:
+        return setUpdateItemProgress(m_model->systemDownloadInfo(), value);
+    case ClassifyUpdateType::SecurityUpdate:
+        return setUpdateItemProgress(m_model->safeDownloadInfo(), value);
+    case ClassifyUpdateType::UnknownUpdate:
+        return setUpdateItemProgress(m_model->unknownDownloadInfo(), value);
+    default:
+        return false;
+    }
 }
 
 void UpdateWorker::onIconThemeChanged(const QString &theme)
@@ -1882,38 +1736,17 @@ void UpdateWorker::onRequestLastoreHeartBeat()
     lastoreManager.asyncCall("GetCheckIntervalAndTime");
 }
 
-void UpdateWorker::setUpdateLogs(const QJsonArray &array)
+void UpdateWorker::setUpdateLogs(const QList<UpdateLogItem> &logs)
 {
-    if (array.isEmpty())
+    if (logs.isEmpty())
         return;
 
-    m_updateLogs.clear();
-    for(const QJsonValue &value : array) {
-        QJsonObject obj = value.toObject();
-        if (obj.isEmpty())
-            continue;
-
-        UpdateLogItem item;
-        item.id = obj.value("id").toInt();
-        item.systemVersion = obj.value("systemVersion").toString();
-        item.cnLog = obj.value("cnLog").toString();
-        item.enLog = obj.value("enLog").toString();
-        item.publishTime = DCC_NAMESPACE::utcDateTime2LocalDate(obj.value("publishTime").toString());
-        item.platformType = obj.value("platformType").toInt();
-        item.serverType = obj.value("serverType").toInt();
-        item.logType = obj.value("logType").toInt();
-        m_updateLogs.append(std::move(item));
+    // 缓存中已经按版本号和发布时间排好序
+    m_updateLogs = logs;
+    for (UpdateLogItem &item : m_updateLogs) {
+        item.publishTime = DCC_NAMESPACE::utcDateTime2LocalDate(item.publishTime);
     }
     qInfo() << "m_updateLogs size: " << m_updateLogs.size();
-    // 不依赖服务器返回来日志顺序，用systemVersion进行排序
-    // 如果systemVersion版本号相同，则用发布时间排序；不考虑版本号相同且发布时间相同的情况，这种情况应该由运维人员避免
-    qSort(m_updateLogs.begin(), m_updateLogs.end(), [] (const UpdateLogItem &v1, const UpdateLogItem &v2) -> bool {
-        int compareRet = v1.systemVersion.compare(v2.systemVersion);
-        if (compareRet == 0) {
-            return v1.publishTime.compare(v2.publishTime) >= 0;
-        }
-        return compareRet > 0;
-    });
 }
 
 /**
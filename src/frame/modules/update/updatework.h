@@ -21,6 +21,13 @@
 #include <com_deepin_daemon_appearance.h>
 
 #include "common.h"
+#include "packagesourceindex.h"
+#include "mirrorprober.h"
+#include "updatelogcache.h"
+#include "progressaggregator.h"
+
+#include <QFutureWatcher>
+#include <QSharedPointer>
 
 using UpdateInter = com::deepin::lastore::Updater;
 using JobInter = com::deepin::lastore::Job;
@@ -33,8 +40,6 @@ using SmartMirrorInter = com::deepin::lastore::Smartmirror;
 using RecoveryInter = com::deepin::ABRecovery;
 using Appearance = com::deepin::daemon::Appearance;
 
-class QJsonArray;
-
 namespace dcc {
 namespace update {
 
@@ -44,36 +49,6 @@ struct CheckUpdateJobRet {
     QString jobDescription;
 };
 
-/**
- * @brief 更新日志中一个版本的信息
- *
- * 示例数据：
- * {
-        "id": 1,
-        "platformType": 1,
-        "cnLog": "<p>中文日志</p>",
-        "enLog": "<p>英文日志</p>",
-        "serverType": 0,
-        "systemVersion": "1070U1",
-        "createdAt": "2022-08-10T17:45:54+08:00",
-        "logType": 1,
-        "publishTime": "2022-08-06T00:00:00+08:00"
-    }
- */
-struct UpdateLogItem
-{
-    int id = -1;
-    int platformType = 1;
-    int serverType = 0;
-    int logType = 1;
-    QString systemVersion = "";
-    QString cnLog = "";
-    QString enLog = "";
-    QString publishTime = "";
-
-    bool isValid() const { return -1 != id; }
-};
-
 class UpdateWorker : public QObject
 {
     Q_OBJECT
@@ -118,7 +93,6 @@ public Q_SLOTS:
     void setSourceCheck(bool enable);
 #endif
     void testMirrorSpeed();
-    void checkNetselect();
     void setSmartMirror(bool enable);
 #ifndef DISABLE_SYS_UPDATE_MIRRORS
     void refreshMirrors();
@@ -156,9 +130,7 @@ private Q_SLOTS:
     void onSafeUpdateInstallProgressChanged(double value);
     void onUnkonwnUpdateInstallProgressChanged(double value);
     void checkTestingChannelStatus();
-    QStringList getSourcesOfPackage(const QString pkg, const QString version);
     QString getTestingChannelSource();
-    void handleUpdateLogsReply(QNetworkReply *reply);
     QString getUpdateLogAddress() const;
 
 private:
@@ -176,7 +148,8 @@ private:
 
     void setDownloadJob(const QString &jobPath, ClassifyUpdateType updateType);
     void setDistUpgradeJob(const QString &jobPath, ClassifyUpdateType updateType);
-    void setUpdateItemProgress(UpdateItemInfo *itemInfo, double value);
+    bool setUpdateItemProgress(UpdateItemInfo *itemInfo, double value);
+    bool onProgressChanged(int type, double value);
     bool hasBackedUp();
     void onRecoveryFinshed(bool successed);
 
@@ -194,7 +167,7 @@ private:
     void checkUpdatablePackages(const QMap<QString, QStringList> &updatablePackages);
     void requestUpdateLog();
     void updateItemInfo(const UpdateLogItem &logItem, UpdateItemInfo *itemInfo);
-    void setUpdateLogs(const QJsonArray &array);
+    void setUpdateLogs(const QList<UpdateLogItem> &logs);
     int isUnstableResource() const;
 
 private:
@@ -246,6 +219,12 @@ private:
     QMutex m_mutex;
     QMutex m_downloadMutex;
     QList<UpdateLogItem> m_updateLogs;
+
+    QSharedPointer<PackageSourceIndex> m_packageIndex;
+    QFutureWatcher<bool> *m_testingChannelCheckWatcher;
+    MirrorProber *m_mirrorProber;
+    UpdateLogCache *m_updateLogCache;
+    ProgressAggregator *m_progressAggregator;
 };
 
 }
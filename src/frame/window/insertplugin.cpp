@@ -3,16 +3,399 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "insertplugin.h"
+#include "tracer.h"
 
 #include <QGSettings>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
 
 #include <DStandardItem>
 
 const QString ModuleDirectory = "/usr/lib/dde-control-center/modules";
+const QString PluginMetaCacheFile = "plugin-meta.json";
+const int PluginMetaCacheVersion = 2;
+// 启动后空闲时再加载未使用的插件
+const int IdleLoadDelay = 5000;
 
 using namespace DCC_NAMESPACE;
 DWIDGET_USE_NAMESPACE
 
+namespace {
+// 插件预初始化时转发所有调用，同时记录添加的翻译，下次启动时不加载插件直接添加；
+// 可见性等运行时状态不记录，只能由加载后的插件设置
+class RecordingFrameProxy : public FrameProxyInterface
+{
+public:
+    explicit RecordingFrameProxy(FrameProxyInterface *frameProxy)
+        : m_frameProxy(frameProxy)
+    {
+    }
+
+    inline const QJsonArray &records() const { return m_records; }
+
+    void pushWidget(ModuleInterface *const inter, QWidget *const w, PushType type = Normal) override
+    {
+        m_frameProxy->pushWidget(inter, w, type);
+    }
+
+    void popWidget(ModuleInterface *const inter) override
+    {
+        m_frameProxy->popWidget(inter);
+    }
+
+    void setModuleVisible(ModuleInterface *const inter, const bool visible) override
+    {
+        m_frameProxy->setModuleVisible(inter, visible);
+    }
+
+    void showModulePage(const QString &module, const QString &page, bool animation) override
+    {
+        m_frameProxy->showModulePage(module, page, animation);
+    }
+
+    void setModuleSubscriptVisible(const QString &module, bool bIsDisplay) override
+    {
+        m_frameProxy->setModuleSubscriptVisible(module, bIsDisplay);
+    }
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_DEPRECATED
+    void setRemoveableDeviceStatus(QString type, bool state) override
+    {
+        m_frameProxy->setRemoveableDeviceStatus(type, state);
+    }
+
+    bool getRemoveableDeviceStatus(QString type) const override
+    {
+        return m_frameProxy->getRemoveableDeviceStatus(type);
+    }
+QT_WARNING_POP
+
+    void setSearchPath(ModuleInterface *const inter) const override
+    {
+        m_frameProxy->setSearchPath(inter);
+    }
+
+    void addChildPageTrans(const QString &menu, const QString &tran) override
+    {
+        m_records.append(QJsonArray { menu, tran });
+        m_frameProxy->addChildPageTrans(menu, tran);
+    }
+
+    void setModuleVisible(const QString &module, bool visible) override
+    {
+        m_frameProxy->setModuleVisible(module, visible);
+    }
+
+    void setWidgetVisible(const QString &module, const QString &widget, bool visible) override
+    {
+        m_frameProxy->setWidgetVisible(module, widget, visible);
+    }
+
+    void setDetailVisible(const QString &module, const QString &widget, const QString &detail, bool visible) override
+    {
+        m_frameProxy->setDetailVisible(module, widget, detail, visible);
+    }
+
+    void updateSearchData(const QString &module) override
+    {
+        m_frameProxy->updateSearchData(module);
+    }
+
+    QString moduleDisplayName(const QString &module) const override
+    {
+        return m_frameProxy->moduleDisplayName(module);
+    }
+
+private:
+    FrameProxyInterface *m_frameProxy;
+    QJsonArray m_records;
+};
+
+QString metaCachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + PluginMetaCacheFile;
+}
+}
+
+PluginProxy::PluginProxy(const QString &fileName, const QJsonObject &metaData, FrameProxyInterface *frameProxy, QObject *parent)
+    : QObject(parent)
+    , ModuleInterface(frameProxy)
+    , m_fileName(fileName)
+    , m_metaData(metaData)
+    , m_instance(nullptr)
+    , m_module(nullptr)
+    , m_loadFailed(false)
+    , m_preInitialized(false)
+    , m_initialized(false)
+    , m_pushType(FrameProxyInterface::PushType::Normal)
+{
+}
+
+ModuleInterface *PluginProxy::module()
+{
+    if (m_module || m_loadFailed)
+        return m_module;
+
+    DCC_TRACE_SCOPE("plugin", "load", m_fileName);
+    QElapsedTimer et;
+    et.start();
+    QPluginLoader loader(m_fileName);
+    QObject *instance = loader.instance();
+    if (!instance) {
+        qDebug() << loader.errorString();
+        // 加载失败时不再重试
+        m_loadFailed = true;
+        return nullptr;
+    }
+
+    auto *module = qobject_cast<ModuleInterface *>(instance);
+    if (!module) {
+        qDebug() << "plugin is not a module:" << m_fileName;
+        m_loadFailed = true;
+        return nullptr;
+    }
+
+    instance->setParent(this);
+    module->setFrameProxy(m_frameProxy);
+    m_instance = instance;
+    m_module = module;
+    qDebug() << "load plugin Name: " << module->name() << module->displayName();
+    qDebug() << "load this plugin using time: " << et.elapsed() << "ms";
+
+    // 已经通过缓存添加了翻译，加载后补充调用插件的预初始化和初始化，由插件设置可见性和搜索数据
+    if (m_preInitialized) {
+        m_module->preInitialize(false, m_pushType);
+        setAvailable(m_module->isAvailable());
+        setDeviceUnavailabel(m_module->deviceUnavailabel());
+        if (m_frameProxy && (!isAvailable() || deviceUnavailabel()))
+            m_frameProxy->setModuleVisible(this, false);
+    }
+    if (m_initialized)
+        m_module->initialize();
+
+    updateMetaData();
+    return m_module;
+}
+
+QObject *PluginProxy::instance()
+{
+    module();
+    return m_instance;
+}
+
+bool PluginProxy::hasActiveMethod() const
+{
+    if (m_instance)
+        return m_instance->metaObject()->indexOfMethod(QMetaObject::normalizedSignature("active()")) != -1;
+    return m_metaData.value("activeMethod").toBool();
+}
+
+void PluginProxy::activePlugin()
+{
+    // 点击二级菜单时才加载插件库，调用插件的 active 方法
+    QObject *inst = instance();
+    if (!inst)
+        return;
+
+    const int methodIndex = inst->metaObject()->indexOfMethod(QMetaObject::normalizedSignature("active()"));
+    if (methodIndex != -1)
+        inst->metaObject()->method(methodIndex).invoke(inst);
+}
+
+QJsonObject PluginProxy::metaData() const
+{
+    return m_metaData;
+}
+
+void PluginProxy::updateMetaData()
+{
+    QJsonObject metaData = m_metaData;
+    const QFileInfo info(m_fileName);
+    metaData.insert("mtime", double(info.lastModified().toMSecsSinceEpoch()));
+    metaData.insert("size", double(info.size()));
+    metaData.insert("name", m_module->name());
+    metaData.insert("displayName", m_module->displayName());
+    metaData.insert("icon", m_module->icon().name());
+    metaData.insert("translationPath", m_module->translationPath());
+    metaData.insert("path", m_module->path());
+    metaData.insert("follow", m_module->follow());
+    metaData.insert("enabled", m_module->enabled());
+    metaData.insert("availPage", QJsonArray::fromStringList(m_module->availPage()));
+    metaData.insert("activeMethod", hasActiveMethod());
+
+    // 插件图标不是主题图标时无法缓存，每次启动都需要加载插件
+    if (m_module->icon().name().isEmpty())
+        metaData.remove("name");
+
+    if (metaData != m_metaData) {
+        m_metaData = metaData;
+        Q_EMIT metaDataChanged();
+    }
+}
+
+void PluginProxy::recordPreInitialize(bool sync, FrameProxyInterface::PushType pushType)
+{
+    if (!m_frameProxy) {
+        m_module->preInitialize(sync, pushType);
+        return;
+    }
+
+    // 预初始化期间使用记录代理，结束后恢复，插件之后的调用直接发送到主窗口
+    RecordingFrameProxy recorder(m_frameProxy);
+    m_module->setFrameProxy(&recorder);
+    m_module->preInitialize(sync, pushType);
+    m_module->setFrameProxy(m_frameProxy);
+
+    setAvailable(m_module->isAvailable());
+    setDeviceUnavailabel(m_module->deviceUnavailabel());
+    m_metaData.insert("translations", recorder.records());
+    updateMetaData();
+}
+
+void PluginProxy::addCachedTranslations()
+{
+    if (!m_frameProxy)
+        return;
+
+    for (const QJsonValue &value : m_metaData.value("translations").toArray()) {
+        const QJsonArray record = value.toArray();
+        m_frameProxy->addChildPageTrans(record.at(0).toString(), record.at(1).toString());
+    }
+}
+
+void PluginProxy::preInitialize(bool sync, FrameProxyInterface::PushType pushType)
+{
+    // 缓存中有翻译时只添加翻译，不加载插件；可见性和搜索数据在插件加载后由插件自己设置
+    if (!m_module && m_metaData.contains("translations")) {
+        m_preInitialized = true;
+        m_pushType = pushType;
+        addCachedTranslations();
+        return;
+    }
+
+    if (!module())
+        return;
+
+    if (m_metaData.contains("translations")) {
+        m_module->preInitialize(sync, pushType);
+        setAvailable(m_module->isAvailable());
+        setDeviceUnavailabel(m_module->deviceUnavailabel());
+    } else {
+        recordPreInitialize(sync, pushType);
+    }
+}
+
+void PluginProxy::initialize()
+{
+    // 未加载时在加载后补充调用
+    if (!m_module) {
+        m_initialized = true;
+        return;
+    }
+
+    m_module->initialize();
+}
+
+void PluginProxy::reset()
+{
+    if (ModuleInterface *m = module())
+        m->reset();
+}
+
+const QString PluginProxy::name() const
+{
+    return m_module ? m_module->name() : m_metaData.value("name").toString();
+}
+
+const QString PluginProxy::displayName() const
+{
+    return m_module ? m_module->displayName() : m_metaData.value("displayName").toString();
+}
+
+QIcon PluginProxy::icon() const
+{
+    return m_module ? m_module->icon() : QIcon::fromTheme(m_metaData.value("icon").toString());
+}
+
+QString PluginProxy::translationPath() const
+{
+    return m_module ? m_module->translationPath() : m_metaData.value("translationPath").toString();
+}
+
+void PluginProxy::showPage(const QString &pageName)
+{
+    if (ModuleInterface *m = module())
+        m->showPage(pageName);
+}
+
+QWidget *PluginProxy::moduleWidget()
+{
+    ModuleInterface *m = module();
+    return m ? m->moduleWidget() : nullptr;
+}
+
+void PluginProxy::contentPopped(QWidget *const w)
+{
+    if (ModuleInterface *m = module())
+        m->contentPopped(w);
+}
+
+void PluginProxy::active()
+{
+    if (ModuleInterface *m = module())
+        m->active();
+}
+
+void PluginProxy::deactive()
+{
+    // 未加载的插件不需要销毁
+    if (m_module)
+        m_module->deactive();
+}
+
+int PluginProxy::load(const QString &path)
+{
+    ModuleInterface *m = module();
+    return m ? m->load(path) : -1;
+}
+
+QStringList PluginProxy::availPage() const
+{
+    if (m_module)
+        return m_module->availPage();
+
+    QStringList pages;
+    for (const QJsonValue &page : m_metaData.value("availPage").toArray())
+        pages << page.toString();
+    return pages;
+}
+
+QString PluginProxy::path() const
+{
+    return m_module ? m_module->path() : m_metaData.value("path").toString();
+}
+
+QString PluginProxy::follow() const
+{
+    return m_module ? m_module->follow() : m_metaData.value("follow").toString();
+}
+
+bool PluginProxy::enabled() const
+{
+    return m_module ? m_module->enabled() : m_metaData.value("enabled").toBool(true);
+}
+
+void PluginProxy::addChildPageTrans() const
+{
+    // 未加载时翻译已经在预初始化时从缓存中添加
+    if (m_module)
+        m_module->addChildPageTrans();
+}
+
 QPointer<InsertPlugin> InsertPlugin::INSTANCE = nullptr;
 
 InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
@@ -24,6 +407,8 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         return;
     }
 
+    loadMetaCache();
+
     auto moduleList = moduleDir.entryInfoList();
     for (auto i : moduleList)
     {
@@ -32,47 +417,107 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         if (!QLibrary::isLibrary(path))
             continue;
 
-        qDebug() << "loading module: " << i;
-
-        QElapsedTimer et;
-        et.start();
-        QPluginLoader loader(path);
-        const QJsonObject &meta = loader.metaData().value("MetaData").toObject();
-        if (!compareVersion(meta.value("api").toString(), "1.0.0"))
+        PluginProxy *proxy = nullptr;
+        // 插件文件的大小和修改时间未变化时直接使用缓存，不加载插件库
+        const QJsonObject &cache = m_metaCache.value(path).toObject();
+        if (!cache.value("name").toString().isEmpty()
+                && cache.value("size").toDouble() == double(i.size())
+                && cache.value("mtime").toDouble() == double(i.lastModified().toMSecsSinceEpoch()))
         {
-            qDebug() << "plugin's version is too low";
-            continue;
+            proxy = new PluginProxy(path, cache, frameProxy, obj);
         }
-
-        QObject *instance = loader.instance();
-        if (!instance)
+        else
         {
-            qDebug() << loader.errorString();
-            continue;
-        }
+            qDebug() << "loading module: " << i;
 
-        instance->setParent(obj);
+            QPluginLoader loader(path);
+            const QJsonObject &meta = loader.metaData().value("MetaData").toObject();
+            if (!compareVersion(meta.value("api").toString(), "1.0.0"))
+            {
+                qDebug() << "plugin's version is too low";
+                continue;
+            }
 
-        auto *module = qobject_cast<ModuleInterface *>(instance);
-        if (!module)
-        {
-            return;
+            proxy = new PluginProxy(path, QJsonObject(), frameProxy, obj);
+            if (!proxy->module())
+            {
+                delete proxy;
+                continue;
+            }
         }
-        qDebug() << "load plugin Name: " << module->name() << module->displayName();
-        qDebug() << "load this plugin using time: " << et.elapsed() << "ms";
-        module->setFrameProxy(frameProxy);
 
-        if (module->follow() != MAINWINDOW && frameProxy)
+        connect(proxy, &PluginProxy::metaDataChanged, this, &InsertPlugin::saveMetaCache);
+
+        if (proxy->follow() != MAINWINDOW && frameProxy)
         {
-            frameProxy->setSearchPath(module);
+            frameProxy->setSearchPath(proxy);
         }
 
         Plugin plugin;
-        plugin.path = module->path();
-        plugin.follow = module->follow();
-        plugin.enabled = module->enabled();
+        plugin.path = proxy->path();
+        plugin.follow = proxy->follow();
+        plugin.enabled = proxy->enabled();
 
-        m_allModules.push_back({plugin, {instance, module->name()}});
+        m_allModules.push_back({plugin, {proxy, proxy->name()}});
+    }
+
+    // 更新缓存，同时去掉已经卸载的插件
+    saveMetaCache();
+    QTimer::singleShot(IdleLoadDelay, this, &InsertPlugin::loadIdlePlugin);
+}
+
+void InsertPlugin::loadMetaCache()
+{
+    QFile file(metaCachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonObject &cache = QJsonDocument::fromJson(file.readAll()).object();
+    if (cache.value("version").toInt() != PluginMetaCacheVersion)
+        return;
+
+    m_metaCache = cache.value("plugins").toObject();
+}
+
+void InsertPlugin::saveMetaCache()
+{
+    QJsonObject plugins;
+    for (const auto &module : m_allModules)
+    {
+        auto *proxy = qobject_cast<PluginProxy *>(module.second.first);
+        const QJsonObject &metaData = proxy->metaData();
+        if (!metaData.value("name").toString().isEmpty())
+            plugins.insert(proxy->fileName(), metaData);
+    }
+
+    if (plugins == m_metaCache)
+        return;
+    m_metaCache = plugins;
+
+    QDir().mkpath(QFileInfo(metaCachePath()).absolutePath());
+    QSaveFile file(metaCachePath());
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QJsonObject cache;
+    cache.insert("version", PluginMetaCacheVersion);
+    cache.insert("plugins", plugins);
+    file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void InsertPlugin::loadIdlePlugin()
+{
+    // 每次只加载一个插件，避免长时间阻塞界面
+    for (const auto &module : m_allModules)
+    {
+        auto *proxy = qobject_cast<PluginProxy *>(module.second.first);
+        if (!proxy->isLoaded() && module.first.enabled)
+        {
+            proxy->module();
+            QTimer::singleShot(0, this, &InsertPlugin::loadIdlePlugin);
+            return;
+        }
     }
 }
 
@@ -124,6 +569,17 @@ ModuleInterface *InsertPlugin::pluginInterface(const QString &displayName)
     return nullptr;
 }
 
+ModuleInterface *InsertPlugin::pluginProxy(ModuleInterface *module) const
+{
+    for (const auto &plugin : m_allModules)
+    {
+        auto *proxy = qobject_cast<PluginProxy *>(plugin.second.first);
+        if (proxy->isLoaded() && proxy->module() == module)
+            return proxy;
+    }
+    return module;
+}
+
 /**
  * @brief dccV20::InsertPlugin::pushPlugin 加载一级菜单插件
  * @param modules 一级菜单所有模块，将插件添加到其中
@@ -185,20 +641,20 @@ void dccV20::InsertPlugin::pushPlugin(QStandardItemModel *Model, QList<dccV20::L
 {
     for (int i = 0; i < m_currentPlugins.size(); i++)
     {
-        QByteArray normalizedSignature = QMetaObject::normalizedSignature("active()");
-        int methodIndex = m_currentPlugins.at(i).second.first->metaObject()->indexOfMethod(normalizedSignature);
+        // 查看插件是否定义为可用
+        if (!m_currentPlugins.at(i).first.enabled)
+            continue;
+
+        // 二级菜单的名称和图标从缓存中读取，点击菜单调用插件的active方法时才加载插件库
+        auto *proxy = qobject_cast<PluginProxy *>(m_currentPlugins.at(i).second.first);
         // 找不到对应激活的方法
-        if (methodIndex == -1)
+        if (!proxy->hasActiveMethod())
         {
             continue;
         }
 
-        // 查看插件是否定义为可用
-        if (!m_currentPlugins.at(i).first.enabled)
-            continue;
-
-        auto *module = qobject_cast<ModuleInterface *>(m_currentPlugins.at(i).second.first);
-        // 调用模块初始化函数
+        auto *module = static_cast<ModuleInterface *>(proxy);
+        // 调用模块初始化函数，未加载时在加载后调用
         module->preInitialize(false);
         module->initialize();
 
@@ -206,8 +662,9 @@ void dccV20::InsertPlugin::pushPlugin(QStandardItemModel *Model, QList<dccV20::L
         item->setIcon(module->icon());
         item->setText(module->displayName());
 
-        // active方法
-        QMetaMethod metaMethod = m_currentPlugins.at(i).second.first->metaObject()->method(methodIndex);
+        // active方法，通过代理转发给插件
+        QObject *instance = proxy;
+        QMetaMethod metaMethod = proxy->metaObject()->method(proxy->metaObject()->indexOfMethod("activePlugin()"));
 
         bool ok;
         int index = m_currentPlugins.at(i).first.follow.toInt(&ok);
@@ -218,13 +675,13 @@ void dccV20::InsertPlugin::pushPlugin(QStandardItemModel *Model, QList<dccV20::L
             if (index > Model->rowCount())
             {
                 itemList.append({module->name(), module->displayName(),
-                                 metaMethod, m_currentPlugins.at(i).second.first});
+                                 metaMethod, instance});
                 Model->appendRow(item);
             }
             else
             {
                 itemList.insert(index - 1, {module->name(), module->displayName(),
-                                            metaMethod, m_currentPlugins.at(i).second.first});
+                                            metaMethod, instance});
                 Model->insertRow(index - 1, item);
             }
         }
@@ -236,7 +693,7 @@ void dccV20::InsertPlugin::pushPlugin(QStandardItemModel *Model, QList<dccV20::L
                 if (Model->item(k)->text() == m_currentPlugins.at(i).first.follow)
                 {
                     itemList.insert(k + 1, {module->name(), module->displayName(),
-                                            metaMethod, m_currentPlugins.at(i).second.first});
+                                            metaMethod, instance});
                     Model->insertRow(k + 1, item);
                     isLoad = true;
                     break;
@@ -245,7 +702,7 @@ void dccV20::InsertPlugin::pushPlugin(QStandardItemModel *Model, QList<dccV20::L
             if (!isLoad)
             {
                 itemList.append({module->name(), module->displayName(),
-                                 metaMethod, m_currentPlugins.at(i).second.first});
+                                 metaMethod, instance});
                 Model->appendRow(item);
             }
         }
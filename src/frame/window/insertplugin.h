@@ -24,6 +24,71 @@ namespace DCC_NAMESPACE
         bool enabled;   // 插件是否处于可用状态
     };
 
+    /**
+     * @brief The PluginProxy class
+     * 插件的代理，名称、图标、插入位置及预初始化时添加的翻译从缓存中读取，
+     * 只有在第一次进入插件页面或空闲时才加载插件库，其他调用转发给实际的插件；
+     * 可见性和搜索数据是运行时状态，不缓存，由插件加载后自己设置
+     */
+    class PluginProxy : public QObject, public ModuleInterface
+    {
+        Q_OBJECT
+        Q_INTERFACES(DCC_NAMESPACE::ModuleInterface)
+    public:
+        PluginProxy(const QString &fileName, const QJsonObject &metaData, FrameProxyInterface *frameProxy, QObject *parent = nullptr);
+
+        // 加载插件库，失败时返回nullptr
+        ModuleInterface *module();
+        QObject *instance();
+        inline bool isLoaded() const { return m_module != nullptr; }
+        inline const QString &fileName() const { return m_fileName; }
+        // 插件的缓存数据，包括预初始化时记录的翻译
+        QJsonObject metaData() const;
+        // 插件是否有active方法，未加载时从缓存中读取
+        bool hasActiveMethod() const;
+
+        void preInitialize(bool sync = false, FrameProxyInterface::PushType pushType = FrameProxyInterface::PushType::Normal) override;
+        void initialize() override;
+        void reset() override;
+        const QString name() const override;
+        const QString displayName() const override;
+        QIcon icon() const override;
+        QString translationPath() const override;
+        void showPage(const QString &pageName) override;
+        QWidget *moduleWidget() override;
+        void contentPopped(QWidget *const w) override;
+        void active() override;
+        void deactive() override;
+        int load(const QString &path) override;
+        QStringList availPage() const override;
+        QString path() const override;
+        QString follow() const override;
+        bool enabled() const override;
+        void addChildPageTrans() const override;
+
+    public Q_SLOTS:
+        // 加载插件并调用插件的active方法，二级菜单插件使用
+        void activePlugin();
+
+    Q_SIGNALS:
+        void metaDataChanged();
+
+    private:
+        void updateMetaData();
+        void recordPreInitialize(bool sync, FrameProxyInterface::PushType pushType);
+        void addCachedTranslations();
+
+    private:
+        QString m_fileName;
+        QJsonObject m_metaData;
+        QObject *m_instance;
+        ModuleInterface *m_module;
+        bool m_loadFailed;
+        bool m_preInitialized;
+        bool m_initialized;
+        FrameProxyInterface::PushType m_pushType;
+    };
+
     class InsertPlugin : public QObject
     {
         Q_OBJECT
@@ -43,9 +108,18 @@ namespace DCC_NAMESPACE
         void preInitialize(QString moduleName);
         // 获取对应displayName的插件对象
         ModuleInterface *pluginInterface(const QString &displayName);
+        // 插件自己调用FrameProxyInterface时传入的是实际的插件对象，转换为对应的代理
+        ModuleInterface *pluginProxy(ModuleInterface *module) const;
+
+    private:
+        void loadMetaCache();
+        void saveMetaCache();
+        void loadIdlePlugin();
 
     private:
         static QPointer<InsertPlugin> INSTANCE;
+        // 插件缓存，key为插件路径
+        QJsonObject m_metaCache;
         // 保存加载的所有插件
         QList<QPair<Plugin, QPair<QObject *, QString>>> m_allModules;
         // 保存插入到某个模块的所有插件
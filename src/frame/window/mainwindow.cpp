@@ -29,6 +29,9 @@
 #include "widgets/multiselectlistview.h"
 #include "mainwindow.h"
 #include "insertplugin.h"
+#include "moduleinitscheduler.h"
+#include "tracer.h"
+#include "interface/modulepagecacheinterface.h"
 #include "constant.h"
 #include "search/searchwidget.h"
 #include "dtitlebar.h"
@@ -69,6 +72,14 @@ const QString GSettinsWindowHeight = "window-height";
 const QString ModuleDirectory = "/usr/lib/dde-control-center/modules";
 const QString ControlCenterIconPath = "/usr/share/icons/bloom/apps/64/preferences-system.svg";
 const QString ControlCenterGroupName = "com.deepin.dde-grand-search.group.dde-control-center-setting";
+// 全局搜索每次最多返回的结果数量
+const int MaxGrandSearchResults = 100;
+// 页面缓存最多保存的模块数量及控件数量，控件数量用于近似限制缓存占用的内存，不是字节数
+const int PageCacheCapacity = 4;
+const int PageCacheMaxWidgets = 3000;
+// 启动后空闲时预热的模块数量
+const int MaxPrewarmCount = 2;
+const int PrewarmDelay = 3000;
 
 const int WidgetMinimumWidth = 820;
 const int WidgetMinimumHeight = 634;
@@ -103,7 +114,10 @@ MainWindow::MainWindow(QWidget *parent)
     , m_backwardBtn(nullptr)
     , m_lastSize(WidgetMinimumWidth, WidgetMinimumHeight)
     , m_primaryScreen(nullptr)
+    , m_pageCache(PageCacheCapacity, PageCacheMaxWidgets)
 {
+    DCC_TRACE_SCOPE("startup", "MainWindow");
+
     //Initialize view and layout structure
     DMainWindow::installEventFilter(this);
 
@@ -161,6 +175,7 @@ MainWindow::MainWindow(QWidget *parent)
     titlebar->setAccessibleName("Mainwindow bar");
     titlebar->addWidget(m_searchWidget, Qt::AlignCenter);
     connect(m_searchWidget, &SearchWidget::notifyModuleSearch, this, &MainWindow::onEnterSearchWidget);
+    connect(m_searchWidget, &SearchWidget::searchDataLoaded, this, &MainWindow::searchDataLoaded);
 
     auto menu = titlebar->menu();
     if (!menu) {
@@ -194,7 +209,8 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_backwardBtn, &DIconButton::clicked, this, [this] {
         //说明：只有"update"模块/"镜像源列表"页面需要从第三级页面返回第二级页面(若其他模块还有需求可以在此处添加处理)
         if (!m_contentStack.isEmpty() && m_contentStack.last().first->name() != "update") {
-            popAllWidgets();
+            if (!parkCurrentPage())
+                popAllWidgets();
         } else {
             popWidget();
         }
@@ -312,6 +328,7 @@ void MainWindow::initAllModule(const QString &m)
         return;
 
     m_bInit = true;
+    DCC_TRACE_SCOPE("startup", "initAllModule", m);
 #ifndef DISABLE_AUTHENTICATION
     using namespace authentication;
 #endif
@@ -426,6 +443,8 @@ void MainWindow::initAllModule(const QString &m)
     //after initAllModule to load ts data
     m_searchWidget->setLanguage(QLocale::system().name());
     qDebug() << QString("load search info with %1ms").arg(et.elapsed());
+
+    QTimer::singleShot(PrewarmDelay, this, &MainWindow::prewarmPage);
 }
 
 void MainWindow::updateWinsize(QRect rect)
@@ -479,18 +498,21 @@ void MainWindow::updateModuleVisible()
 
 void MainWindow::modulePreInitialize(const QString &m)
 {
+    QList<ModuleInterface *> modules;
     for (auto it = m_modules.cbegin(); it != m_modules.cend(); ++it) {
-        QElapsedTimer et;
-        et.start();
-        it->first->preInitialize(m == it->first->name());
-        qDebug() << QString("initialize %1 module using time: %2ms")
-                 .arg(it->first->name())
-                 .arg(et.elapsed());
-        if (it->first->isAvailable()) {
+        modules << it->first;
+    }
+
+    //D-Bus服务激活和prefetch在线程池中并行执行，preInitialize按依赖顺序在主线程中执行
+    ModuleInitScheduler scheduler(modules);
+    scheduler.run([&m](ModuleInterface *module) {
+        DCC_TRACE_SCOPE("module", "preInitialize", module->name());
+        module->preInitialize(m == module->name());
+        if (module->isAvailable()) {
             // 模块有效时先初始化模块和搜索数据
-            InsertPlugin::instance()->preInitialize(it->first->name());
+            InsertPlugin::instance()->preInitialize(module->name());
         }
-    }
+    });
 }
 
 void MainWindow::popWidget()
@@ -538,9 +560,128 @@ void MainWindow::popAllWidgets(int place)
     }
 }
 
-void MainWindow::popWidget(ModuleInterface *const inter)
+bool MainWindow::parkCurrentPage()
 {
-    Q_UNUSED(inter)
+    if (m_contentStack.isEmpty() || m_topWidget || m_lastThirdPage.second)
+        return false;
+
+    ModuleInterface *inter = m_contentStack.first().first;
+    auto *pageCache = dynamic_cast<ModulePageCacheInterface *>(inter);
+    if (!pageCache || !pageCache->isPageCacheable())
+        return false;
+
+    // 插件插入的页面由插件管理，不缓存
+    for (const auto &page : m_contentStack) {
+        if (page.first != inter)
+            return false;
+    }
+
+    DCC_TRACE_SCOPE("page", "park", inter->name());
+    PageCache::PageStack pages;
+    while (!m_contentStack.isEmpty()) {
+        QWidget *w = m_contentStack.pop().second;
+        m_rightContentLayout->removeWidget(w);
+        w->hide();
+        pages.prepend({ inter, w });
+    }
+
+    inter->deactive();
+    destroyPages(m_pageCache.insert(inter, pages));
+    setCurrModule(nullptr);
+    return true;
+}
+
+bool MainWindow::restorePage(ModuleInterface *const inter)
+{
+    const PageCache::PageStack pages = m_pageCache.take(inter);
+    if (pages.isEmpty())
+        return false;
+
+    DCC_TRACE_SCOPE("page", "restore", inter->name());
+    // 页面在缓存期间被销毁或已过期时重新创建
+    bool valid = dynamic_cast<ModulePageCacheInterface *>(inter)->restore();
+    for (const auto &page : pages)
+        valid = valid && page.second;
+    if (!valid) {
+        destroyPages({ pages });
+        return false;
+    }
+
+    for (const auto &page : pages) {
+        m_contentStack.push({ page.first, page.second });
+        m_rightContentLayout->addWidget(page.second, m_contentStack.size() == 1 ? 3 : 7);
+        page.second->show();
+    }
+
+    if (m_contentStack.size() == 2) {
+        m_contentStack.at(0).second->setMinimumWidth(second_widget_min_width);
+        m_contentStack.at(1).second->setMinimumWidth(third_widget_min_width);
+    }
+
+    m_lastPushWidget = m_contentStack.top().second;
+    resetNavList(m_contentStack.empty());
+    resetTabOrder();
+    return true;
+}
+
+void MainWindow::destroyPages(const QList<PageCache::PageStack> &pagesList)
+{
+    for (const PageCache::PageStack &pages : pagesList) {
+        for (const auto &page : pages) {
+            if (page.second)
+                page.second->deleteLater();
+        }
+    }
+}
+
+void MainWindow::prewarmPage()
+{
+    for (const QString &name : m_pageCache.mostUsed(MaxPrewarmCount)) {
+        auto it = std::find_if(m_modules.cbegin(), m_modules.cend(), [&name](const QPair<ModuleInterface *, QString> &module) {
+            return module.first->name() == name;
+        });
+        if (it == m_modules.cend() || m_navView->isRowHidden(int(it - m_modules.cbegin())))
+            continue;
+
+        ModuleInterface *inter = it->first;
+        auto *pageCache = dynamic_cast<ModulePageCacheInterface *>(inter);
+        if (!pageCache || !pageCache->isPageCacheable() || m_pageCache.contains(inter) || m_prewarmList.contains(inter)
+                || (!m_contentStack.isEmpty() && m_contentStack.first().first == inter))
+            continue;
+
+        DCC_TRACE_SCOPE("page", "prewarm", name);
+        m_prewarmList << inter;
+        if (!m_initList.contains(inter)) {
+            inter->initialize();
+            m_initList << inter;
+        }
+
+        m_prewarmModule = inter;
+        m_prewarmFailed = false;
+        inter->active();
+        m_prewarmModule = nullptr;
+        inter->deactive();
+
+        PageCache::PageStack pages;
+        pages.swap(m_prewarmPages);
+        if (m_prewarmFailed || pages.isEmpty())
+            destroyPages({ pages });
+        else
+            destroyPages(m_pageCache.insert(inter, pages));
+
+        // 每次只预热一个模块，避免长时间阻塞界面
+        QTimer::singleShot(0, this, &MainWindow::prewarmPage);
+        return;
+    }
+}
+
+void MainWindow::popWidget(ModuleInterface *const module)
+{
+    // 插件传入的是实际的插件对象，缓存中保存的是插件代理
+    ModuleInterface *const inter = InsertPlugin::instance()->pluginProxy(module);
+    // 已缓存或正在预热的模块不能操作当前显示的页面
+    if (m_pageCache.contains(inter) || (inter && inter == m_prewarmModule))
+        return;
 
     popWidget();
     resetNavList(m_contentStack.isEmpty());
@@ -959,8 +1100,10 @@ void MainWindow::changeEvent(QEvent *event)
     return DMainWindow::changeEvent(event);
 }
 
-void MainWindow::setModuleVisible(ModuleInterface *const inter, const bool visible)
+void MainWindow::setModuleVisible(ModuleInterface *const module, const bool visible)
 {
+    // 插件传入的是实际的插件对象，m_modules中保存的是插件代理
+    ModuleInterface *const inter = InsertPlugin::instance()->pluginProxy(module);
     auto find_it = std::find_if(m_modules.cbegin(),
                                 m_modules.cend(),
     [ inter ](const QPair<ModuleInterface *, QString> &pair) {
@@ -979,18 +1122,19 @@ void MainWindow::setModuleVisible(ModuleInterface *const inter, const bool visib
     Q_EMIT moduleVisibleChanged(find_it->first->name(), bFinalVisible);
 
     qDebug() << "[SearchWidget] find_it->first->name() : " << find_it->first->name() << bFinalVisible;
+    if (!bFinalVisible)
+        destroyPages({ m_pageCache.take(inter) });
     if (!bFinalVisible && m_contentStack.count() > 0  && m_contentStack.at(0).first->name() == inter->name()) {
         popAllWidgets();
         resetNavList(m_contentStack.empty());
     }
 
-    updateSearchData(find_it->second);
-
     if (!m_searchWidget) {
         return;
     }
 
     m_searchWidget->setModuleVisible(find_it->second, bFinalVisible);
+    updateSearchData(find_it->second);
 }
 
 void MainWindow::setModuleVisible(const QString &module, bool visible)
@@ -1014,18 +1158,19 @@ void MainWindow::setModuleVisible(const QString &module, bool visible)
     Q_EMIT moduleVisibleChanged(find_it->first->name(), bFinalVisible);
 
     qDebug() << "[SearchWidget] find_it->first->name() : " << find_it->first->name() << bFinalVisible;
+    if (!bFinalVisible)
+        destroyPages({ m_pageCache.take(inter) });
     if (!bFinalVisible && m_contentStack.count() > 0  && m_contentStack.at(0).first->name() == inter->name()) {
         popAllWidgets();
         resetNavList(m_contentStack.empty());
     }
 
-    updateSearchData(find_it->second);
-
     if (!m_searchWidget) {
         return;
     }
 
     m_searchWidget->setModuleVisible(module, bFinalVisible);
+    updateSearchData(find_it->second);
 }
 
 void MainWindow::setWidgetVisible(const QString &module, const QString &widget, bool visible)
@@ -1055,8 +1200,9 @@ void MainWindow::updateSearchData(const QString &module)
     m_searchWidget->updateSearchdata(module);
 }
 
-void MainWindow::pushWidget(ModuleInterface *const inter, QWidget *const w, PushType type)
+void MainWindow::pushWidget(ModuleInterface *const module, QWidget *const w, PushType type)
 {
+    ModuleInterface *const inter = InsertPlugin::instance()->pluginProxy(module);
     if (!inter)  {
         qDebug() << Q_FUNC_INFO << " inter is nullptr";
         return;
@@ -1067,6 +1213,19 @@ void MainWindow::pushWidget(ModuleInterface *const inter, QWidget *const w, Push
         return;
     }
 
+    // 预热时页面只放入缓存，不显示，只支持普通的二级和三级页面
+    if (inter == m_prewarmModule) {
+        if (type != Normal)
+            m_prewarmFailed = true;
+        while (m_prewarmPages.size() > 1)
+            destroyPages({ PageCache::PageStack { m_prewarmPages.takeLast() } });
+        w->hide();
+        w->setParent(m_rightView);
+        m_prewarmPages.append({ inter, w });
+        return;
+    }
+
+    DCC_TRACE_SCOPE("page", "pushWidget", inter->name());
     m_lastPushWidget = w;
     switch (type) {
     case Replace:
@@ -1247,14 +1406,24 @@ void MainWindow::onFirstItemClick(const QModelIndex &index)
     }
 
     m_navView->setFocus();
-    popAllWidgets();
+    if (!parkCurrentPage())
+        popAllWidgets();
 
     if (!m_initList.contains(inter)) {
+        DCC_TRACE_SCOPE("module", "initialize", inter->name());
         inter->initialize();
         m_initList << inter;
     }
     m_moduleName = inter->name();
     setCurrModule(inter);
+    m_pageCache.addVisit(inter->name());
+    // 缓存中有页面时直接恢复，不重新创建
+    if (restorePage(inter)) {
+        m_navView->resetStatus(index);
+        return;
+    }
+
+    DCC_TRACE_SCOPE("module", "active", inter->name());
     inter->active();
     m_navView->resetStatus(index);
 }
@@ -1347,14 +1516,9 @@ QString MainWindow::GrandSearchSearch(const QString json)
     QJsonDocument jsonDocument = QJsonDocument::fromJson(json.toLocal8Bit().data());
     if(!jsonDocument.isNull()) {
         QJsonObject jsonObject = jsonDocument.object();
-        m_lstGrandSearchTasks.append(jsonObject);
 
         //处理搜索任务, 返回搜索结果
-        QList<QString> lstMsg = m_searchWidget->searchResults(jsonObject.value("cont").toString());
-
-        for(auto msg : lstMsg) {
-            qDebug() << "name:" << msg;
-        }
+        QList<QString> lstMsg = m_searchWidget->searchResults(jsonObject.value("cont").toString(), MaxGrandSearchResults);
 
         QJsonObject jsonResults;
         QJsonArray items;
@@ -1381,7 +1545,6 @@ QString MainWindow::GrandSearchSearch(const QString json)
 
         QJsonDocument document;
         document.setObject(jsonResults);
-        m_lstGrandSearchTasks.removeOne(jsonObject);
 
         return document.toJson(QJsonDocument::Compact);
    }
@@ -1395,6 +1558,11 @@ bool MainWindow::GrandSearchStop(const QString json)
     return true;
 }
 
+bool MainWindow::isSearchDataLoaded() const
+{
+    return m_searchWidget && m_searchWidget->isSearchDataLoaded();
+}
+
 bool MainWindow::GrandSearchAction(const QString json)
 {
     QString searchName;
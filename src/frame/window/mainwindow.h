@@ -6,6 +6,7 @@
 #define MAINWINDOW_H
 
 #include "interface/frameproxyinterface.h"
+#include "pagecache.h"
 
 #include <DMainWindow>
 #include <DBackgroundGroup>
@@ -87,6 +88,7 @@ public:
     QString GrandSearchSearch(const QString json);
     bool GrandSearchStop(const QString json);
     bool GrandSearchAction(const QString json);
+    bool isSearchDataLoaded() const;
 
 public:
     bool isModuleAvailable(const QString &m);
@@ -102,6 +104,7 @@ public:
 Q_SIGNALS:
     void moduleVisibleChanged(const QString &module, bool visible);
     void mainwindowStateChange(int type);
+    void searchDataLoaded();
 
 private:
     void changeEvent(QEvent *event) override;
@@ -135,6 +138,10 @@ private:
     void judgeTopWidgetPlace(ModuleInterface *const inter, QWidget *const w);
     void updateViewBackground();
     void updateModuleVisible();
+    bool parkCurrentPage();     //将当前模块的页面隐藏后放入缓存
+    bool restorePage(ModuleInterface *const inter);
+    void destroyPages(const QList<PageCache::PageStack> &pagesList);
+    void prewarmPage();         //空闲时预先创建最常用模块的页面
 
 private:
     bool m_bInit{false};
@@ -170,10 +177,12 @@ private:
     QSize m_lastSize;
     bool m_needRememberLastSize = true;     //用于判断是否需要上次resize的窗口大小
     QPair<QListView::ViewMode, QModelIndex> m_currentIndex;
-
-    //全局搜索
-    QList<QJsonObject> m_lstGrandSearchTasks;
     QPointer<QScreen> m_primaryScreen;
+    PageCache m_pageCache;
+    ModuleInterface *m_prewarmModule{nullptr};  //正在预热页面的模块，push的页面直接放入缓存
+    PageCache::PageStack m_prewarmPages;
+    bool m_prewarmFailed{false};
+    QList<ModuleInterface *> m_prewarmList;     //已经预热过的模块，每个模块只预热一次
 };
 }
 
@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "moduleinitscheduler.h"
+#include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
+#include "tracer.h"
+#include "modules/dbuspropertybinder.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+using namespace DCC_NAMESPACE;
+
+namespace {
+// 激活 D-Bus 服务的超时时间，超时后由模块自己在 preInitialize 中处理
+const int ActivateServiceTimeout = 3000;
+
+void activateServices(QDBusConnection connection, const QStringList &services)
+{
+    for (const QString &service : services) {
+        DCC_TRACE_SCOPE("dbus", "StartServiceByName", service);
+        QDBusMessage message = QDBusMessage::createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                              "org.freedesktop.DBus", "StartServiceByName");
+        message << service << quint32(0);
+        const QDBusMessage reply = connection.call(message, QDBus::Block, ActivateServiceTimeout);
+        if (reply.type() == QDBusMessage::ErrorMessage)
+            qDebug() << "activate service" << service << "failed:" << reply.errorMessage();
+    }
+}
+}
+
+ModuleInitScheduler::ModuleInitScheduler(const QList<ModuleInterface *> &modules)
+{
+    // prefetch 大多是阻塞的 D-Bus 调用，线程数不受 CPU 核数限制
+    m_threadPool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 4));
+
+    m_nodes.reserve(modules.size());
+    for (ModuleInterface *module : modules) {
+        Node node;
+        node.module = module;
+        node.prefetch = dynamic_cast<ModulePrefetchInterface *>(module);
+        node.prefetchTime = 0;
+        node.preInitTime = 0;
+        node.finishTime = 0;
+        node.criticalParent = -1;
+        node.done = false;
+        m_nodes << node;
+    }
+
+    for (Node &node : m_nodes) {
+        if (!node.prefetch)
+            continue;
+
+        for (const QString &name : node.prefetch->preInitializeAfter()) {
+            auto it = std::find_if(m_nodes.cbegin(), m_nodes.cend(), [&name](const Node &n) {
+                return n.module->name() == name;
+            });
+            if (it == m_nodes.cend() || it->module == node.module) {
+                qDebug() << node.module->name() << "ignore unknown dependency:" << name;
+                continue;
+            }
+            node.dependencies << int(it - m_nodes.cbegin());
+        }
+    }
+}
+
+ModuleInitScheduler::~ModuleInitScheduler()
+{
+    m_threadPool.waitForDone();
+}
+
+void ModuleInitScheduler::startPrefetch(Node &node)
+{
+    ModulePrefetchInterface *prefetch = node.prefetch;
+    const QStringList sessionServices = prefetch->sessionServices();
+    const QStringList systemServices = prefetch->systemServices();
+
+    const QString name = node.module->name();
+    node.future = QtConcurrent::run(&m_threadPool, [prefetch, sessionServices, systemServices, name] {
+        DCC_TRACE_SCOPE("module", "prefetch", name);
+        QElapsedTimer et;
+        et.start();
+        activateServices(QDBusConnection::sessionBus(), sessionServices);
+        activateServices(QDBusConnection::systemBus(), systemServices);
+        prefetch->prefetch();
+        return et.elapsed();
+    });
+}
+
+bool ModuleInitScheduler::dependenciesDone(const Node &node) const
+{
+    for (int dependency : node.dependencies) {
+        if (!m_nodes.at(dependency).done)
+            return false;
+    }
+    return true;
+}
+
+int ModuleInitScheduler::nextNode() const
+{
+    int ready = -1;
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        const Node &node = m_nodes.at(i);
+        if (node.done || !dependenciesDone(node))
+            continue;
+
+        // 优先执行 prefetch 已经完成的模块，避免主线程等待
+        if (!node.prefetch || node.future.isFinished())
+            return i;
+
+        if (ready < 0)
+            ready = i;
+    }
+
+    if (ready >= 0)
+        return ready;
+
+    // 存在循环依赖时忽略依赖关系，按原有顺序执行
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        if (!m_nodes.at(i).done) {
+            qWarning() << "module dependency cycle detected at" << m_nodes.at(i).module->name();
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void ModuleInitScheduler::updateCriticalPath(int index)
+{
+    // 模块的完成时间 = max(prefetch 耗时, 依赖模块的完成时间) + preInitialize 耗时
+    Node &node = m_nodes[index];
+    qint64 start = node.prefetchTime;
+    for (int dependency : node.dependencies) {
+        const Node &dep = m_nodes.at(dependency);
+        if (dep.done && dep.finishTime > start) {
+            start = dep.finishTime;
+            node.criticalParent = dependency;
+        }
+    }
+    node.finishTime = start + node.preInitTime;
+}
+
+void ModuleInitScheduler::run(const std::function<void(ModuleInterface *)> &preInitialize)
+{
+    QElapsedTimer total;
+    total.start();
+
+    for (Node &node : m_nodes) {
+        if (node.prefetch)
+            startPrefetch(node);
+    }
+
+    qint64 waitTime = 0;
+    for (int index = nextNode(); index >= 0; index = nextNode()) {
+        Node &node = m_nodes[index];
+
+        QElapsedTimer et;
+        et.start();
+        if (node.prefetch) {
+            node.future.waitForFinished();
+            node.prefetchTime = node.future.result();
+            waitTime += et.elapsed();
+            et.restart();
+        }
+
+        preInitialize(node.module);
+        node.preInitTime = et.elapsed();
+        qDebug() << QString("initialize %1 module using time: %2ms (prefetch %3ms)")
+                 .arg(node.module->name())
+                 .arg(node.preInitTime)
+                 .arg(node.prefetchTime);
+
+        updateCriticalPath(index);
+        node.done = true;
+    }
+
+    // 没有被使用的 prefetch 结果不再有效，之后的 refresh 重新读取
+    dcc::DBusPropertyBinder::clearPrefetched();
+
+    qInfo() << QString("pre-initialize %1 modules using time: %2ms, waiting for prefetch: %3ms")
+             .arg(m_nodes.size())
+             .arg(total.elapsed())
+             .arg(waitTime);
+    qInfo() << "pre-initialize critical path:" << criticalPath().join(" -> ");
+}
+
+QStringList ModuleInitScheduler::criticalPath() const
+{
+    int last = -1;
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes.at(i).done && (last < 0 || m_nodes.at(i).finishTime > m_nodes.at(last).finishTime))
+            last = i;
+    }
+
+    QStringList path;
+    for (int i = last; i >= 0; i = m_nodes.at(i).criticalParent) {
+        const Node &node = m_nodes.at(i);
+        path.prepend(QString("%1(%2ms+%3ms)").arg(node.module->name()).arg(node.prefetchTime).arg(node.preInitTime));
+    }
+
+    return path;
+}
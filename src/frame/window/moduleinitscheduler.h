@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QFuture>
+#include <QList>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include <functional>
+
+namespace DCC_NAMESPACE {
+
+class ModuleInterface;
+class ModulePrefetchInterface;
+
+/**
+ * @brief The ModuleInitScheduler class
+ * 模块预初始化调度：
+ * 1. 继承了 ModulePrefetchInterface 的模块，其 D-Bus 服务激活和 prefetch 在线程池中并行执行
+ *    prefetch 通过 DBusPropertyBinder::prefetch 读取属性，预初始化结束后清除没有被使用的结果
+ * 2. preInitialize 仍然在主线程中执行，按依赖关系排序，同一层级内保持原有顺序，优先执行 prefetch 已完成的模块
+ * 3. 结束后输出关键路径，冷启动时间取决于关键路径上的模块，而不是所有模块耗时之和
+ */
+class ModuleInitScheduler
+{
+public:
+    explicit ModuleInitScheduler(const QList<ModuleInterface *> &modules);
+    ~ModuleInitScheduler();
+
+    void run(const std::function<void(ModuleInterface *)> &preInitialize);
+
+    // 关键路径上的模块及耗时，run 之后有效
+    QStringList criticalPath() const;
+
+private:
+    struct Node {
+        ModuleInterface *module;
+        ModulePrefetchInterface *prefetch;
+        QList<int> dependencies;
+        QFuture<qint64> future;
+        qint64 prefetchTime;    // 线程池中 prefetch 的耗时
+        qint64 preInitTime;     // 主线程中 preInitialize 的耗时
+        qint64 finishTime;      // 关键路径上的完成时间
+        int criticalParent;     // 关键路径上的前一个模块
+        bool done;
+    };
+
+    void startPrefetch(Node &node);
+    int nextNode() const;
+    bool dependenciesDone(const Node &node) const;
+    void updateCriticalPath(int index);
+
+private:
+    QVector<Node> m_nodes;
+    QThreadPool m_threadPool;
+};
+
+}
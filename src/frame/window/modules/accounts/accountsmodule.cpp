@@ -10,6 +10,7 @@
 #include "modules/accounts/accountsworker.h"
 #include "modules/accounts/user.h"
 #include "modules/accounts/usermodel.h"
+#include "modules/dbuspropertybinder.h"
 #include "window/gsettingwatcher.h"
 #include "window/utils.h"
 #include "securityquestionspage.h"
@@ -53,6 +54,20 @@ void AccountsModule::preInitialize(bool sync, dccV20::FrameProxyInterface::PushT
     initSearchData();
 }
 
+QStringList AccountsModule::systemServices() const
+{
+    return { "com.deepin.daemon.Accounts" };
+}
+
+void AccountsModule::prefetch()
+{
+    // 在线程池中读取用户列表和每个用户的属性，AccountsWorker 创建时直接使用
+    const QVariantMap &accounts = dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Accounts", "/com/deepin/daemon/Accounts",
+                                                                    Accounts::staticInterfaceName(), QDBusConnection::systemBus());
+    for (const QString &path : qdbus_cast<QStringList>(accounts.value("UserList")))
+        dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Accounts", path, AccountsUser::staticInterfaceName(), QDBusConnection::systemBus());
+}
+
 void AccountsModule::initialize()
 {
     connect(m_accountsWorker, &AccountsWorker::requestMainWindowEnabled, this, &AccountsModule::onSetMainWindowEnabled);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 #include "../../mainwindow.h"
 
 #include <com_deepin_daemon_accounts.h>
@@ -20,7 +21,7 @@ class UserModel;
 namespace DCC_NAMESPACE {
 namespace accounts {
 class AccountsWidget;
-class AccountsModule : public QObject, public ModuleInterface
+class AccountsModule : public QObject, public ModuleInterface, public ModulePrefetchInterface
 {
     Q_OBJECT
 
@@ -38,6 +39,8 @@ public:
     explicit AccountsModule(FrameProxyInterface *frame, QObject *parent = nullptr);
 
     virtual void preInitialize(bool sync = false, FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList systemServices() const override;
+    void prefetch() override;
     void initialize() override;
     void reset() override;
     const QString name() const override;
@@ -50,6 +50,11 @@ void BluetoothModule::preInitialize(bool sync , FrameProxyInterface::PushType pu
     updateModuleVisible();
 }
 
+QStringList BluetoothModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Bluetooth" };
+}
+
 void BluetoothModule::initialize()
 {
     connect(m_bluetoothWorker, &BluetoothWorker::requestConfirmation, this, &BluetoothModule::showPinCode);
@@ -6,6 +6,7 @@
 
 #include "interface/namespace.h"
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 
 #include <QMap>
 #include <QObject>
@@ -25,12 +26,13 @@ class PinCodeDialog;
 namespace DCC_NAMESPACE {
 namespace bluetooth {
 class BluetoothWidget;
-class BluetoothModule : public QObject, public ModuleInterface
+class BluetoothModule : public QObject, public ModuleInterface, public ModulePrefetchInterface
 {
     Q_OBJECT
 public:
     explicit BluetoothModule(FrameProxyInterface *frame, QObject *parent = nullptr);
     void preInitialize(bool sync = false , FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
     void initialize() override;
     void reset() override;
     void active() override;
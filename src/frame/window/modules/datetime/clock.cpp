@@ -7,7 +7,7 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QIcon>
-#include <QTimer>
+#include <QPixmapCache>
 
 using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::datetime;
@@ -17,10 +17,9 @@ Clock::Clock(QWidget *parent)
     , m_drawTicks(true)
     , m_autoNightMode(true)
     , n_bIsUseBlackPlat(true)
+    , m_isBlack(false)
+    , m_ratio(0)
 {
-    m_hour = getPixmap(":/datetime/icons/dcc_noun_hour.svg", pointSize);
-    m_min = getPixmap(":/datetime/icons/dcc_noun_minute.svg", pointSize);
-    m_sec = getPixmap(":/datetime/icons/dcc_noun_second.svg", pointSize);
 
     /*以下三行为默认程序模块服务，由于每个cpp只能有一种翻译，故将注释分配到其他地方*/
     //~ contents_path /defapp/Mail/Add Application
@@ -35,13 +34,20 @@ Clock::~Clock()
 
 QPixmap Clock::getPixmap(const QString &name, const QSize size)
 {
-    const QIcon &icon = QIcon(name);
+    // 表盘和指针图片只和尺寸、缩放比例有关，所有时钟共用同一份缓存
     const qreal ratio = devicePixelRatioF();
-    QPixmap pixmap = icon.pixmap(size * ratio).scaled(size * ratio, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    const QString key = QString("dcc_clock_%1_%2x%3@%4").arg(name).arg(size.width()).arg(size.height()).arg(ratio);
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap))
+        return pixmap;
+
+    const QIcon &icon = QIcon(name);
+    pixmap = icon.pixmap(size * ratio).scaled(size * ratio, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
     QPainter p(&pixmap);
     p.setRenderHints(QPainter::Antialiasing);
     p.drawPixmap(0, 0, pixmap);
     pixmap.setDevicePixelRatio(ratio);
+    QPixmapCache::insert(key, pixmap);
     return pixmap;
 }
 
@@ -54,6 +60,15 @@ void Clock::paintEvent(QPaintEvent *event)
     QPainter painter(this);
     painter.setRenderHints(QPainter::HighQualityAntialiasing | QPainter::SmoothPixmapTransform);
 
+    // 缩放比例变化(如移动到其他屏幕)时重新获取图片，之后每秒只需旋转绘制指针
+    if (!qFuzzyCompare(m_ratio, devicePixelRatioF())) {
+        m_ratio = devicePixelRatioF();
+        m_hour = getPixmap(":/datetime/icons/dcc_noun_hour.svg", pointSize);
+        m_min = getPixmap(":/datetime/icons/dcc_noun_minute.svg", pointSize);
+        m_sec = getPixmap(":/datetime/icons/dcc_noun_second.svg", pointSize);
+        m_plat = QPixmap();
+    }
+
     do {
         const bool nightMode = !(time.hour() >= 6  && time.hour() < 18);
         if (nightMode == m_isBlack && !m_plat.isNull())
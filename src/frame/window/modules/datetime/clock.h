@@ -38,6 +38,7 @@ private:
     bool m_autoNightMode;
     bool n_bIsUseBlackPlat;
     bool m_isBlack;
+    qreal m_ratio;
     ZoneInfo m_timeZone;
     QPixmap m_plat;
     QPixmap m_hour;
@@ -4,12 +4,12 @@
 
 #include "clock.h"
 #include "clockitem.h"
+#include "clockticker.h"
 #include "widgets/labels/normallabel.h"
 
 #include <DTipLabel>
 
 #include <QVBoxLayout>
-#include <QTimer>
 #include <QFontDatabase>
 #include <QDebug>
 
@@ -102,11 +102,9 @@ ClockItem::ClockItem(QWidget *parent, bool isDisplay)
 
     setLayout(layout);
 
-    QTimer *timer = new QTimer(this);
-    timer->setSingleShot(false);
-    connect(timer, &QTimer::timeout, this, &ClockItem::updateDateTime, Qt::DirectConnection);
-
-    timer->start(1000);
+    // 所有时钟共用一个按整秒对齐的计时器，窗口隐藏时暂停
+    ClockTicker::instance()->watch(this);
+    connect(ClockTicker::instance(), &ClockTicker::tick, this, &ClockItem::updateDateTime);
 
     setWeekdayFormatType(m_timedateInter->weekdayFormat());
     setShortDateFormat(m_timedateInter->shortDateFormat());
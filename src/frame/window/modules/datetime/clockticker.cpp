@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "clockticker.h"
+
+#include <QApplication>
+#include <QEvent>
+#include <QTimer>
+#include <QWidget>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::datetime;
+
+ClockTicker::ClockTicker(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ClockTicker::onTimeout);
+}
+
+ClockTicker *ClockTicker::instance()
+{
+    // 跟随 QApplication 销毁，避免程序退出后再停止定时器
+    static ClockTicker *ticker = new ClockTicker(qApp);
+    return ticker;
+}
+
+void ClockTicker::watch(QWidget *widget)
+{
+    if (!widget || m_widgets.contains(widget))
+        return;
+
+    m_widgets.insert(widget, widget->isVisible());
+    widget->installEventFilter(this);
+    connect(widget, &QObject::destroyed, this, [this](QObject *obj) {
+        m_widgets.remove(obj);
+        updateState();
+    });
+    updateState();
+}
+
+bool ClockTicker::isActive() const
+{
+    return m_timer->isActive();
+}
+
+bool ClockTicker::eventFilter(QObject *watched, QEvent *event)
+{
+    // 窗口最小化时控件也会收到 Hide 事件，这时 isVisible() 仍然为 true
+    if (event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+        auto it = m_widgets.find(watched);
+        if (it != m_widgets.end()) {
+            it.value() = event->type() == QEvent::Show;
+            updateState();
+        }
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void ClockTicker::updateState()
+{
+    bool visible = false;
+    for (bool shown : m_widgets)
+        visible |= shown;
+
+    if (!visible) {
+        m_timer->stop();
+    } else if (!m_timer->isActive()) {
+        onTimeout();
+    }
+}
+
+void ClockTicker::onTimeout()
+{
+    // 对齐到下一秒开始的时刻，先启动定时器，刷新时钟的耗时不影响下一次 tick
+    const QDateTime now = QDateTime::currentDateTime();
+    m_timer->start(1000 - now.time().msec());
+    Q_EMIT tick(now);
+}
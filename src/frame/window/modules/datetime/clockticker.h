@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+
+class QTimer;
+
+namespace DCC_NAMESPACE {
+namespace datetime {
+
+/**
+ * @brief The ClockTicker class
+ * 进程内共享的时钟信号，在每一秒开始时发出 tick，所有时钟一起刷新。
+ * 关注的控件全部隐藏(包括窗口最小化)时停止计时，再次显示时立即发出一次 tick
+ */
+class ClockTicker : public QObject
+{
+    Q_OBJECT
+public:
+    static ClockTicker *instance();
+
+    // 控件显示时才需要计时，控件销毁后自动移除
+    void watch(QWidget *widget);
+    bool isActive() const;
+
+Q_SIGNALS:
+    void tick(const QDateTime &now);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit ClockTicker(QObject *parent = nullptr);
+    void updateState();
+    void onTimeout();
+
+private:
+    QTimer *m_timer;
+    QHash<QObject *, bool> m_widgets;   // 控件是否显示
+};
+
+} // namespace datetime
+} // namespace DCC_NAMESPACE
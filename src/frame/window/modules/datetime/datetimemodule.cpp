@@ -61,6 +61,16 @@ void DatetimeModule::preInitialize(bool sync, FrameProxyInterface::PushType)
     initSearchData();
 }
 
+QStringList DatetimeModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Timedate" };
+}
+
+QStringList DatetimeModule::systemServices() const
+{
+    return { "com.deepin.daemon.Timedated" };
+}
+
 void DatetimeModule::initialize()
 {
 #ifndef DCC_DISABLE_TIMEZONE
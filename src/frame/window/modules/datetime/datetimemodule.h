@@ -5,6 +5,7 @@
 #pragma once
 
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 
 #include <QObject>
 
@@ -28,7 +29,7 @@ class FormatSetting;
 class CurrencyFormat;
 class NumberFormat;
 
-class DatetimeModule : public QObject, public ModuleInterface
+class DatetimeModule : public QObject, public ModuleInterface, public ModulePrefetchInterface
 {
     Q_OBJECT
 public:
@@ -46,6 +47,8 @@ public:
     DatetimeModule(FrameProxyInterface *frameProxy, QObject *parent = nullptr);
 
     void preInitialize(bool sync = false , FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
+    QStringList systemServices() const override;
     virtual void initialize() override;
     virtual const QString name() const override;
     virtual const QString displayName() const override;
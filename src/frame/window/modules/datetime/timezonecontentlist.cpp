@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "timezonecontentlist.h"
+#include "clockticker.h"
 #include "widgets/settingsgroup.h"
 #include "widgets/settingsitem.h"
 #include "modules/datetime/timezoneitem.h"
@@ -18,6 +19,7 @@ TimezoneContentList::TimezoneContentList(QWidget *parent)
     : ContentWidget(parent)
     , m_centralLayout(new QVBoxLayout)
     , m_timezoneGroup(new SettingsGroup)
+    , m_lastMinute(0)
 {
     setAccessibleName("TimezoneContentList");
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -31,6 +33,16 @@ TimezoneContentList::TimezoneContentList(QWidget *parent)
     mainWidget->setLayout(m_centralLayout);
     layout()->setMargin(0);
     setContent(mainWidget);
+
+    // 世界时钟只显示到分钟，每分钟刷新一次
+    ClockTicker::instance()->watch(this);
+    connect(ClockTicker::instance(), &ClockTicker::tick, this, [this](const QDateTime &now) {
+        const qint64 minute = now.toMSecsSinceEpoch() / 60000;
+        if (minute != m_lastMinute) {
+            m_lastMinute = minute;
+            updateTimezoneItems();
+        }
+    });
 }
 
 TimezoneContentList::~TimezoneContentList()
@@ -42,6 +42,7 @@ private:
     QVBoxLayout *m_centralLayout;
     dcc::widgets::SettingsGroup *m_timezoneGroup;
     QList<dcc::datetime::TimezoneItem *> m_zoneList;
+    qint64 m_lastMinute;
 
 Q_SIGNALS:
     void requestRemoveUserTimeZone(const ZoneInfo &zone);
@@ -16,6 +16,7 @@
 #include "widgets/timeoutdialog.h"
 #include "modules/display/displaymodel.h"
 #include "modules/display/displayworker.h"
+#include "modules/dbuspropertybinder.h"
 
 #include <QApplication>
 #include <QDesktopWidget>
@@ -29,6 +30,7 @@ DisplayModule::DisplayModule(FrameProxyInterface *frame, QObject *parent)
     , m_displayModel(nullptr)
     , m_displayWorker(nullptr)
     , m_displayWidget(nullptr)
+    , m_cachedMonitor(nullptr)
 {
     // 用于传入MultiScreenWidget销毁副屏窗口
     m_pMainWindow = dynamic_cast<MainWindow *>(m_frameProxy);
@@ -72,12 +74,30 @@ void DisplayModule::active()
     pushScreenWidget();
     m_frameProxy->pushWidget(this, m_displayWidget);
     QTimer::singleShot(0, this, [=] {
-        if (m_frameProxy->currModule()->name() != name())
+        if (!m_frameProxy->currModule() || m_frameProxy->currModule()->name() != name())
             return;
         m_displayWidget->setVisible(true);
     });
 }
 
+void DisplayModule::deactive()
+{
+    m_cachedMonitor = m_displayModel->monitorList().isEmpty() ? nullptr : m_displayModel->monitorList().first();
+}
+
+bool DisplayModule::isPageCacheable() const
+{
+    // 多屏时副屏上有设置窗口，不缓存页面
+    return m_displayModel && m_displayModel->monitorList().size() <= 1;
+}
+
+bool DisplayModule::restore()
+{
+    // 缓存期间插拔显示器时页面失效
+    return isPageCacheable() && !m_displayModel->monitorList().isEmpty()
+           && m_displayModel->monitorList().first() == m_cachedMonitor;
+}
+
 int DisplayModule::load(const QString &path)
 {
     if (!m_displayWidget) {
@@ -155,6 +175,18 @@ void DisplayModule::preInitialize(bool sync, FrameProxyInterface::PushType pusht
     });
 }
 
+QStringList DisplayModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Display", "com.deepin.daemon.Appearance" };
+}
+
+void DisplayModule::prefetch()
+{
+    // 在线程池中读取显示属性，DisplayWorker 第一次 active 时直接使用
+    dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Display", "/com/deepin/daemon/Display",
+                                      "com.deepin.daemon.Display", QDBusConnection::sessionBus());
+}
+
 QStringList DisplayModule::availPage() const
 {
     QStringList sl;
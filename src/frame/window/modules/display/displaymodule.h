@@ -6,6 +6,8 @@
 #define DISPLAYMODULE_H
 
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
+#include "interface/modulepagecacheinterface.h"
 #include "interface/namespace.h"
 #include "../../mainwindow.h"
 #include "modules/display/recognizewidget.h"
@@ -30,6 +32,8 @@ class DisplayWidget;
 
 class DisplayModule : public QObject
     , public ModuleInterface
+    , public ModulePrefetchInterface
+    , public ModulePageCacheInterface
 {
     Q_OBJECT
     Q_INTERFACES(DCC_NAMESPACE::ModuleInterface)
@@ -43,8 +47,13 @@ public:
     const QString name() const override;
     const QString displayName() const override;
     void active() override;
+    void deactive() override;
     int load(const QString &path) override;
     void preInitialize(bool sync = false, FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
+    void prefetch() override;
+    bool isPageCacheable() const override;
+    bool restore() override;
     QStringList availPage() const override;
     void addChildPageTrans() const override;
 
@@ -66,6 +75,7 @@ private:
     DisplayWidget *m_displayWidget;
     MainWindow *m_pMainWindow;
     QMap<QString, RecognizeWidget *> m_recognizeWidget;
+    dcc::display::Monitor *m_cachedMonitor;   // 页面缓存时的显示器，显示器变化后缓存的页面失效
 };
 
 } // namespace display
@@ -59,6 +59,11 @@ void KeyboardModule::preInitialize(bool sync, FrameProxyInterface::PushType)
     initSearchData();
 }
 
+QStringList KeyboardModule::sessionServices() const
+{
+    return { "com.deepin.daemon.InputDevices", "com.deepin.daemon.Keybinding" };
+}
+
 void KeyboardModule::initialize()
 {
     m_work->setShortcutModel(m_shortcutModel);
@@ -6,6 +6,7 @@
 
 #include "interface/namespace.h"
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 
 #include <QObject>
 
@@ -31,7 +32,7 @@ class SystemLanguageWidget;
 class SystemLanguageSettingWidget;
 class ShortCutSettingWidget;
 class CustomContent;
-class KeyboardModule : public QObject, public ModuleInterface
+class KeyboardModule : public QObject, public ModuleInterface, public ModulePrefetchInterface
 {
     Q_OBJECT
 
@@ -40,6 +41,7 @@ public:
     ~KeyboardModule();
 
     void preInitialize(bool sync = false , FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
     void initialize() override;
     void reset() override;
     void active() override;
@@ -56,6 +56,11 @@ void MouseModule::preInitialize(bool sync, FrameProxyInterface::PushType pushtyp
     initSearchData();
 }
 
+QStringList MouseModule::sessionServices() const
+{
+    return { "com.deepin.daemon.InputDevices" };
+}
+
 void MouseModule::initialize()
 {
 
@@ -6,6 +6,7 @@
 
 #include "interface/namespace.h"
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 
 #include <QObject>
 
@@ -26,7 +27,7 @@ class MouseSettingWidget;
 class TouchPadSettingWidget;
 class TrackPointSettingWidget;
 
-class MouseModule : public QObject, public ModuleInterface
+class MouseModule : public QObject, public ModuleInterface, public ModulePrefetchInterface
 {
     Q_OBJECT
     Q_PLUGIN_METADATA(IID ModuleInterface_iid)
@@ -36,6 +37,7 @@ public:
     explicit MouseModule() = default;
     explicit MouseModule(FrameProxyInterface *frame, QObject *parent = nullptr);
     void preInitialize(bool sync = false , FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
     void initialize() override;
     void reset() override;
     void active() override;
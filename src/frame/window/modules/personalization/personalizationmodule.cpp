@@ -52,6 +52,11 @@ void PersonalizationModule::preInitialize(bool sync, FrameProxyInterface::PushTy
     initSearchData();
 }
 
+QStringList PersonalizationModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Appearance" };
+}
+
 void PersonalizationModule::initialize()
 {
     m_model->moveToThread(qApp->thread());
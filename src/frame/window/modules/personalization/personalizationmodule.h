@@ -6,6 +6,7 @@
 
 #include "interface/namespace.h"
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 
 #include <QObject>
 
@@ -22,7 +23,7 @@ namespace DCC_NAMESPACE {
 class MainWindow;
 namespace personalization {
 class PersonalizationList;
-class PersonalizationModule : public QObject, public ModuleInterface
+class PersonalizationModule : public QObject, public ModuleInterface, public ModulePrefetchInterface
 {
     Q_OBJECT
 public:
@@ -30,6 +31,7 @@ public:
     ~PersonalizationModule();
 
     virtual void preInitialize(bool sync = false , FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
     virtual void initialize() override;
     virtual const QString name() const override;
     virtual const QString displayName() const override;
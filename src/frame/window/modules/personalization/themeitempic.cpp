@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "themeitempic.h"
+#include "themepiccache.h"
 
 #include <DStyle>
 #include <DSvgRenderer>
@@ -25,6 +26,10 @@ ThemeItemPic::ThemeItemPic(QWidget *parent)
     , m_isSelected(false)
     , render(new DSvgRenderer())
 {
+    connect(ThemePicCache::instance(), &ThemePicCache::imageReady, this, [this](const QString &path) {
+        if (path == m_path)
+            update();
+    });
 }
 
 bool ThemeItemPic::isSelected()
@@ -40,6 +45,7 @@ void ThemeItemPic::setSelected(bool selected)
 
 void ThemeItemPic::setPath(const QString &picPath)
 {
+    m_path = picPath;
     render->load(picPath);
     QSize defaultSize = render->defaultSize();
 
@@ -76,12 +82,14 @@ void ThemeItemPic::paintEvent(QPaintEvent *event)
     QPainter painter(this);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
-    //first draw image
-    const auto ratio = devicePixelRatioF();
-    QSize defaultSize = render->defaultSize() * ratio;
-    QImage img = render->toImage(defaultSize);
+    //first draw image, svg is rendered in background and cached, use base color until it is ready
+    const QImage img = ThemePicCache::instance()->image(m_path, render->defaultSize(), devicePixelRatioF());
     QRect picRect = rect().adjusted(totalSpace, totalSpace, -totalSpace, -totalSpace);
-    painter.drawImage(picRect, img, img.rect());
+    if (img.isNull()) {
+        painter.fillRect(picRect, palette().window());
+    } else {
+        painter.drawImage(picRect, img, img.rect());
+    }
 
     //second draw picture rounded rect bound
     QPen pen;
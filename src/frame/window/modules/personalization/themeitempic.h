@@ -33,6 +33,7 @@ protected:
 
 private:
     bool m_isSelected = false;
+    QString m_path;
     DTK_GUI_NAMESPACE::DSvgRenderer *render;
 };
 }
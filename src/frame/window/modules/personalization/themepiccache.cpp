@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "themepiccache.h"
+
+#include <DSvgRenderer>
+
+#include <QApplication>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::personalization;
+using DTK_GUI_NAMESPACE::DSvgRenderer;
+
+// 缓存大小的单位为 KB，默认 32 * 1024 KB (32MB)，足够容纳所有主题在高分屏下的预览图
+static const int DefaultCostLimit = 32 * 1024;
+
+static QImage renderPic(const QString &path, const QSize &size)
+{
+    // 每个线程使用单独的 renderer
+    DSvgRenderer render;
+    if (!render.load(path))
+        return QImage();
+
+    return render.toImage(size);
+}
+
+ThemePicCache::ThemePicCache(QObject *parent)
+    : QObject(parent)
+    , m_cache(DefaultCostLimit)
+{
+}
+
+ThemePicCache *ThemePicCache::instance()
+{
+    static ThemePicCache *cache = new ThemePicCache(qApp);
+    return cache;
+}
+
+QImage ThemePicCache::image(const QString &path, const QSize &size, qreal ratio)
+{
+    if (path.isEmpty() || size.isEmpty())
+        return QImage();
+
+    const QString key = QString("%1_%2x%3@%4").arg(path).arg(size.width()).arg(size.height()).arg(ratio);
+    if (QImage *image = m_cache.object(key))
+        return *image;
+
+    if (m_pending.contains(key))
+        return QImage();
+
+    m_pending.insert(key);
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, path] {
+        onRendered(key, path, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(renderPic, path, size * ratio));
+
+    return QImage();
+}
+
+void ThemePicCache::setCostLimit(int kilobytes)
+{
+    m_cache.setMaxCost(kilobytes);
+}
+
+int ThemePicCache::costLimit() const
+{
+    return m_cache.maxCost();
+}
+
+int ThemePicCache::cost() const
+{
+    return m_cache.totalCost();
+}
+
+void ThemePicCache::onRendered(const QString &key, const QString &path, const QImage &image)
+{
+    m_pending.remove(key);
+
+    // 绘制失败时也缓存空图片，避免每次绘制都重试；超出限制的图片也要能放入缓存
+    const int cost = int(image.sizeInBytes() / 1024);
+    m_cache.insert(key, new QImage(image), qMin(cost, m_cache.maxCost()));
+
+    Q_EMIT imageReady(path);
+}
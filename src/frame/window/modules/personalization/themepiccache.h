@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+
+namespace DCC_NAMESPACE {
+namespace personalization {
+
+/**
+ * @brief The ThemePicCache class
+ * 主题预览图的位图缓存，按 (路径, 尺寸, 缩放比例) 区分。
+ * 没有缓存时在线程池中绘制 svg，绘制完成后发出 imageReady，
+ * 缓存总大小超出限制时淘汰最久没有使用的图片
+ */
+class ThemePicCache : public QObject
+{
+    Q_OBJECT
+public:
+    static ThemePicCache *instance();
+
+    // 返回已缓存的图片，没有缓存时开始后台绘制并返回空图片
+    QImage image(const QString &path, const QSize &size, qreal ratio);
+
+    // 缓存大小限制，单位 KB
+    void setCostLimit(int kilobytes);
+    int costLimit() const;
+    int cost() const;
+
+Q_SIGNALS:
+    void imageReady(const QString &path);
+
+private:
+    explicit ThemePicCache(QObject *parent = nullptr);
+    void onRendered(const QString &key, const QString &path, const QImage &image);
+
+private:
+    QCache<QString, QImage> m_cache;
+    QSet<QString> m_pending;    // 正在绘制的图片，避免重复绘制
+};
+
+} // namespace personalization
+} // namespace DCC_NAMESPACE
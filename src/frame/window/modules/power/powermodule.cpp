@@ -95,6 +95,23 @@ void PowerModule::preInitialize(bool sync, FrameProxyInterface::PushType pushtyp
     initSearchData();
 }
 
+QStringList PowerModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Power" };
+}
+
+QStringList PowerModule::systemServices() const
+{
+    return { "com.deepin.system.Power" };
+}
+
+void PowerModule::prefetch()
+{
+    // 在线程池中读取电源设置，PowerWorker 的 DBusPropertyBinder 第一次 refresh 时直接使用
+    dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Power", "/com/deepin/daemon/Power", "com.deepin.daemon.Power", QDBusConnection::sessionBus());
+    dcc::DBusPropertyBinder::prefetch("com.deepin.system.Power", "/com/deepin/system/Power", "com.deepin.system.Power", QDBusConnection::systemBus());
+}
+
 void PowerModule::initialize()
 {
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 
 #include <QGSettings>
 #include <QObject>
@@ -26,6 +27,7 @@ class PowerWidget;
 
 class PowerModule : public QObject
     , public ModuleInterface
+    , public ModulePrefetchInterface
 {
     Q_OBJECT
 public:
@@ -47,6 +49,9 @@ public:
     PowerModule(FrameProxyInterface *frameProxy, QObject *parent = nullptr);
 
     virtual void preInitialize(bool sync = false, FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
+    QStringList systemServices() const override;
+    void prefetch() override;
     virtual void initialize() override;
     virtual const QString name() const override;
     virtual const QString displayName() const override;
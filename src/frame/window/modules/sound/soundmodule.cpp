@@ -47,6 +47,28 @@ void SoundModule::preInitialize(bool, FrameProxyInterface::PushType pushtype)
     initSearchData();
 }
 
+QStringList SoundModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Audio", "com.deepin.daemon.SoundEffect" };
+}
+
+void SoundModule::prefetch()
+{
+    // 在线程池中读取音频属性以及默认输出、输入设备的属性，SoundWorker 的 DBusPropertyBinder 第一次 refresh 时直接使用
+    const QVariantMap &audio = dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Audio", "/com/deepin/daemon/Audio",
+                                                                 Audio::staticInterfaceName(), QDBusConnection::sessionBus());
+    dcc::DBusPropertyBinder::prefetch("com.deepin.system.Power", "/com/deepin/system/Power",
+                                      SystemPowerInter::staticInterfaceName(), QDBusConnection::systemBus());
+
+    const QString &sink = qdbus_cast<QDBusObjectPath>(audio.value("DefaultSink")).path();
+    if (!sink.isEmpty())
+        dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Audio", sink, Sink::staticInterfaceName(), QDBusConnection::sessionBus());
+
+    const QString &source = qdbus_cast<QDBusObjectPath>(audio.value("DefaultSource")).path();
+    if (!source.isEmpty())
+        dcc::DBusPropertyBinder::prefetch("com.deepin.daemon.Audio", source, Source::staticInterfaceName(), QDBusConnection::sessionBus());
+}
+
 void SoundModule::addChildPageTrans() const
 {
     if (m_frameProxy != nullptr) {
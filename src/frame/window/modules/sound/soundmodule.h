@@ -6,6 +6,8 @@
 #define SOUNDMODULE_H_V20
 
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
+#include "interface/modulepagecacheinterface.h"
 #include "interface/namespace.h"
 
 #include <QObject>
@@ -26,6 +28,8 @@ class SoundWidget;
 
 class SoundModule : public QObject
     , public ModuleInterface
+    , public ModulePrefetchInterface
+    , public ModulePageCacheInterface
 {
     Q_OBJECT
 public:
@@ -39,6 +43,8 @@ public:
     int load(const QString &path) override;
     QStringList availPage() const override;
     void preInitialize(bool sync = false, FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList sessionServices() const override;
+    void prefetch() override;
     virtual void addChildPageTrans() const override;
 
 private:
@@ -45,6 +45,16 @@ void TouchscreenModule::preInitialize(bool sync, FrameProxyInterface::PushType p
     initSearchData();
 }
 
+QStringList TouchscreenModule::preInitializeAfter() const
+{
+    return { "display" };
+}
+
+QStringList TouchscreenModule::sessionServices() const
+{
+    return { "com.deepin.daemon.Display" };
+}
+
 void TouchscreenModule::initialize()
 {
 
@@ -6,6 +6,7 @@
 #define TOUCHSCREENMODULE_H
 
 #include "interface/moduleinterface.h"
+#include "interface/moduleprefetchinterface.h"
 #include "interface/namespace.h"
 
 namespace dcc {
@@ -24,6 +25,7 @@ class TouchscreenWidget;
 
 class TouchscreenModule : public QObject
     , public ModuleInterface
+    , public ModulePrefetchInterface
 {
     Q_OBJECT
     Q_INTERFACES(DCC_NAMESPACE::ModuleInterface)
@@ -32,6 +34,8 @@ public:
     ~TouchscreenModule() override;
 
     virtual void preInitialize(bool sync = false , FrameProxyInterface::PushType = FrameProxyInterface::PushType::Normal) override;
+    QStringList preInitializeAfter() const override;
+    QStringList sessionServices() const override;
     virtual void initialize() override;
     virtual void active() override;
     virtual const QString name() const override;
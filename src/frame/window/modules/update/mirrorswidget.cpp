@@ -89,8 +89,6 @@ void MirrorsWidget::setModel(UpdateModel *model)
     qRegisterMetaType<QMap<QString, int>>("QMap<QString, int>");
     connect(model, &UpdateModel::defaultMirrorChanged, this, &MirrorsWidget::setDefaultMirror);
     connect(model, &UpdateModel::mirrorSpeedInfoAvaiable, this, &MirrorsWidget::onSpeedInfoAvailable);
-    connect(model, &UpdateModel::netselectExistChanged, m_testButton, &QPushButton::setVisible);
-    m_testButton->setVisible(model->netselectExist());
 }
 
 //close the window can do it
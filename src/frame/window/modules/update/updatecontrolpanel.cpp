@@ -25,6 +25,8 @@ updateControlPanel::updateControlPanel(QWidget *parent)
     , m_buttonStatus(ButtonStatus::invalid)
     , m_progressType(UpdateDProgressType::InvalidType)
     , m_currentValue(0)
+    , m_textValue(-1)
+    , m_textType(UpdateDProgressType::InvalidType)
 {
     initUi();
     initConnect();
@@ -45,6 +47,8 @@ void updateControlPanel::setProgressValue(int value)
     }
 
     m_currentValue = value;
+    if (value == m_textValue && m_progressType == m_textType)
+        return;
 
     m_Progess->setValue(value);
     QString text;
@@ -67,6 +71,8 @@ void updateControlPanel::setProgressValue(int value)
     }
 
     setProgressText(text);
+    m_textValue = value;
+    m_textType = m_progressType;
 }
 
 void updateControlPanel::setButtonIcon(ButtonStatus status)
@@ -201,6 +207,8 @@ void updateControlPanel::setDate(QString date)
 
 void updateControlPanel::setProgressText(const QString &text, const QString &toolTip)
 {
+    // 文字被其他状态替换后，下次进度变化需要重新显示
+    m_textValue = -1;
     m_progressLabel->setText(getElidedText(m_progressLabel, text, Qt::ElideRight, m_progressLabel->maximumWidth() - 10, 0, __LINE__));
     m_progressLabel->setToolTip(toolTip);
 }
@@ -107,6 +107,9 @@ private:
     ButtonStatus m_buttonStatus;
     UpdateDProgressType m_progressType;
     int m_currentValue;
+    // 上次显示的进度和类型，相同时不再格式化文字
+    int m_textValue;
+    UpdateDProgressType m_textType;
 };
 
 }
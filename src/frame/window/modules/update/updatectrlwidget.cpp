@@ -40,6 +40,8 @@ UpdateCtrlWidget::UpdateCtrlWidget(UpdateModel *model, QWidget *parent)
     , m_checkUpdateItem(new LoadingItem())
     , m_resultItem(new ResultItem())
     , m_progress(new DownloadProgressBar(parent))
+    , m_progressPercent(-1)
+    , m_progressStatus(UpdatesStatus::Default)
     , m_fullProcess(new DownloadProgressBar(parent))
     , m_upgradeWarningGroup(new SettingsGroup)
     , m_summary(new SummaryItem)
@@ -417,12 +419,19 @@ void UpdateCtrlWidget::setUnkonowUpdateStatus(const UpdatesStatus &status)
 
 void UpdateCtrlWidget::setProgressValue(const double value)
 {
+    // 显示的百分比和状态都没有变化时不再刷新
+    const int percent = qFloor(value * 100);
+    if (percent == m_progressPercent && m_status == m_progressStatus)
+        return;
+
+    m_progressPercent = percent;
+    m_progressStatus = m_status;
     m_progress->setProcessValue(static_cast<int>(value * 100));
 
     if (m_status == UpdatesStatus::Downloading) {
-        m_progress->setMessage(tr("%1% downloaded (Click to pause)").arg(qFloor(value * 100)));
+        m_progress->setMessage(tr("%1% downloaded (Click to pause)").arg(percent));
     } else if (m_status == UpdatesStatus::DownloadPaused) {
-        m_progress->setMessage(tr("%1% downloaded (Click to continue)").arg(qFloor(value * 100)));
+        m_progress->setMessage(tr("%1% downloaded (Click to continue)").arg(percent));
     }
 }
 
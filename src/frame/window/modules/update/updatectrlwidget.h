@@ -123,6 +123,8 @@ private:
     LoadingItem *m_checkUpdateItem;
     ResultItem *m_resultItem;
     DownloadProgressBar *m_progress;
+    int m_progressPercent;              // 上次显示的进度，相同时不再格式化文字
+    UpdatesStatus m_progressStatus;
     DownloadProgressBar *m_fullProcess;
     dcc::widgets::SettingsGroup *m_upgradeWarningGroup;
     SummaryItem *m_summary;
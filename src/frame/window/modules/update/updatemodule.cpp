@@ -147,7 +147,6 @@ void UpdateModule::active()
         m_mirrorsWidget = new MirrorsWidget(m_model);
         m_mirrorsWidget->setVisible(false);
         int topWidgetWidth = m_updateWidget->parentWidget()->parentWidget()->width();
-        m_work->checkNetselect();
         m_mirrorsWidget->setMinimumWidth(topWidgetWidth / 2);
         m_mirrorsWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
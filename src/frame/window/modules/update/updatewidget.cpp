@@ -225,7 +225,6 @@ void UpdateWidget::showUpdateSetting()
 {
     qDebug() << Q_FUNC_INFO;
     resetUpdateCheckState(false);
-    m_work->checkNetselect();
 #ifndef DISABLE_SYS_UPDATE_MIRRORS
     Q_EMIT m_work->requestRefreshMirrors();
 #endif
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "pagecache.h"
+
+#include <QStandardPaths>
+
+#include <algorithm>
+
+using namespace DCC_NAMESPACE;
+
+namespace {
+const QString UsageGroup = "visits";
+}
+
+PageCache::PageCache(int capacity, int maxWidgets)
+    : m_capacity(capacity)
+    , m_maxWidgets(maxWidgets)
+    , m_widgetCount(0)
+    , m_usage(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/page-usage.ini", QSettings::IniFormat)
+{
+    m_usage.beginGroup(UsageGroup);
+    for (const QString &module : m_usage.childKeys())
+        m_visits.insert(module, m_usage.value(module).toInt());
+    m_usage.endGroup();
+}
+
+int PageCache::pageCost(const PageStack &pages)
+{
+    int cost = 0;
+    for (const auto &page : pages) {
+        if (page.second)
+            cost += page.second->findChildren<QWidget *>().size() + 1;
+    }
+    return cost;
+}
+
+QList<PageCache::PageStack> PageCache::insert(ModuleInterface *module, const PageStack &pages)
+{
+    QList<PageStack> evicted;
+    if (m_entries.contains(module))
+        evicted << take(module);
+
+    Entry entry { pages, pageCost(pages) };
+    // 单个页面的控件数量超出上限时不缓存
+    if (entry.cost > m_maxWidgets) {
+        evicted << pages;
+        return evicted;
+    }
+
+    m_entries.insert(module, entry);
+    m_lru.prepend(module);
+    m_widgetCount += entry.cost;
+
+    while (m_lru.size() > m_capacity || m_widgetCount > m_maxWidgets)
+        evicted << take(m_lru.last());
+
+    return evicted;
+}
+
+PageCache::PageStack PageCache::take(ModuleInterface *module)
+{
+    auto it = m_entries.find(module);
+    if (it == m_entries.end())
+        return PageStack();
+
+    const Entry entry = it.value();
+    m_entries.erase(it);
+    m_lru.removeOne(module);
+    m_widgetCount -= entry.cost;
+    return entry.pages;
+}
+
+QList<PageCache::PageStack> PageCache::takeAll()
+{
+    QList<PageStack> pages;
+    while (!m_lru.isEmpty())
+        pages << take(m_lru.last());
+    return pages;
+}
+
+void PageCache::addVisit(const QString &module)
+{
+    const int visits = ++m_visits[module];
+    m_usage.setValue(UsageGroup + "/" + module, visits);
+}
+
+QStringList PageCache::mostUsed(int count) const
+{
+    QList<QPair<int, QString>> visits;
+    for (auto it = m_visits.cbegin(); it != m_visits.cend(); ++it)
+        visits << qMakePair(-it.value(), it.key());
+
+    count = qMin(count, visits.size());
+    std::partial_sort(visits.begin(), visits.begin() + count, visits.end());
+
+    QStringList modules;
+    for (int i = 0; i < count; ++i)
+        modules << visits.at(i).second;
+    return modules;
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QSettings>
+#include <QStringList>
+#include <QWidget>
+
+namespace DCC_NAMESPACE {
+
+class ModuleInterface;
+
+/**
+ * @brief The PageCache class
+ * 已经隐藏的模块页面缓存，按最近使用顺序淘汰。
+ * 除了缓存的模块数量外，还限制缓存中控件的总数量，用控件数量近似页面占用的内存，不统计字节数；
+ * 同时记录各模块的进入次数，用于空闲时预先创建最常用模块的页面
+ */
+class PageCache
+{
+public:
+    // 模块的页面栈，从二级页面开始
+    typedef QList<QPair<ModuleInterface *, QPointer<QWidget>>> PageStack;
+
+    PageCache(int capacity, int maxWidgets);
+
+    inline bool contains(ModuleInterface *module) const { return m_entries.contains(module); }
+    inline int widgetCount() const { return m_widgetCount; }
+
+    // 放入缓存，返回因超出模块数量或控件数量上限被淘汰的页面，由调用者销毁
+    QList<PageStack> insert(ModuleInterface *module, const PageStack &pages);
+    // 从缓存中取出页面，不存在时返回空
+    PageStack take(ModuleInterface *module);
+    QList<PageStack> takeAll();
+
+    // 模块进入次数
+    void addVisit(const QString &module);
+    QStringList mostUsed(int count) const;
+
+private:
+    struct Entry {
+        PageStack pages;
+        int cost;
+    };
+
+    static int pageCost(const PageStack &pages);
+
+private:
+    int m_capacity;
+    int m_maxWidgets;
+    int m_widgetCount;
+    QHash<ModuleInterface *, Entry> m_entries;
+    QList<ModuleInterface *> m_lru;     // 最近使用的在最前
+    QHash<QString, int> m_visits;
+    QSettings m_usage;
+};
+
+}
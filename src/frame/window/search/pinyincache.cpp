@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "pinyincache.h"
+
+#include <DPinyin>
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::search;
+
+namespace {
+const quint32 PinyinCacheMagic = 0x44435059; // "DCPY"
+const quint32 PinyinCacheVersion = 1;
+// 多音字组合数量随字数指数增长，只保留前几种读音
+const int MaxPolyphoneCount = 4;
+
+// 去掉拼音中的声调数字，如 "xian3shi4" -> "xianshi"
+QString removeTone(const QString &pinyin)
+{
+    QString value;
+    value.reserve(pinyin.size());
+    for (const QChar &ch : pinyin) {
+        if (!ch.isDigit())
+            value.append(ch);
+    }
+    return value;
+}
+
+// 根据带声调的拼音获取首字母，声调数字即为音节的分隔，如 "xian3shi4" -> "xs"
+QString initialsOf(const QString &pinyin)
+{
+    QString value;
+    bool newSyllable = true;
+    for (const QChar &ch : pinyin) {
+        if (ch.isLetter()) {
+            if (newSyllable)
+                value.append(ch);
+            newSyllable = false;
+        } else {
+            newSyllable = true;
+        }
+    }
+    return value;
+}
+
+// 只对汉字部分计算拼音，与原有搜索数据的处理保持一致
+QString removeLatin(const QString &phrase)
+{
+    QString value;
+    value.reserve(phrase.size());
+    for (const QChar &ch : phrase) {
+        if (!((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')))
+            value.append(ch);
+    }
+    return value;
+}
+}
+
+namespace DCC_NAMESPACE {
+namespace search {
+QDataStream &operator<<(QDataStream &out, const PinyinKeys &keys)
+{
+    return out << keys.pinyin << keys.initials;
+}
+
+QDataStream &operator>>(QDataStream &in, PinyinKeys &keys)
+{
+    return in >> keys.pinyin >> keys.initials;
+}
+}// namespace search
+}// namespace DCC_NAMESPACE
+
+PinyinCache::PinyinCache(const QString &lang)
+    : m_path(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QString("/search-pinyin_%1.cache").arg(lang))
+    , m_dirty(false)
+{
+}
+
+bool PinyinCache::load()
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != PinyinCacheMagic || version != PinyinCacheVersion) {
+        qWarning() << " [PinyinCache] invalid cache:" << m_path;
+        return false;
+    }
+
+    in.setVersion(QDataStream::Qt_5_11);
+    QHash<QString, PinyinKeys> keys;
+    in >> keys;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    m_keys.unite(keys);
+    return true;
+}
+
+bool PinyinCache::save() const
+{
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << PinyinCacheMagic << PinyinCacheVersion;
+    out.setVersion(QDataStream::Qt_5_11);
+    out << m_keys;
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+const PinyinKeys &PinyinCache::keys(const QString &phrase)
+{
+    auto it = m_keys.constFind(phrase);
+    if (it != m_keys.constEnd())
+        return it.value();
+
+    m_dirty = true;
+    return *m_keys.insert(phrase, createKeys(phrase));
+}
+
+PinyinKeys PinyinCache::createKeys(const QString &phrase)
+{
+    PinyinKeys keys;
+    const QString hanzi = removeLatin(phrase);
+    const QString pinyin = DTK_CORE_NAMESPACE::Chinese2Pinyin(hanzi);
+
+    keys.pinyin << removeTone(pinyin);
+    keys.initials = initialsOf(pinyin);
+
+#if DTK_VERSION >= DTK_VERSION_CHECK(5, 6, 8, 0)
+    // 多音字的其他读音
+    const QStringList polyphones = DTK_CORE_NAMESPACE::pinyin(hanzi, DTK_CORE_NAMESPACE::TS_NoneTone);
+    for (const QString &value : polyphones) {
+        if (keys.pinyin.size() >= MaxPolyphoneCount)
+            break;
+        if (!keys.pinyin.contains(value))
+            keys.pinyin << value;
+    }
+#endif
+
+    return keys;
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+// 一个汉字短语的拼音搜索关键字
+struct PinyinKeys {
+    QStringList pinyin;     // 全拼，第一个为默认读音，其余为多音字的其他读音
+    QString initials;       // 首字母
+};
+
+/**
+ * @brief The PinyinCache class
+ * 缓存搜索数据中每个短语的拼音，首次使用时计算并持久化到用户缓存目录，
+ * 之后启动时直接读取，不需要再逐行调用 Chinese2Pinyin
+ * 数据使用隐式共享，可以复制一份在其他线程中保存
+ */
+class PinyinCache
+{
+public:
+    explicit PinyinCache(const QString &lang);
+
+    bool load();
+    bool save() const;
+
+    const PinyinKeys &keys(const QString &phrase);
+    inline bool isDirty() const { return m_dirty; }
+    inline void clearDirty() { m_dirty = false; }
+
+private:
+    static PinyinKeys createKeys(const QString &phrase);
+
+private:
+    QString m_path;
+    QHash<QString, PinyinKeys> m_keys;
+    bool m_dirty;
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "searchindex.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QVector>
+#include <QXmlStreamReader>
+
+#include <cstring>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::search;
+
+#ifndef SEARCH_INDEX_DIR
+#define SEARCH_INDEX_DIR "/usr/share/dde-control-center/search-index/"
+#endif
+
+const QString DCC_NAMESPACE::search::SearchIndexDirectory = SEARCH_INDEX_DIR;
+
+namespace {
+const char IndexMagic[8] = { 'D', 'C', 'C', 'S', 'I', 'D', 'X', '\0' };
+const quint32 IndexByteOrder = 0x01020304;
+
+const QString XML_Source = "source";
+const QString XML_Title = "translation";
+const QString XML_Numerusform = "numerusform";
+const QString XML_Explain_Path = "extra-contents_path";
+const QString XML_Child_Path = "extra-child_page";
+const QString XML_ChildHide_Path = "extra-child_page_hide";
+
+struct IndexHeader {
+    char magic[8];
+    quint32 version;
+    quint32 byteOrder;
+    quint32 entryCount;
+    quint32 childPageCount;
+    quint32 hiddenChildPageCount;
+    quint32 stringsOffset;
+    quint32 stringsLength;      // QChar 个数
+    quint32 reserved;
+    quint32 buildVersionOffset; // 生成索引时的构建版本，用于校验索引是否过期
+    quint32 buildVersionLength;
+};
+
+// 字符串在字符串区中的位置，单位为 QChar
+struct StringRef {
+    quint32 offset;
+    quint32 length;
+};
+
+const int EntryFieldCount = 4;
+
+class StringTable
+{
+public:
+    StringRef add(const QString &str)
+    {
+        StringRef ref { quint32(m_data.size()), quint32(str.size()) };
+        m_data.append(str);
+        return ref;
+    }
+
+    inline const QString &data() const { return m_data; }
+
+private:
+    QString m_data;
+};
+}
+
+bool SearchIndex::parseTranslation(QIODevice *device, SearchIndexData &data)
+{
+    QXmlStreamReader xmlRead(device);
+    QString xmlExplain;
+    SearchIndexEntry entry;
+
+    //遍历XML文件,读取每一行的xml数据都会
+    //先进入StartElement读取出<>中的内容;
+    //再进入Characters读取出中间数据部分;
+    //最后进入时进入EndElement读取出</>中的内容
+    while (!xmlRead.atEnd()) {
+        switch (xmlRead.readNext()) {
+        case QXmlStreamReader::StartElement:
+            xmlExplain = xmlRead.name().toString();
+            break;
+        case QXmlStreamReader::Characters:
+            if (xmlRead.isWhitespace())
+                break;
+
+            if (xmlExplain == XML_Source) {
+                entry.source = xmlRead.text().toString();
+                entry.translation = entry.source;
+            } else if (xmlExplain == XML_Title || xmlExplain == XML_Numerusform) {
+                // translation not nullptr can set it
+                entry.translation = xmlRead.text().toString();
+            } else if (xmlExplain == XML_Child_Path) {
+                entry.childPage = xmlRead.text().toString();
+                if (!data.childPages.contains(entry.childPage))
+                    data.childPages.append(entry.childPage);
+            } else if (xmlExplain == XML_ChildHide_Path) {
+                const QString hideChildPage = xmlRead.text().toString();
+                if (!data.hiddenChildPages.contains(hideChildPage))
+                    data.hiddenChildPages.append(hideChildPage);
+            } else if (xmlExplain == XML_Explain_Path) {
+                entry.contentsPath = xmlRead.text().toString();
+                entry.translation = entry.translation.remove('/').trimmed();
+                if (!entry.translation.isEmpty())
+                    data.entries.append(entry);
+                entry = SearchIndexEntry();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (xmlRead.hasError()) {
+        qWarning() << " [SearchIndex] parse translation failed:" << xmlRead.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool SearchIndex::write(const SearchIndexData &data, const QString &buildVersion, QIODevice *device)
+{
+    StringTable strings;
+    const StringRef version = strings.add(buildVersion);
+    QVector<StringRef> refs;
+    refs.reserve(data.entries.size() * EntryFieldCount + data.childPages.size() + data.hiddenChildPages.size());
+
+    for (const SearchIndexEntry &entry : data.entries) {
+        refs << strings.add(entry.source)
+             << strings.add(entry.translation)
+             << strings.add(entry.childPage)
+             << strings.add(entry.contentsPath);
+    }
+    for (const QString &page : data.childPages)
+        refs << strings.add(page);
+    for (const QString &page : data.hiddenChildPages)
+        refs << strings.add(page);
+
+    IndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, IndexMagic, sizeof(IndexMagic));
+    header.version = FormatVersion;
+    header.byteOrder = IndexByteOrder;
+    header.entryCount = quint32(data.entries.size());
+    header.childPageCount = quint32(data.childPages.size());
+    header.hiddenChildPageCount = quint32(data.hiddenChildPages.size());
+    header.stringsOffset = quint32(sizeof(IndexHeader) + sizeof(StringRef) * size_t(refs.size()));
+    header.stringsLength = quint32(strings.data().size());
+    header.buildVersionOffset = version.offset;
+    header.buildVersionLength = version.length;
+
+    const qint64 refsSize = qint64(sizeof(StringRef)) * refs.size();
+    const qint64 stringsSize = qint64(sizeof(QChar)) * strings.data().size();
+    return device->write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header))
+           && device->write(reinterpret_cast<const char *>(refs.constData()), refsSize) == refsSize
+           && device->write(reinterpret_cast<const char *>(strings.data().constData()), stringsSize) == stringsSize;
+}
+
+QString SearchIndex::buildVersion()
+{
+#ifdef CVERSION
+    return QString(CVERSION);
+#else
+    return QString();
+#endif
+}
+
+QString SearchIndex::indexPath(const QString &translationPath)
+{
+    return SearchIndexDirectory + QFileInfo(translationPath).completeBaseName() + ".idx";
+}
+
+SearchIndex::~SearchIndex()
+{
+    close();
+}
+
+bool SearchIndex::open(const QString &path, const QString &buildVersion)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(IndexHeader))) {
+        close();
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        close();
+        return false;
+    }
+
+    const IndexHeader *header = reinterpret_cast<const IndexHeader *>(m_data);
+    const qint64 refCount = qint64(header->entryCount) * EntryFieldCount + header->childPageCount + header->hiddenChildPageCount;
+    const bool valid = memcmp(header->magic, IndexMagic, sizeof(IndexMagic)) == 0
+                       && header->version == FormatVersion
+                       && header->byteOrder == IndexByteOrder
+                       && qint64(header->stringsOffset) == qint64(sizeof(IndexHeader)) + qint64(sizeof(StringRef)) * refCount
+                       && qint64(header->stringsOffset) + qint64(sizeof(QChar)) * header->stringsLength <= m_size
+                       && stringAt(header->buildVersionOffset, header->buildVersionLength) == buildVersion;
+    if (!valid) {
+        qWarning() << " [SearchIndex] invalid or outdated index:" << path;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void SearchIndex::close()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+
+    m_data = nullptr;
+    m_size = 0;
+    m_file.close();
+}
+
+QString SearchIndex::stringAt(quint32 offset, quint32 length) const
+{
+    const IndexHeader *header = reinterpret_cast<const IndexHeader *>(m_data);
+    if (quint64(offset) + length > header->stringsLength)
+        return QString();
+
+    const QChar *strings = reinterpret_cast<const QChar *>(m_data + header->stringsOffset);
+    return QString(strings + offset, int(length));
+}
+
+bool SearchIndex::read(SearchIndexData &data) const
+{
+    if (!isValid())
+        return false;
+
+    const IndexHeader *header = reinterpret_cast<const IndexHeader *>(m_data);
+    const StringRef *refs = reinterpret_cast<const StringRef *>(m_data + sizeof(IndexHeader));
+
+    data.entries.reserve(data.entries.size() + int(header->entryCount));
+    for (quint32 i = 0; i < header->entryCount; ++i) {
+        const StringRef *ref = refs + i * EntryFieldCount;
+        SearchIndexEntry entry;
+        entry.source = stringAt(ref[0].offset, ref[0].length);
+        entry.translation = stringAt(ref[1].offset, ref[1].length);
+        entry.childPage = stringAt(ref[2].offset, ref[2].length);
+        entry.contentsPath = stringAt(ref[3].offset, ref[3].length);
+        data.entries.append(entry);
+    }
+
+    refs += header->entryCount * EntryFieldCount;
+    for (quint32 i = 0; i < header->childPageCount; ++i, ++refs) {
+        const QString page = stringAt(refs->offset, refs->length);
+        if (!data.childPages.contains(page))
+            data.childPages.append(page);
+    }
+    for (quint32 i = 0; i < header->hiddenChildPageCount; ++i, ++refs) {
+        const QString page = stringAt(refs->offset, refs->length);
+        if (!data.hiddenChildPages.contains(page))
+            data.hiddenChildPages.append(page);
+    }
+
+    return true;
+}
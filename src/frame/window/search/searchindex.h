@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+// 编译期由 dcc-search-index-generator 生成的搜索索引存放目录
+extern const QString SearchIndexDirectory;
+
+// 从 .ts 文件中提取出的一条原始搜索数据，未经过模块名/子页面名翻译
+struct SearchIndexEntry {
+    QString source;         // <source>
+    QString translation;    // <translation>/<numerusform>，为空时使用 source
+    QString childPage;      // <extra-child_page>
+    QString contentsPath;   // <extra-contents_path>
+};
+
+struct SearchIndexData {
+    QList<SearchIndexEntry> entries;
+    QStringList childPages;         // 所有 <extra-child_page>
+    QStringList hiddenChildPages;   // 所有 <extra-child_page_hide>
+};
+
+/**
+ * @brief The SearchIndex class
+ * 搜索索引的二进制格式：
+ *   Header | entries(StringRef * 4 * entryCount) | childPages(StringRef) | hiddenChildPages(StringRef) | UTF-16 字符串区
+ * 文件按本机字节序写入，读取时使用 mmap 只读映射，不做任何 XML 解析
+ */
+class SearchIndex
+{
+public:
+    enum { FormatVersion = 2 };
+
+    // 解析 .ts 文件，提取所有带有 extra-contents_path 的搜索数据
+    static bool parseTranslation(QIODevice *device, SearchIndexData &data);
+    static bool write(const SearchIndexData &data, const QString &buildVersion, QIODevice *device);
+
+    // 索引和控制中心在同一次构建中生成，版本不同时认为索引已过期
+    static QString buildVersion();
+
+    // 根据 .ts 文件路径获取对应的索引文件路径
+    static QString indexPath(const QString &translationPath);
+
+public:
+    SearchIndex() = default;
+    ~SearchIndex();
+
+    bool open(const QString &path, const QString &buildVersion);
+    void close();
+    inline bool isValid() const { return m_data != nullptr; }
+
+    bool read(SearchIndexData &data) const;
+
+private:
+    Q_DISABLE_COPY(SearchIndex)
+
+    QString stringAt(quint32 offset, quint32 length) const;
+
+private:
+    QFile m_file;
+    const uchar *m_data{nullptr};
+    qint64 m_size{0};
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
@@ -3,31 +3,29 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "searchmodel.h"
+#include "searchindex.h"
+#include "pinyincache.h"
+#include "window/tracer.h"
 #include "window/utils.h"
 
-#include <DPinyin>
 #include <QDebug>
-#include <QRegularExpression>
 #include <QFutureWatcher>
 #include <QtConcurrent>
 
 #define DEBUG_XML_SWITCH 0
 
-const QString XML_Source = "source";
-const QString XML_Title = "translation";
-const QString XML_Numerusform = "numerusform";
-const QString XML_Explain_Path = "extra-contents_path";
-const QString XML_Child_Path = "extra-child_page";
-const QString XML_ChildHide_Path = "extra-child_page_hide";
-
 using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::search;
 
+//Qt::UserRole中多个搜索关键字之间的分隔符，不会出现在输入内容中
+static const QChar SearchKeySeparator(0x1f);
+
 SearchModel::SearchModel(QObject *parent)
     : QStandardItemModel(parent)
     , m_bIsChinese(false)
     , m_bIstextEdited(false)
     , m_dataUpdateCompleted(false)
+    , m_nextDocId(0)
 {
     //左边是从从xml解析出来的数据，右边是需要被翻译成的数据；
     //后续若还有相同模块还有一样的翻译文言，也可在此处添加类似处理，并在注释处添加　//~ child_page xxx
@@ -51,18 +49,19 @@ int SearchModel::getDataNum(QString source, char value)
 
 void SearchModel::getJumpPath(QString &moduleName, QString &pageName, const QString &searchName)
 {
-    if (m_EnterNewPagelist.count() > 0) {
-        SearchBoxStruct::Ptr data = getModuleBtnString(searchName);
-        if (data->translateContent != "" && data->fullPagePath != "") {
-            for (int i = 0; i < m_EnterNewPagelist.count(); i++) {
-                if (m_EnterNewPagelist[i]->translateContent == data->fullPagePath
-                        && m_EnterNewPagelist[i]->childPageName.isEmpty()
-                        && m_EnterNewPagelist[i]->actualModuleName == data->translateContent) {
-                    moduleName = data->actualModuleName;
-                    pageName = m_EnterNewPagelist[i]->fullPagePath.section('/', 2, -1);
-                    break;
-                }
-            }
+    SearchBoxStruct::Ptr data = getModuleBtnString(searchName);
+    if (data->translateContent == "" || data->fullPagePath == "")
+        return;
+
+    auto moduleData = m_moduleData.constFind(data->translateContent);
+    if (moduleData == m_moduleData.constEnd())
+        return;
+
+    for (const SearchBoxStruct::Ptr &item : moduleData->enterNewPageList) {
+        if (item->translateContent == data->fullPagePath && item->childPageName.isEmpty()) {
+            moduleName = data->actualModuleName;
+            pageName = item->fullPagePath.section('/', 2, -1);
+            break;
         }
     }
 }
@@ -103,9 +102,9 @@ bool SearchModel::jumpContentPathWidget(const QString &path)
             isContinue = true;
         }
     } else {
-        //searchEndData不为空，且搜索数据包含在m_TxtListAll可以执行
+        //searchEndData不为空，且搜索数据包含在模块的txtList可以执行
         //对非xml添加的搜索数据内容不作处理, 不在list里面就停止
-        if (m_TxtListAll.contains(searchEndData))
+        if (containsTxtData(searchEndData))
             isContinue = true;
     }
 
@@ -115,31 +114,31 @@ bool SearchModel::jumpContentPathWidget(const QString &path)
     //其他语言的模块数据 : 网络
     QString searchModule = path.section('-', 0, 1).remove('-').trimmed();
 
-    for (int i = 0; i < m_EnterNewPagelist.count(); i++) {
-        //SearchBoxStruct::Ptr data = m_EnterNewPagelist[i]; //used to debug
-        /* m_EnterNewPagelist[i] 数据例子
+    auto moduleData = m_moduleData.constFind(searchModule);
+    if (moduleData == m_moduleData.constEnd())
+        return false;
+
+    for (const SearchBoxStruct::Ptr &item : moduleData->enterNewPageList) {
+        /* item 数据例子
            source : Interface
            translateContent : 接口
            actualModuleName : 网络
            childPageName : 网络详情
            fullPagePath : /network/Network Details
         */
-        QString childPageName = m_EnterNewPagelist[i]->childPageName;
-        QString fullPagePath = m_EnterNewPagelist[i]->fullPagePath;
+        QString childPageName = item->childPageName;
+        QString fullPagePath = item->fullPagePath;
 
         //用于区分类似 "默认程序 -> 网页 / 添加默认程序" 和 "默认程序 -> 网页"
         if (childPageName == "" && searchChildWidget != searchDetailData) {
             continue;
         }
 
-        //搜索数据需要匹配的数据：模块，子页面，详细数据
-        if (m_EnterNewPagelist[i]->actualModuleName == searchModule
-                //匹配子页面和详细数据
-                && ((childPageName == searchChildWidget && m_EnterNewPagelist[i]->translateContent == searchEndData)
-                    //子页面为空，详细数据要相等
-                    || (childPageName == "" && m_EnterNewPagelist[i]->translateContent == searchChildWidget)
-                    )
-                ) {
+        //搜索数据需要匹配的数据：子页面，详细数据(模块已经通过searchModule匹配)
+        //匹配子页面和详细数据
+        if ((childPageName == searchChildWidget && item->translateContent == searchEndData)
+                //子页面为空，详细数据要相等
+                || (childPageName == "" && item->translateContent == searchChildWidget)) {
             //module必须有，childPageName可以为空
             QString module = fullPagePath.section('/', 1, 1);
             QString childWidget = "";
@@ -149,13 +148,13 @@ bool SearchModel::jumpContentPathWidget(const QString &path)
                 childWidget = fullPagePath.section('/', 2, -1);
                 qInfo() << " [Search] childWidgetCount : 3 , childWidget :" << childWidget;
             } else {
-                //插件的m_EnterNewPagelist[i]->childPageName为空
+                //插件的item->childPageName为空
                 if (childPageName == "" || childPageName == searchChildWidget) {
                     childWidget = fullPagePath.section('/', 2, -1);
                 }
 
                 if (childWidget == "") {
-                    childWidget = m_EnterNewPagelist[i]->source;
+                    childWidget = item->source;
                 }
             }
             qInfo() << " search result > module : " << module << " , widget : " << childWidget;
@@ -169,25 +168,80 @@ bool SearchModel::jumpContentPathWidget(const QString &path)
 
 void SearchModel::loadxml(const QString module)
 {
-    Q_UNUSED(module)
+    DCC_TRACE_SCOPE("search", "loadxml", module);
+    if (!module.isEmpty()) {
+        loadModuleData(module);
+        return;
+    }
 
     clear(); // It doesn't seem to leak memory
-    m_EnterNewPagelist.clear();
-    m_inputList.clear();
-    m_TxtListAll.clear();
+    m_textIndex.clear();
+    m_searchItems.clear();
+    m_moduleOrder.clear();
+    for (SearchModuleData &data : m_moduleData) {
+        data.originList.clear();
+        data.enterNewPageList.clear();
+        data.inputList.clear();
+        data.txtList.clear();
+        data.docIds.clear();
+        data.rowCount = 0;
+    }
 
     //添加一项空数据，为了防止使用setText输入错误数据时直接跳转到list中正确的第一个页面
-    m_EnterNewPagelist.append(std::make_shared<SearchBoxStruct>());
-    m_inputList.append(SearchDataStruct());
     appendRow(new QStandardItem(""));
 
+    //按模块对搜索数据分组，每个模块在model中占用连续的行，模块数据变化时只需要重建该模块的行
+    for (const SearchBoxStruct::Ptr &searchBoxStrcut : m_originList) {
+        SearchModuleData &data = m_moduleData[searchBoxStrcut->actualModuleName];
+        if (data.originList.isEmpty())
+            m_moduleOrder.append(searchBoxStrcut->actualModuleName);
+        data.originList.append(searchBoxStrcut);
+    }
+
+    for (const QString &moduleName : m_moduleOrder) {
+        loadModuleData(moduleName);
+    }
+}
+
+void SearchModel::loadModuleData(const QString &module)
+{
+    auto it = m_moduleData.find(module);
+    if (it == m_moduleData.end())
+        return;
+
+    SearchModuleData &data = it.value();
+    data.dirty = false;
+
+    //模块在model中的起始行，第0行为空数据
+    int firstRow = 1;
+    for (const QString &moduleName : m_moduleOrder) {
+        if (moduleName == module)
+            break;
+        firstRow += m_moduleData.constFind(moduleName)->rowCount;
+    }
+
+    if (data.rowCount > 0)
+        removeRows(firstRow, data.rowCount);
+
+    for (int docId : data.docIds) {
+        m_textIndex.remove(docId);
+        m_searchItems.remove(docId);
+    }
+    data.docIds.clear();
+
+    data.enterNewPageList.clear();
+    data.inputList.clear();
+    data.txtList.clear();
+    data.rowCount = 0;
+
     bool isPlugins = false;
     bool bIsContinue = false;
     bool bIsTwoLevel = false;
     QString searchModule = "";
     QString searchData = "";
+    QList<QStandardItem *> items;
 
-    for (SearchBoxStruct::Ptr searchBoxStrcut : m_originList) {
+    for (SearchBoxStruct::Ptr searchBoxStrcut : data.originList) {
 
         searchModule = searchBoxStrcut->fullPagePath.section('/', 0, 1).remove('/').trimmed();
         searchData = searchBoxStrcut->fullPagePath.section('/', 2, -1).remove('/').trimmed();
@@ -249,10 +303,10 @@ void SearchModel::loadxml(const QString module)
             }
         }
 
-        m_EnterNewPagelist.append(searchBoxStrcut);
+        data.enterNewPageList.append(searchBoxStrcut);
         isPlugins = false;
 
-        m_TxtListAll.append(searchBoxStrcut->translateContent);
+        data.txtList.insert(searchBoxStrcut->translateContent);
 
         // Add search result content
         if (!m_bIsChinese) {
@@ -261,23 +315,73 @@ void SearchModel::loadxml(const QString module)
                 continue;
             }
 
+            QStandardItem *item = nullptr;
             if ("" == searchBoxStrcut->childPageName) {
-                appendRow(new QStandardItem(icon.value(), QString("%1 --> %2").arg(searchBoxStrcut->actualModuleName).arg(searchBoxStrcut->translateContent)));
+                item = new QStandardItem(icon.value(), QString("%1 --> %2").arg(searchBoxStrcut->actualModuleName).arg(searchBoxStrcut->translateContent));
             }
             else {
-                appendRow(new QStandardItem(
-                    icon.value(), QString("%1 --> %2 / %3").arg(searchBoxStrcut->actualModuleName).arg(searchBoxStrcut->childPageName).arg(searchBoxStrcut->translateContent)));
+                item = new QStandardItem(
+                    icon.value(), QString("%1 --> %2 / %3").arg(searchBoxStrcut->actualModuleName).arg(searchBoxStrcut->childPageName).arg(searchBoxStrcut->translateContent));
             }
 
             // 设置图标数据
-            setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
+            item->setData(icon->name(), Qt::UserRole + 1);
+            items << item;
         }
         else {
-            appendChineseData(searchBoxStrcut);
+            appendChineseData(searchBoxStrcut, items, data.inputList);
         }
 
-        m_TxtListAll.append(searchBoxStrcut->translateContent.remove('/').trimmed());
+        data.txtList.insert(searchBoxStrcut->translateContent.remove('/').trimmed());
+    }
+
+    const int weight = getModuleWeight(module);
+    for (int i = 0; i < items.size(); i++) {
+        QStandardItem *item = items.at(i);
+        insertRow(firstRow + i, item);
+
+        //中文的搜索关键字保存在Qt::UserRole中，其他语言直接搜索显示的内容
+        const QStringList keys = m_bIsChinese ? item->data(Qt::UserRole).toString().split(SearchKeySeparator)
+                                              : QStringList(item->text());
+        const int docId = m_nextDocId++;
+        m_textIndex.insert(docId, keys, weight);
+        m_searchItems.insert(docId, item);
+        data.docIds << docId;
+    }
+    data.rowCount = items.size();
+}
+
+//根据输入内容在倒排索引中查找，返回按匹配程度排序的搜索数据
+QList<QStandardItem *> SearchModel::search(const QString &text, int limit) const
+{
+    QList<QStandardItem *> items;
+    for (int docId : m_textIndex.search(text, limit)) {
+        if (QStandardItem *item = m_searchItems.value(docId))
+            items << item;
+    }
+
+    return items;
+}
+
+//模块的搜索权重，左侧导航中靠前的模块权重更高，插件模块排在最后
+int SearchModel::getModuleWeight(const QString &module) const
+{
+    for (int i = 0; i < m_moduleNameList.size(); ++i) {
+        if (m_moduleNameList.at(i).second == module)
+            return qMax(0, 100 - i);
     }
+
+    return 0;
+}
+
+bool SearchModel::containsTxtData(const QString &txt) const
+{
+    for (const SearchModuleData &data : m_moduleData) {
+        if (data.txtList.contains(txt))
+            return true;
+    }
+
+    return false;
 }
 
 //Follow display content to Analysis SearchBoxStruct data
@@ -293,7 +397,7 @@ SearchBoxStruct::Ptr SearchModel::getModuleBtnString(QString value)
     if (data->fullPagePath.contains('/', Qt::CaseInsensitive)) {
         QString strTemp = data->fullPagePath.section('/', 0, 0).remove('/').trimmed();
         //修复最终字段存在'/'无法跳转的问题
-        if (this->m_TxtListAll.contains(strTemp)) {
+        if (containsTxtData(strTemp)) {
             data->fullPagePath = strTemp;
         }
     }
@@ -327,143 +431,99 @@ QString SearchModel::getModulesName(const QString &name, bool state)
     return strResult;
 }
 
-QString SearchModel::removeDigital(QString input)
-{
-    if ("" == input)
-        return "";
-
-    QString value = "";
-    QByteArray ba = input.toLocal8Bit();
-    char *data = nullptr;
-    data = ba.data();
-    while (*data) {
-        if (!(*data >= '0' && *data <= '9')) {
-            value += *data;
-        }
-        data++;
-    }
-
-    return value;
-}
-
 QString SearchModel::transPinyinToChinese(const QString &pinyin)
 {
-    QString value = pinyin;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    auto res = std::find_if(m_inputList.begin(), m_inputList.end(), [=] (const SearchDataStruct data)->bool{
-            return value == data.pinyin;
-        });
-
-        if (res != m_inputList.end()) {
-            value =(*res).chiese;
-        }
+    //在"拼音-汉字"表中查找,将存在的"拼音"转换为"汉字"
+    for (const QString &module : m_moduleOrder) {
+        const QHash<QString, QString> &inputList = m_moduleData.constFind(module)->inputList;
+        auto it = inputList.constFind(pinyin);
+        if (it != inputList.constEnd())
+            return it.value();
+    }
 
-    return value;
+    return pinyin;
 }
 
 QString SearchModel::containTxtData(QString txt)
 {
-    QString value = txt;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    auto res = std::find_if(m_inputList.begin(), m_inputList.end(), [=] (const SearchDataStruct data)->bool{
-                return (data.chiese.contains(txt, Qt::CaseInsensitive) ||
-                        data.pinyin.contains(txt, Qt::CaseInsensitive));
-            });
-
-            if (res != m_inputList.end()) {
-                value = (*res).chiese;
-            }
+    //遍历"拼音-汉字"表,将存在的"拼音"转换为"汉字"
+    for (const QString &module : m_moduleOrder) {
+        const QHash<QString, QString> &inputList = m_moduleData.constFind(module)->inputList;
+        for (auto it = inputList.constBegin(); it != inputList.constEnd(); ++it) {
+            if (it.value().contains(txt, Qt::CaseInsensitive) ||
+                    it.key().contains(txt, Qt::CaseInsensitive))
+                return it.value();
+        }
+    }
 
-    return value;
+    return txt;
 }
 
-void SearchModel::appendChineseData(SearchBoxStruct::Ptr data)
+void SearchModel::appendChineseData(SearchBoxStruct::Ptr data, QList<QStandardItem *> &items, QHash<QString, QString> &inputList)
 {
     auto icon = m_iconMap.find(data->fullPagePath.section('/', 1, 1));
     if (icon == m_iconMap.end()) {
         return;
     }
 
-    // 其他函数存在修改智能指针的数值，复制一份解决。
-    SearchBoxStruct::Ptr dataBackup(new SearchBoxStruct(*data));
-
-    if ("" == dataBackup->childPageName) {
-        //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
-        //Qt::EditRole数据用于显示搜索到的结果(汉字)
-        //Qt::UserRole数据用于输入框输入的数据(拼音/汉字 均可)
-        //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::EditRole的数据
-        appendRow(new QStandardItem(icon.value(),
-                                    QString("%1 --> %2").arg(dataBackup->actualModuleName).arg(dataBackup->translateContent)));
-
-        //设置汉字的Qt::UserRole数据
-        setData(index(rowCount() - 1, 0),
-                         QString("%1 --> %2")
-                         .arg(dataBackup->actualModuleName)
-                         .arg(dataBackup->translateContent),
-                         Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
-
-        QString hanziTxt = QString("%1 --> %2").arg(dataBackup->actualModuleName).arg(dataBackup->translateContent);
-
-        QString pinyinTxt = QString("%1 --> %2")
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->translateContent.remove(QRegularExpression(R"([a-zA-Z]+)")))));
-
-        // 如果模块名称中英文相同则不继续添加拼音搜索显示,否则会重复索引
-        // guoyao：针对Union ID（中文环境使用英文模块名），dataBackup->actualModuleName将被过滤为空，所以会return掉；但是data数据并不会更改，所以用data数据进行判断即可
-        if (data->actualModuleName == DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName)) return;
-
-        //添加显示的汉字(用于拼音搜索显示)
-        appendRow(new QStandardItem(icon.value(), hanziTxt));
-        //设置Qt::UserRole搜索的拼音(即搜索拼音会显示上面的汉字)
-        setData(index(rowCount() - 1, 0), pinyinTxt, Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
-        SearchDataStruct transdata;
-        transdata.chiese = hanziTxt;
-        transdata.pinyin = pinyinTxt;
-        //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
-        //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
-        m_inputList.append(transdata);
-    } else {
-        //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
-        //Qt::EditRole数据用于显示搜索到的结果(汉字)
-        //Qt::UserRole数据用于输入框输入的数据(拼音/汉字 均可)
-        //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::EditRole的数据
-        appendRow(new QStandardItem(icon.value(),
-                                    QString("%1 --> %2 / %3").arg(dataBackup->actualModuleName).arg(dataBackup->childPageName).arg(dataBackup->translateContent)));
-
-        //设置汉字的Qt::UserRole数据
-        setData(index(rowCount() - 1, 0),
-                         QString("%1 --> %2 / %3")
-                         .arg(dataBackup->actualModuleName)
-                         .arg(dataBackup->childPageName)
-                         .arg(dataBackup->translateContent),
-                         Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
-
-        QString hanziTxt = QString("%1 --> %2 / %3").arg(dataBackup->actualModuleName).arg(dataBackup->childPageName).arg(dataBackup->translateContent);
-        QString pinyinTxt = QString("%1 --> %2 / %3")
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->childPageName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->translateContent.remove(QRegularExpression(R"([a-zA-Z]+)")))));
-        //添加显示的汉字(用于拼音搜索显示)
-        auto icons = m_iconMap.find(dataBackup->fullPagePath.section('/', 1, 1));
-        if (icons == m_iconMap.end()) {
-            return;
+    QStringList names;
+    names << data->actualModuleName;
+    if (!data->childPageName.isEmpty())
+        names << data->childPageName;
+    names << data->translateContent;
+
+    //拼音从缓存中获取，每个短语只在第一次使用时计算
+    QList<const PinyinKeys *> pinyins;
+    for (const QString &name : names)
+        pinyins << &m_pinyinCache->keys(name);
+
+    //按 "模块 --> 子页面 / 搜索项" 的格式拼接
+    auto joinText = [](const QStringList &parts) {
+        return parts.size() == 2 ? QString("%1 --> %2").arg(parts[0], parts[1])
+                                 : QString("%1 --> %2 / %3").arg(parts[0], parts[1], parts[2]);
+    };
+
+    //每条搜索数据只占用一行：Qt::DisplayRole为汉字(用于下拉框显示)
+    //Qt::UserRole为全部搜索关键字(汉字、全拼、首字母、多音字读音)，用于输入框搜索(拼音/汉字 均可)
+    //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::DisplayRole的数据
+    const QString hanziTxt = joinText(names);
+    QStringList keys;
+    keys << hanziTxt;
+
+    QStringList pinyinParts;
+    QString initials;
+    for (const PinyinKeys *pinyin : pinyins) {
+        pinyinParts << pinyin->pinyin.value(0);
+        initials += pinyin->initials;
+    }
+
+    // 如果数据中没有汉字(如Union ID)则不添加拼音搜索关键字,否则会重复索引
+    if (!initials.isEmpty()) {
+        keys << joinText(pinyinParts);
+        if (!keys.contains(initials))
+            keys << initials;
+
+        //多音字的其他读音，每次只替换一个短语的读音，避免组合数量过多
+        for (int i = 0; i < pinyins.size(); ++i) {
+            for (int j = 1; j < pinyins[i]->pinyin.size(); ++j) {
+                QStringList parts = pinyinParts;
+                parts[i] = pinyins[i]->pinyin[j];
+                keys << joinText(parts);
+            }
         }
-        appendRow(new QStandardItem(icons.value(), hanziTxt));
-        //设置Qt::UserRole搜索的拼音(即搜索拼音会显示上面的汉字)
-        setData(index(rowCount() - 1, 0), pinyinTxt, Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icons->name(), Qt::UserRole + 1);
-        SearchDataStruct transdata;
-        transdata.chiese = hanziTxt;
-        transdata.pinyin = pinyinTxt;
-        //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
-        //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
-        m_inputList.append(transdata);
     }
+
+    QStandardItem *item = new QStandardItem(icon.value(), hanziTxt);
+    const QString searchKeys = keys.join(SearchKeySeparator);
+    item->setData(searchKeys, Qt::UserRole);
+    item->setData(icon->name(), Qt::UserRole + 1);
+    items << item;
+
+    //存储 拼音和汉字 : 在选择对应的下拉框数据后,可能将Qt::UserRole数据或其中的拼音设置到输入框
+    //根据拼音获取到对应汉字,再将汉字设置到输入框
+    inputList.insert(searchKeys, hanziTxt);
+    for (int i = 1; i < keys.size(); ++i)
+        inputList.insert(keys[i], hanziTxt);
 }
 
 //主要用于解决一些特殊数据，比如同时加载了二级和三级页面搜索数据，而要删除二级页面数据； true : 不加载
@@ -484,31 +544,57 @@ void SearchModel::setLanguage(const QString &type)
         m_bIsChinese = true;
     }
 
-    QFutureWatcher<QList<SearchBoxStruct::Ptr>>* watcher = new QFutureWatcher<QList<SearchBoxStruct::Ptr>>();
-    connect(watcher, &QFutureWatcher<QList<SearchBoxStruct::Ptr>>::finished, this, [=] {
-        m_originList = watcher->result();
+    //拼音缓存在加载搜索数据的线程中读取，加载完成后只在主线程中使用
+    std::shared_ptr<PinyinCache> pinyinCache;
+    if (m_bIsChinese)
+        pinyinCache = std::make_shared<PinyinCache>(type);
+
+    QFutureWatcher<SearchIndexData>* watcher = new QFutureWatcher<SearchIndexData>();
+    connect(watcher, &QFutureWatcher<SearchIndexData>::finished, this, [=] {
+        m_originList = createSearchList(watcher->result());
+        m_pinyinCache = pinyinCache;
         watcher->deleteLater();
         loadxml();
         m_dataUpdateCompleted = true;
-
+        Q_EMIT searchDataLoaded();
+
+        //有新计算的拼音时写回缓存，复制一份在线程中保存
+        if (m_pinyinCache && m_pinyinCache->isDirty()) {
+            const PinyinCache cache = *m_pinyinCache;
+            m_pinyinCache->clearDirty();
+            QtConcurrent::run([cache] {
+                if (!cache.save())
+                    qWarning() << " [SearchWidget] save pinyin cache failed";
+            });
+        }
     });
 
     m_childeHideWidgetList.clear();
 
-    watcher->setFuture(QtConcurrent::run([=] {
-        QList<SearchBoxStruct::Ptr> list;
+    //解决历史遗留问题，适配已经存在的插件搜索数据(不需要翻译,只要第二个字符串不为空即可)
+    m_transPlusData = {
+        //plugin : input
+        { "Manage Input Methods", "Manage Input Methods" }
 
-        //解决历史遗留问题，适配已经存在的插件搜索数据(不需要翻译,只要第二个字符串不为空即可)
-        m_transPlusData = {
-            //plugin : input
-            { "Manage Input Methods", "Manage Input Methods" }
+    };
 
-        };
+    const QStringList xmlPaths = m_xmlFilePath.values();
+    const QString lang = m_lang;
+    watcher->setFuture(QtConcurrent::run([xmlPaths, lang, pinyinCache] {
+        DCC_TRACE_SCOPE("search", "loadIndex", lang);
+        SearchIndexData data;
 #if DEBUG_XML_SWITCH
         qDebug() << " [SearchWidget] " << Q_FUNC_INFO;
 #endif
-        for (const QString &i : m_xmlFilePath) {
-            QString xmlPath = i.arg(m_lang);
+        for (const QString &i : xmlPaths) {
+            QString xmlPath = i.arg(lang);
+
+            //优先使用编译时生成的二进制索引，索引不存在或已过期时再解析xml
+            SearchIndex index;
+            if (index.open(SearchIndex::indexPath(xmlPath), SearchIndex::buildVersion()) && index.read(data)) {
+                continue;
+            }
+
             QFile   file(xmlPath);
 
             if (!file.exists()) {
@@ -521,108 +607,77 @@ void SearchModel::setLanguage(const QString &type)
                 continue;
             }
 
-            QXmlStreamReader            xmlRead(&file);
-            QStringRef                  dataName;
-            SearchBoxStruct::Ptr searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-            QString xmlExplain;
-
-            //遍历XML文件,读取每一行的xml数据都会
-            //先进入StartElement读取出<>中的内容;
-            //再进入Characters读取出中间数据部分;
-            //最后进入时进入EndElement读取出</>中的内容
-            QString strSource = "";
-            while (!xmlRead.atEnd()) {
-                switch (xmlRead.readNext()) {
-                    case QXmlStreamReader::StartElement:
-#if DEBUG_XML_SWITCH
-                        qDebug() << " [SearchWidget] +::StartElement: " << xmlRead.name() << xmlRead.text();
-#endif
-                        xmlExplain = xmlRead.name().toString();
-                        break;
-                    case QXmlStreamReader::Characters:
-                        if (!xmlRead.isWhitespace()) {
-#if DEBUG_XML_SWITCH
-                            qDebug() << " [SearchWidget]  xmlRead.text : " << xmlRead.text().toString();
-#endif
-                            if (xmlExplain == XML_Source) {  // get xml source date
-                                searchBoxStrcut->translateContent = xmlRead.text().toString().remove('/').trimmed();
-                                searchBoxStrcut->source = xmlRead.text().toString();
-                                strSource = xmlRead.text().toString();
-                            }
-                            else if (xmlExplain == XML_Title) {
-                                if (xmlRead.text().toString() != "")  // translation not nullptr can set it
-                                    searchBoxStrcut->translateContent = xmlRead.text().toString().remove('/').trimmed();
-#if DEBUG_XML_SWITCH
-                                qDebug() << " [SearchWidget] searchBoxStrcut->translateContent : " << searchBoxStrcut->translateContent;
-#endif
-                            }
-                            else if (xmlExplain == XML_Numerusform) {
-                                if (xmlRead.text().toString() != "")  // translation not nullptr can set it
-                                    searchBoxStrcut->translateContent = xmlRead.text().toString().remove('/').trimmed();
-                            }
-                            else if (XML_Child_Path == xmlExplain) {
-                                QString childPage = m_transChildPageName.value(xmlRead.text().toString());
-                                if (childPage == "") {
-                                    childPage = xmlRead.text().toString();
-                                    qWarning() << " [SearchWidget]  child page can't translate. childPage : " << childPage;
-                                }
-                                searchBoxStrcut->childPageName = childPage;
-                                if (!m_childWidgetList.contains(childPage))
-                                    m_childWidgetList.append(childPage);
-                            }
-                            else if (XML_ChildHide_Path == xmlExplain) {
-                                //添加二级页面和三级页面都要进入的搜索数据，类似 ： "默认程序 -> 网页 / 添加默认程序" 和 "默认程序 -> 网页"
-                                //以上两种数据都需要搜索，因此需要保存一个特殊的子页面list
-                                QString hideChildPage = m_transChildPageName.value(xmlRead.text().toString());
-                                if (!m_childeHideWidgetList.contains(hideChildPage)) {
-                                    m_childeHideWidgetList.append(hideChildPage);
-                                }
-                            }
-                            else if (xmlExplain == XML_Explain_Path) {
-                                searchBoxStrcut->fullPagePath = xmlRead.text().toString();
-                                // follow path module name to get actual module name  ->  Left module dispaly can support
-                                // mulLanguages
-                                searchBoxStrcut->actualModuleName = getModulesName(searchBoxStrcut->fullPagePath.section('/', 1, 1));
-
-                                if ("" == searchBoxStrcut->actualModuleName || "" == searchBoxStrcut->translateContent) {
-                                    searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                    continue;
-                                }
-
-                                //判断是否非社区版，如果是非社区版本，屏蔽镜像源列表
-                                if (!IsCommunitySystem) {
-                                    if("Smart Mirror Switch" == strSource
-                                            || "Switch it on to connect to the quickest mirror site automatically" == strSource
-                                            || "System Repository Detection" == strSource
-                                            || "Mirror List" == strSource) {
-                                        searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                        continue;
-                                    }
-                                }
-
-                                list << searchBoxStrcut;
-                                searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                            }
-                        }
-                        break;
-                    case QXmlStreamReader::EndElement:
-#if DEBUG_XML_SWITCH
-                        qDebug() << " [SearchWidget] -::EndElement: " << xmlRead.name();
-#endif
-                        break;
-                    default: break;
-                }
-            }
-
-            qDebug() << " [SearchWidget] m_EnterNewPagelist.count : " << m_EnterNewPagelist.count();
-
+            SearchIndex::parseTranslation(&file, data);
             file.close();
         }
 
-        return list;
+        //提前准备好搜索项的拼音，模块名和子页面名在主线程翻译后再获取
+        if (pinyinCache) {
+            pinyinCache->load();
+            for (const SearchIndexEntry &entry : data.entries)
+                pinyinCache->keys(entry.translation);
+        }
+
+        return data;
     }));
 }
 
+QList<SearchBoxStruct::Ptr> SearchModel::createSearchList(const SearchIndexData &data)
+{
+    QList<SearchBoxStruct::Ptr> list;
+
+    for (const QString &page : data.childPages) {
+        QString childPage = m_transChildPageName.value(page);
+        if (childPage == "") {
+            childPage = page;
+            qWarning() << " [SearchWidget]  child page can't translate. childPage : " << childPage;
+        }
+        if (!m_childWidgetList.contains(childPage))
+            m_childWidgetList.append(childPage);
+    }
+
+    //添加二级页面和三级页面都要进入的搜索数据，类似 ： "默认程序 -> 网页 / 添加默认程序" 和 "默认程序 -> 网页"
+    //以上两种数据都需要搜索，因此需要保存一个特殊的子页面list
+    for (const QString &page : data.hiddenChildPages) {
+        QString hideChildPage = m_transChildPageName.value(page);
+        if (!m_childeHideWidgetList.contains(hideChildPage)) {
+            m_childeHideWidgetList.append(hideChildPage);
+        }
+    }
+
+    for (const SearchIndexEntry &entry : data.entries) {
+        SearchBoxStruct::Ptr searchBoxStrcut = std::make_shared<SearchBoxStruct>();
+        searchBoxStrcut->source = entry.source;
+        searchBoxStrcut->translateContent = entry.translation;
+        searchBoxStrcut->fullPagePath = entry.contentsPath;
+        if (!entry.childPage.isEmpty()) {
+            QString childPage = m_transChildPageName.value(entry.childPage);
+            searchBoxStrcut->childPageName = childPage.isEmpty() ? entry.childPage : childPage;
+        }
+        // follow path module name to get actual module name  ->  Left module dispaly can support
+        // mulLanguages
+        searchBoxStrcut->actualModuleName = getModulesName(searchBoxStrcut->fullPagePath.section('/', 1, 1));
+
+        if ("" == searchBoxStrcut->actualModuleName) {
+            continue;
+        }
+
+        //判断是否非社区版，如果是非社区版本，屏蔽镜像源列表
+        if (!IsCommunitySystem) {
+            if("Smart Mirror Switch" == entry.source
+                    || "Switch it on to connect to the quickest mirror site automatically" == entry.source
+                    || "System Repository Detection" == entry.source
+                    || "Mirror List" == entry.source) {
+                continue;
+            }
+        }
+
+        list << searchBoxStrcut;
+    }
+
+    return list;
+}
+
 //save all modules moduleInteface name and actual moduleName
 //moduleName : moduleInteface name  (used to path module to translate searchName)
 //searchName : actual module
@@ -651,7 +706,8 @@ bool SearchModel::getModuleVisible(const QString module)
         return false;
     }
 
-    return m_hideModuleList.value(module);
+    auto data = m_moduleData.constFind(module);
+    return data != m_moduleData.constEnd() && data->visible;
 }
 
 //获取模块内子页面是否显示
@@ -661,17 +717,8 @@ bool SearchModel::getWidgetVisible(const QString module, QString widget)
         return false;
     }
 
-    HideChildWidgetStruct value;
-    auto findModule = std::find_if(m_hideWidgetList.begin(), m_hideWidgetList.end(), [&module](const HideChildWidgetStruct& item) {
-        return (item.module == module);
-    });
-
-    if (findModule != m_hideWidgetList.end()) {
-        value = (*findModule);
-        return value.childWidgetMap.value(widget);
-    }
-
-    return false;
+    auto data = m_moduleData.constFind(module);
+    return data != m_moduleData.constEnd() && data->widgetVisible.value(widget);
 }
 
 //获取模块内子页面的搜索数据是否显示
@@ -681,27 +728,25 @@ bool SearchModel::getDetailVisible(const QString module, QString widget, QString
         return false;
     }
 
-    HideChildWidgetDetailStruct value;
-    auto findWidget = std::find_if(m_hideWidgetDetailList.begin(), m_hideWidgetDetailList.end(), [&module, &widget](const HideChildWidgetDetailStruct& item) {
-        return (item.module == module && item.childWidget == widget);
-    });
-
-    if (findWidget != m_hideWidgetDetailList.end()) {
-        value = (*findWidget);
-        return value.detailMap.value(detail);
+    auto data = m_moduleData.constFind(module);
+    if (data == m_moduleData.constEnd()) {
+        return false;
     }
 
-    return false;
+    auto details = data->detailVisible.constFind(widget);
+    return details != data->detailVisible.constEnd() && details->value(detail);
 }
 
 //设置模块是否显示
 void SearchModel::setModuleVisible(const QString &module, bool visible)
 {
-    if (module == "" || m_hideModuleList.value(module) == visible) {
+    if (module == "" || getModuleVisible(module) == visible) {
         return;
     }
 
-    m_hideModuleList.insert(module, visible);
+    SearchModuleData &data = m_moduleData[module];
+    data.visible = visible;
+    data.dirty = true;
 }
 
 //设置模块内子页面是否显示
@@ -711,69 +756,43 @@ void SearchModel::setWidgetVisible(const QString &module, const QString &widget,
         return;
     }
 
-    for (auto &data : m_hideWidgetList) {
-        if (data.module == module && data.childWidgetMap.contains(widget)) {
-            data.childWidgetMap.insert(widget, visible);
-            return;
-        }
+    SearchModuleData &data = m_moduleData[module];
+    auto it = data.widgetVisible.find(widget);
+    if (it != data.widgetVisible.end() && it.value() == visible) {
+        return;
     }
 
-    //以下为第一次新增数据
-    HideChildWidgetStruct value;
-    value.module = module;
-    value.childWidgetMap.insert(widget, visible);
-
-    int count = m_hideWidgetList.count();
-    if (count == 0) {
-        m_hideWidgetList.append(value);
-    } else {
-        for (int i = 0; i < count; i++) {
-            if (m_hideWidgetList[i].module == module) {
-                m_hideWidgetList[i].childWidgetMap.insert(widget, visible);
-                return;
-            }
-            if (i == count - 1) {
-                m_hideWidgetList.append(value);
-            }
-        }
-    }
+    data.widgetVisible.insert(widget, visible);
+    data.dirty = true;
 }
 
 //设置模块内子页面的详细搜索数据是否显示
 void SearchModel::setDetailVisible(const QString &module, const QString &widget, const QString &detail, bool visible)
 {
-    for (auto &data : m_hideWidgetDetailList) {
-        if (data.module == module && data.childWidget == widget && data.detailMap.contains(detail)) {
-            data.detailMap.insert(detail, visible);
-            return;
-        }
+    SearchModuleData &data = m_moduleData[module];
+    QHash<QString, bool> &details = data.detailVisible[widget];
+    auto it = details.find(detail);
+    if (it != details.end() && it.value() == visible) {
+        return;
     }
 
-    //以下为第一次新增数据
-    HideChildWidgetDetailStruct value;
-    value.module = module;
-    value.childWidget = widget;
-    value.detailMap.insert(detail, visible);
-
-    int count = m_hideWidgetDetailList.count();
-    if (count == 0) {
-        m_hideWidgetDetailList.append(value);
-    } else {
-        for (int i = 0; i < count; i++) {
-            if (m_hideWidgetDetailList[i].module == module && m_hideWidgetDetailList[i].childWidget == widget) {
-                m_hideWidgetDetailList[i].detailMap.insert(detail, visible);
-                return;
-            }
-            if (i == count -1) {
-                m_hideWidgetDetailList.append(value);
-            }
-        }
-    }
+    details.insert(detail, visible);
+    data.dirty = true;
 }
 
+//只重建module的搜索数据及其倒排索引，其他模块在model中的行保持不变
 void SearchModel::updateSearchData(const QString &module)
 {
     qDebug() << "updateSearchData:" << module;
+    if (!m_dataUpdateCompleted) {
+        return;
+    }
+
+    auto data = m_moduleData.constFind(module);
+    if (data == m_moduleData.constEnd() || !data->dirty) {
+        return;
+    }
+
     loadxml(module);
 }
 
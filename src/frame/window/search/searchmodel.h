@@ -5,9 +5,11 @@
 #pragma once
 
 #include "interface/namespace.h"
+#include "searchtextindex.h"
 
 #include <QStandardItemModel>
 #include <QSet>
+#include <QHash>
 
 #include <memory>
 
@@ -23,23 +25,23 @@ struct SearchBoxStruct {
     QString fullPagePath;
 };
 
-struct SearchDataStruct {
-    QString chiese;
-    QString pinyin;
+struct SearchIndexData;
+class PinyinCache;
+
+//每个模块的搜索数据及其可见性，模块的搜索数据在model中占用连续的行
+struct SearchModuleData {
+    bool visible{false};                                    //模块是否显示
+    QHash<QString, bool> widgetVisible;                     //子页面名称, 子页面是否显示
+    QHash<QString, QHash<QString, bool>> detailVisible;     //子页面名称, 详细搜索数据是否显示
+    QList<SearchBoxStruct::Ptr> originList;                 //模块全部的搜索数据
+    QList<SearchBoxStruct::Ptr> enterNewPageList;           //当前可以显示的搜索数据
+    QHash<QString, QString> inputList;                      //拼音搜索关键字, 汉字
+    QSet<QString> txtList;                                  //三级页面
+    QList<int> docIds;                                      //在倒排索引中的文档id
+    int rowCount{0};                                        //在model中占用的行数
+    bool dirty{true};                                       //可见性变化后需要重建
 };
 
-struct HideChildWidgetStruct {
-    QString module;                                     //子页面的模块
-    QMap<QString, bool> childWidgetMap;              //子页面名称, 子页面是否显示
-};
-
-struct HideChildWidgetDetailStruct {
-    QString module;                                     //子页面的模块，避免重复子页面名称
-    QString childWidget;                                //子页面名称
-    QMap<QString, bool> detailMap;                     //详细搜索数据是否显示
-};
-
-
 class SearchModel : public QStandardItemModel {
     Q_OBJECT
     friend class SearchWidget;
@@ -59,43 +61,47 @@ public:
     void setDetailVisible(const QString &module, const QString &widget, const QString &detail, bool visible);
     void updateSearchData(const QString &module);
     void getJumpPath(QString &moduleName, QString &pageName, const QString &searchName);
+    QList<QStandardItem *> search(const QString &text, int limit = -1) const;
     inline bool getDataUpdateCompleted() { return m_dataUpdateCompleted; }
     void addChildPageTrans(const QString &menu, const QString &tran);
 
 Q_SIGNALS:
     void notifyModuleSearch(QString, QString);
+    void searchDataLoaded();
 
 private:
     void loadxml(const QString module = "");
+    void loadModuleData(const QString &module);
+    bool containsTxtData(const QString &txt) const;
+    QList<SearchBoxStruct::Ptr> createSearchList(const SearchIndexData &data);
     QString getModulesName(const QString &name, bool state = true);
-    QString removeDigital(QString input);
+    int getModuleWeight(const QString &module) const;
     QString transPinyinToChinese(const QString &pinyin);
     QString containTxtData(QString txt);
-    void appendChineseData(SearchBoxStruct::Ptr data);
+    void appendChineseData(SearchBoxStruct::Ptr data, QList<QStandardItem *> &items, QHash<QString, QString> &inputList);
     SearchBoxStruct::Ptr getModuleBtnString(QString value);
     bool specialProcessData(SearchBoxStruct::Ptr data);
 
 private:
     QList<SearchBoxStruct::Ptr> m_originList;
-    QList<SearchBoxStruct::Ptr> m_EnterNewPagelist;
-    QList<SearchBoxStruct::Ptr> m_hideList;
+    QHash<QString, SearchModuleData> m_moduleData;  //key为模块显示名称
+    QStringList m_moduleOrder;                      //模块在model中的顺序
     QSet<QString> m_xmlFilePath;
     QString m_lang;
     QMap<QString, QIcon> m_iconMap;
     QList<QPair<QString, QString>> m_moduleNameList;//用于存储如 "update"和"Update"
-    QList<SearchDataStruct> m_inputList;
     QList<QString> m_childWidgetList; //二级页面list
     QList<QString> m_childeHideWidgetList; //不需要显示的二级页面list，比如 “默认程序 --> 终端 / 添加默认程序” 和 “默认程序 --> 终端”
-    QList<QString> m_TxtListAll; //三级页面list
     QList<QPair<QString, QString>> m_removeableActualExistList;//存储实际模块是否存在
     bool m_bIsChinese;
     bool m_bIstextEdited;
-    QMap<QString, bool> m_hideModuleList;
-    QList<HideChildWidgetStruct> m_hideWidgetList;
-    QList<HideChildWidgetDetailStruct> m_hideWidgetDetailList;
     QMap<QString, QString> m_transChildPageName;
     bool m_dataUpdateCompleted;
     QMap<QString, QString> m_transPlusData;
+    std::shared_ptr<PinyinCache> m_pinyinCache;
+    SearchTextIndex m_textIndex;
+    QHash<int, QStandardItem *> m_searchItems;      //倒排索引文档id, model中的数据
+    int m_nextDocId;
 };
 
 }// namespace search
@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "searchtextindex.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::search;
+
+namespace {
+const int MaxGramLength = 3;
+
+// 匹配位置的得分，模块权重只在同一级别内起作用
+const int PrefixScore = 3000;
+const int WordBoundaryScore = 2000;
+const int ContainsScore = 1000;
+
+// 将 1~3 个字符编码为一个整数，最高位保存长度，避免不同长度的片段冲突
+quint64 encodeGram(const QChar *data, int length)
+{
+    quint64 gram = quint64(length) << 48;
+    for (int i = 0; i < length; ++i)
+        gram |= quint64(data[i].unicode()) << (16 * (MaxGramLength - 1 - i));
+    return gram;
+}
+
+bool isWordBoundary(const QString &key, int pos)
+{
+    if (pos <= 0)
+        return true;
+
+    const QChar prev = key.at(pos - 1);
+    // 汉字之间没有分隔符，每个字都可以作为单词开头
+    return !prev.isLetterOrNumber() || prev.script() == QChar::Script_Han || key.at(pos).script() == QChar::Script_Han;
+}
+
+struct Result {
+    int docId;
+    int score;
+    int keyLength;
+};
+}
+
+void SearchTextIndex::insert(int docId, const QStringList &keys, int weight)
+{
+    remove(docId);
+
+    Document doc;
+    doc.weight = weight;
+
+    QSet<quint64> grams;
+    for (const QString &key : keys) {
+        const QString lowerKey = key.toLower();
+        if (lowerKey.isEmpty() || doc.keys.contains(lowerKey))
+            continue;
+
+        doc.keys << lowerKey;
+        for (int i = 0; i < lowerKey.size(); ++i) {
+            for (int len = 1; len <= MaxGramLength && i + len <= lowerKey.size(); ++len)
+                grams.insert(encodeGram(lowerKey.constData() + i, len));
+        }
+    }
+
+    if (doc.keys.isEmpty())
+        return;
+
+    doc.grams.reserve(grams.size());
+    for (quint64 gram : grams) {
+        QVector<int> &posting = m_postings[gram];
+        // docId 递增分配时直接追加即可保持有序
+        if (posting.isEmpty() || posting.last() < docId)
+            posting.append(docId);
+        else
+            posting.insert(std::lower_bound(posting.begin(), posting.end(), docId), docId);
+        doc.grams.append(gram);
+    }
+
+    m_documents.insert(docId, doc);
+}
+
+void SearchTextIndex::remove(int docId)
+{
+    auto it = m_documents.find(docId);
+    if (it == m_documents.end())
+        return;
+
+    for (quint64 gram : it->grams) {
+        auto posting = m_postings.find(gram);
+        if (posting == m_postings.end())
+            continue;
+
+        auto pos = std::lower_bound(posting->begin(), posting->end(), docId);
+        if (pos != posting->end() && *pos == docId)
+            posting->erase(pos);
+        if (posting->isEmpty())
+            m_postings.erase(posting);
+    }
+
+    m_documents.erase(it);
+}
+
+void SearchTextIndex::clear()
+{
+    m_documents.clear();
+    m_postings.clear();
+}
+
+QVector<int> SearchTextIndex::candidates(const QString &text) const
+{
+    // 查询内容不超过3个字符时，片段的文档列表就是结果
+    if (text.size() <= MaxGramLength)
+        return m_postings.value(encodeGram(text.constData(), text.size()));
+
+    // 取查询内容中所有3字符片段的文档列表求交集，从最短的列表开始
+    QList<const QVector<int> *> postings;
+    for (int i = 0; i + MaxGramLength <= text.size(); ++i) {
+        auto it = m_postings.constFind(encodeGram(text.constData() + i, MaxGramLength));
+        if (it == m_postings.constEnd())
+            return QVector<int>();
+        postings << &it.value();
+    }
+
+    std::sort(postings.begin(), postings.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<int> result = *postings.first();
+    QVector<int> next;
+    for (int i = 1; i < postings.size() && !result.isEmpty(); ++i) {
+        next.clear();
+        std::set_intersection(result.constBegin(), result.constEnd(),
+                              postings[i]->constBegin(), postings[i]->constEnd(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+
+    return result;
+}
+
+int SearchTextIndex::score(const Document &doc, const QString &text, int *keyLength) const
+{
+    int best = 0;
+    *keyLength = 0;
+    for (const QString &key : doc.keys) {
+        int pos = key.indexOf(text);
+        int keyScore = 0;
+        while (pos >= 0) {
+            if (pos == 0) {
+                keyScore = PrefixScore;
+                break;
+            }
+            if (isWordBoundary(key, pos)) {
+                keyScore = WordBoundaryScore;
+                break;
+            }
+            keyScore = ContainsScore;
+            pos = key.indexOf(text, pos + 1);
+        }
+
+        if (keyScore > best || (keyScore == best && keyScore > 0 && key.size() < *keyLength)) {
+            best = keyScore;
+            *keyLength = key.size();
+        }
+    }
+
+    return best > 0 ? best + doc.weight : 0;
+}
+
+QList<int> SearchTextIndex::search(const QString &text, int limit) const
+{
+    QList<int> list;
+    const QString query = text.trimmed().toLower();
+    if (query.isEmpty() || limit == 0)
+        return list;
+
+    const QVector<int> docIds = candidates(query);
+
+    QVector<Result> results;
+    results.reserve(docIds.size());
+    for (int docId : docIds) {
+        auto doc = m_documents.constFind(docId);
+        if (doc == m_documents.constEnd())
+            continue;
+
+        Result result { docId, 0, 0 };
+        // 超过3个字符时候选结果只是包含所有片段，需要再次确认
+        result.score = score(doc.value(), query, &result.keyLength);
+        if (result.score > 0)
+            results << result;
+    }
+
+    auto compare = [](const Result &a, const Result &b) {
+        if (a.score != b.score)
+            return a.score > b.score;
+        if (a.keyLength != b.keyLength)
+            return a.keyLength < b.keyLength;
+        return a.docId < b.docId;
+    };
+
+    if (limit > 0 && limit < results.size()) {
+        std::partial_sort(results.begin(), results.begin() + limit, results.end(), compare);
+        results.resize(limit);
+    } else {
+        std::sort(results.begin(), results.end(), compare);
+    }
+
+    list.reserve(results.size());
+    for (const Result &result : results)
+        list << result.docId;
+
+    return list;
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+/**
+ * @brief The SearchTextIndex class
+ * 搜索数据的倒排索引，对每个搜索关键字的 1~3 字符片段建立文档列表，
+ * 查询时只需要检查包含查询片段的文档，不需要遍历全部搜索数据
+ * 结果按 匹配位置(开头 > 单词开头 > 其他) + 模块权重 排序
+ */
+class SearchTextIndex
+{
+public:
+    SearchTextIndex() = default;
+
+    // docId 需要递增分配，倒排表按 docId 有序追加
+    void insert(int docId, const QStringList &keys, int weight = 0);
+    void remove(int docId);
+    void clear();
+
+    inline int count() const { return m_documents.size(); }
+    inline bool contains(int docId) const { return m_documents.contains(docId); }
+
+    // 返回按匹配程度排序的 docId，limit 小于 0 时返回全部结果
+    QList<int> search(const QString &text, int limit = -1) const;
+
+private:
+    struct Document {
+        QStringList keys;
+        QVector<quint64> grams;
+        int weight;
+    };
+
+    QVector<int> candidates(const QString &text) const;
+    int score(const Document &doc, const QString &text, int *keyLength) const;
+
+private:
+    QHash<int, Document> m_documents;
+    QHash<quint64, QVector<int>> m_postings;
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
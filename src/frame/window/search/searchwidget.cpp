@@ -8,6 +8,7 @@
 #include "interface/moduleinterface.h"
 
 #include <QCompleter>
+#include <QStandardItemModel>
 #include <QPainter>
 #include <QRect>
 #include <QKeyEvent>
@@ -16,6 +17,9 @@ using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::search;
 #define GSETTINGS_CONTENS_SERVER "iscontens-server"
 
+// 自动补全下拉框最多显示的搜索结果数量
+static const int MaxCompleterCount = 50;
+
 class ddeCompleter : public QCompleter
 {
 public:
@@ -71,11 +75,13 @@ SearchWidget::SearchWidget(QWidget *parent)
     : DTK_WIDGET_NAMESPACE::DSearchEdit(parent)
 {
     m_model = new SearchModel(this);
-    m_completer = new ddeCompleter(m_model, this);
+    m_resultModel = new QStandardItemModel(this);
+    m_completer = new ddeCompleter(m_resultModel, this);
     m_completer->popup()->setItemDelegate(&styledItemDelegate);
     m_completer->popup()->setAttribute(Qt::WA_InputMethodEnabled);
 
-    m_completer->setFilterMode(Qt::MatchContains);//设置QCompleter支持匹配字符搜索
+    //搜索结果由SearchModel的倒排索引查找并排序，QCompleter只负责显示，不再逐行过滤
+    m_completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
     m_completer->setCaseSensitivity(Qt::CaseInsensitive);//这个属性可设置进行匹配时的大小写敏感性
     m_completer->setCompletionRole(Qt::UserRole); //设置ItemDataRole
     m_completer->setWrapAround(false);
@@ -85,6 +91,7 @@ SearchWidget::SearchWidget(QWidget *parent)
     m_forbidTextList << "--" << "-" << "-->" << "->" << ">" << "/";
 
     connect(m_model, &SearchModel::notifyModuleSearch, this, &SearchWidget::notifyModuleSearch);
+    connect(m_model, &SearchModel::searchDataLoaded, this, &SearchWidget::searchDataLoaded);
 
     connect(this, &DTK_WIDGET_NAMESPACE::DSearchEdit::textEdited, this, [ = ] {
         //m_bIstextEdited，　true : 用户输入　，　false : 直接调用setText
@@ -154,9 +161,18 @@ void SearchWidget::onAutoComplete(const QString &text)
     auto *widget = m_completer->popup();
     if (widget && text.isEmpty()) {
         widget->hide();
-    } else {
-        m_completer->setCompletionPrefix(text);
+        return;
+    }
+
+    m_resultModel->clear();
+    for (QStandardItem *item : m_model->search(text, MaxCompleterCount)) {
+        m_resultModel->appendRow(item->clone());
+    }
+
+    if (m_resultModel->rowCount() > 0) {
         m_completer->complete();
+    } else if (widget) {
+        widget->hide();
     }
 }
 
@@ -292,26 +308,21 @@ void SearchWidget::updateSearchdata(const QString &module)
     m_model->updateSearchData(module);
 }
 
-//返回搜索结果
-QList<QString> SearchWidget::searchResults(const QString text)
+//返回搜索结果，搜索数据未加载完成时返回空列表，调用方通过 searchDataLoaded 信号等待加载完成
+QList<QString> SearchWidget::searchResults(const QString text, int limit)
 {
-    QElapsedTimer et;
-    et.start();
-    while (!m_model->getDataUpdateCompleted() && et.elapsed() < 5000) {
-        QThread::msleep(50);
-        QCoreApplication::processEvents();
-    }
     QList<QString> lstSearchMsgs;
-    for (int row = 0; row < m_model->rowCount(); row++) {
-        QString msg = m_model->data(m_model->index(row, 0), m_model->m_bIsChinese? Qt::UserRole: Qt::DisplayRole).toString();
-        if(msg.contains(text,Qt::CaseInsensitive))
-            lstSearchMsgs.append(msg);
-    }
-    for (int i = 0; i < lstSearchMsgs.size(); i++) {
-        lstSearchMsgs[i] = m_model->transPinyinToChinese(lstSearchMsgs[i]);
+    for (QStandardItem *item : m_model->search(text, limit)) {
+        lstSearchMsgs.append(item->text());
     }
     return lstSearchMsgs;
 }
+
+bool SearchWidget::isSearchDataLoaded() const
+{
+    return m_model->getDataUpdateCompleted();
+}
+
 void SearchWidget::addChildPageTrans(const QString &menu, const QString &tran)
 {
     if (!m_model) {
@@ -13,6 +13,7 @@
 #include <QListView>
 #include <QStyledItemDelegate>
 QT_BEGIN_NAMESPACE
+class QStandardItemModel;
 class QListWidget;
 class QListWidgetItem;
 class QPushButton;
@@ -42,7 +43,8 @@ public:
     void setLanguage(const QString &type);
     void addModulesName(QString moduleName, const QString &searchName, QIcon icon, QString translation = "");
 
-    QList<QString> searchResults(const QString text);
+    QList<QString> searchResults(const QString text, int limit = -1);
+    bool isSearchDataLoaded() const;
     void getJumpPath(QString &moduleName, QString &pageName, const QString &searchName);
     void setModuleVisible(const QString &module, bool visible);
     void setWidgetVisible(const QString &module, const QString &widget, bool visible);
@@ -56,9 +58,11 @@ private Q_SLOTS:
     void onSearchTextChange(const QString &text);
 Q_SIGNALS:
     void notifyModuleSearch(QString, QString);
+    void searchDataLoaded();
 
 private:
     SearchModel *m_model;
+    QStandardItemModel *m_resultModel;  //自动补全下拉框中显示的搜索结果
     QCompleter *m_completer;
     DCompleterStyledItemDelegate styledItemDelegate;
     QStringList m_forbidTextList;
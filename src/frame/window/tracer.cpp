@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace DCC_NAMESPACE;
+
+namespace {
+const char *TraceFileEnv = "DCC_TRACE_FILE";
+// 限制内存占用，超出后丢弃后续的数据
+const int MaxEventCount = 200000;
+
+qint64 currentThreadId()
+{
+    static thread_local const qint64 tid = qint64(syscall(SYS_gettid));
+    return tid;
+}
+
+QString defaultFileName()
+{
+    return QDir::tempPath() + QString("/dde-control-center-%1.trace.json").arg(QCoreApplication::applicationPid());
+}
+}
+
+Tracer *Tracer::instance()
+{
+    static Tracer tracer;
+    return &tracer;
+}
+
+Tracer::Tracer()
+    : m_enabled(false)
+    , m_overflow(false)
+{
+    m_clock.start();
+}
+
+void Tracer::initFromEnvironment()
+{
+    const QString fileName = QString::fromLocal8Bit(qgetenv(TraceFileEnv));
+    if (fileName.isEmpty())
+        return;
+
+    // DCC_TRACE_FILE=1 时使用默认路径
+    setEnabled(true, fileName == "1" ? QString() : fileName);
+}
+
+bool Tracer::setEnabled(bool enabled, const QString &fileName)
+{
+    if (enabled == isEnabled())
+        return true;
+
+    if (enabled) {
+        m_fileName = fileName.isEmpty() ? defaultFileName() : fileName;
+        m_enabled.store(true, std::memory_order_relaxed);
+        qInfo() << "trace enabled, output:" << m_fileName;
+        return true;
+    }
+
+    m_enabled.store(false, std::memory_order_relaxed);
+    return flush();
+}
+
+qint64 Tracer::now() const
+{
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+void Tracer::addSpan(const char *category, const char *name, const QString &detail, qint64 start, qint64 duration)
+{
+    addEvent({ category, name, detail, 'X', start, duration, currentThreadId() });
+}
+
+void Tracer::addInstant(const char *category, const char *name, const QString &detail)
+{
+    if (!isEnabled())
+        return;
+
+    addEvent({ category, name, detail, 'i', now(), 0, currentThreadId() });
+}
+
+void Tracer::addEvent(const Event &event)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_events.size() >= MaxEventCount) {
+        m_overflow = true;
+        return;
+    }
+
+    m_events.append(event);
+}
+
+bool Tracer::flush()
+{
+    QVector<Event> events;
+    bool overflow = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        events.swap(m_events);
+        std::swap(overflow, m_overflow);
+    }
+
+    if (m_fileName.isEmpty() || events.isEmpty())
+        return true;
+
+    if (overflow)
+        qWarning() << "trace buffer is full, later events are dropped";
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (const Event &event : events) {
+        QJsonObject object;
+        object.insert("name", QString::fromLatin1(event.name));
+        object.insert("cat", QString::fromLatin1(event.category));
+        object.insert("ph", QString(QChar(event.phase)));
+        object.insert("ts", double(event.timestamp));
+        object.insert("pid", double(pid));
+        object.insert("tid", double(event.threadId));
+        if (event.phase == 'X')
+            object.insert("dur", double(event.duration));
+        else
+            object.insert("s", "t");
+        if (!event.detail.isEmpty())
+            object.insert("args", QJsonObject { { "detail", event.detail } });
+        traceEvents.append(object);
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", traceEvents);
+    root.insert("displayTimeUnit", "ms");
+
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "open trace file failed:" << m_fileName << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "write trace file failed:" << m_fileName << file.errorString();
+        return false;
+    }
+
+    qInfo() << "trace saved to" << m_fileName << ", events:" << events.size();
+    return true;
+}
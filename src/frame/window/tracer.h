@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+namespace DCC_NAMESPACE {
+
+/**
+ * @brief The Tracer class
+ * 记录启动和页面跳转过程中各阶段的耗时，输出为 Chrome trace_event 格式的 JSON 文件，
+ * 可以直接在 chrome://tracing 或 Perfetto 中打开。
+ * 通过环境变量 DCC_TRACE_FILE 或 D-Bus 接口 SetTraceEnabled 开启，未开启时记录接口只做一次原子读取
+ */
+class Tracer
+{
+public:
+    static Tracer *instance();
+
+    // 读取环境变量 DCC_TRACE_FILE，设置后从启动开始记录
+    void initFromEnvironment();
+
+    inline bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    // 关闭时将已记录的数据写入文件
+    bool setEnabled(bool enabled, const QString &fileName = QString());
+    inline QString fileName() const { return m_fileName; }
+
+    // 当前时间，单位为微秒
+    qint64 now() const;
+    void addSpan(const char *category, const char *name, const QString &detail, qint64 start, qint64 duration);
+    void addInstant(const char *category, const char *name, const QString &detail = QString());
+
+    // 将记录的数据写入文件并清空
+    bool flush();
+
+private:
+    Tracer();
+    Q_DISABLE_COPY(Tracer)
+
+    struct Event {
+        const char *category;
+        const char *name;
+        QString detail;
+        char phase;
+        qint64 timestamp;
+        qint64 duration;
+        qint64 threadId;
+    };
+    void addEvent(const Event &event);
+
+private:
+    std::atomic<bool> m_enabled;
+    QElapsedTimer m_clock;
+    QString m_fileName;
+    QMutex m_mutex;
+    QVector<Event> m_events;
+    bool m_overflow;
+};
+
+/**
+ * @brief The TraceSpan class
+ * 作用域内的耗时，析构时记录，category 和 name 必须是字符串常量；
+ * 异步调用在回调中调用 finish 记录，之后析构时不再记录
+ */
+class TraceSpan
+{
+public:
+    TraceSpan(const char *category, const char *name, const QString &detail = QString())
+        : m_category(category)
+        , m_name(name)
+        , m_start(-1)
+    {
+        Tracer *tracer = Tracer::instance();
+        if (tracer->isEnabled()) {
+            m_detail = detail;
+            m_start = tracer->now();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        finish();
+    }
+
+    void finish()
+    {
+        if (m_start < 0)
+            return;
+
+        Tracer *tracer = Tracer::instance();
+        tracer->addSpan(m_category, m_name, m_detail, m_start, tracer->now() - m_start);
+        m_start = -1;
+    }
+
+private:
+    Q_DISABLE_COPY(TraceSpan)
+
+    const char *m_category;
+    const char *m_name;
+    QString m_detail;
+    qint64 m_start;
+};
+
+}// namespace DCC_NAMESPACE
+
+#define DCC_TRACE_CONCAT_IMPL(a, b) a##b
+#define DCC_TRACE_CONCAT(a, b) DCC_TRACE_CONCAT_IMPL(a, b)
+// 记录当前作用域的耗时，例如 DCC_TRACE_SCOPE("module", "preInitialize", module->name());
+#define DCC_TRACE_SCOPE(...) DCC_NAMESPACE::TraceSpan DCC_TRACE_CONCAT(dccTraceSpan, __LINE__)(__VA_ARGS__)
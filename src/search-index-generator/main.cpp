@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "window/search/searchindex.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QSaveFile>
+
+#include <iostream>
+
+using namespace DCC_NAMESPACE::search;
+
+// 编译时将 .ts 文件中的搜索数据转换为二进制索引，避免控制中心启动时解析 XML
+// usage: dcc-search-index-generator <input.ts> <output.idx>
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() != 3) {
+        std::cerr << "usage: dcc-search-index-generator <input.ts> <output.idx>" << std::endl;
+        return -1;
+    }
+
+    QFile input(args.at(1));
+    if (!input.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        std::cerr << "open " << args.at(1).toStdString() << " failed" << std::endl;
+        return -1;
+    }
+
+    SearchIndexData data;
+    if (!SearchIndex::parseTranslation(&input, data)) {
+        std::cerr << "parse " << args.at(1).toStdString() << " failed" << std::endl;
+        return -1;
+    }
+
+    QSaveFile output(args.at(2));
+    if (!output.open(QIODevice::WriteOnly)
+            || !SearchIndex::write(data, SearchIndex::buildVersion(), &output)
+            || !output.commit()) {
+        std::cerr << "write " << args.at(2).toStdString() << " failed" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define private public
+#include "../src/frame/window/modules/datetime/clockticker.h"
+#undef private
+
+#include <QSignalSpy>
+#include <QTimer>
+#include <QWidget>
+
+#include <gtest/gtest.h>
+
+using namespace DCC_NAMESPACE::datetime;
+
+class Tst_ClockTicker : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+};
+
+TEST_F(Tst_ClockTicker, visibility)
+{
+    ClockTicker *ticker = ClockTicker::instance();
+    EXPECT_EQ(ticker, ClockTicker::instance());
+
+    QWidget *first = new QWidget;
+    QWidget *second = new QWidget;
+    ticker->watch(first);
+    ticker->watch(second);
+    EXPECT_FALSE(ticker->isActive());
+
+    // 显示时立即刷新一次
+    QSignalSpy spy(ticker, &ClockTicker::tick);
+    first->show();
+    EXPECT_TRUE(ticker->isActive());
+    EXPECT_EQ(spy.count(), 1);
+
+    second->show();
+    EXPECT_EQ(spy.count(), 1);
+
+    // 全部隐藏后停止计时
+    first->hide();
+    EXPECT_TRUE(ticker->isActive());
+    second->hide();
+    EXPECT_FALSE(ticker->isActive());
+
+    second->show();
+    EXPECT_TRUE(ticker->isActive());
+    EXPECT_EQ(spy.count(), 2);
+
+    delete second;
+    EXPECT_FALSE(ticker->isActive());
+    delete first;
+}
+
+TEST_F(Tst_ClockTicker, alignment)
+{
+    ClockTicker *ticker = ClockTicker::instance();
+    QWidget widget;
+    ticker->watch(&widget);
+
+    // 每次 tick 时定时器对齐到下一秒开始的时刻
+    QSignalSpy spy(ticker, &ClockTicker::tick);
+    widget.show();
+    ASSERT_EQ(spy.count(), 1);
+    QDateTime now = spy.takeFirst().at(0).toDateTime();
+    ASSERT_TRUE(ticker->isActive());
+    EXPECT_EQ(ticker->m_timer->interval(), 1000 - now.time().msec());
+
+    ASSERT_TRUE(spy.wait(1500));
+    now = spy.takeFirst().at(0).toDateTime();
+    ASSERT_TRUE(ticker->isActive());
+    EXPECT_EQ(ticker->m_timer->interval(), 1000 - now.time().msec());
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/datetime/timezone_dialog/map_pixmap_cache.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+using namespace installer;
+
+class Tst_MapPixmapCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        // 和时区地图一样的宽高比，2 倍缩放
+        source = QPixmap(1956, 1000);
+        source.fill(Qt::white);
+        QPainter painter(&source);
+        for (int x = 0; x < source.width(); x += 10)
+            painter.drawLine(x, 0, source.width() - x, source.height());
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+public:
+    QPixmap source;
+};
+
+TEST_F(Tst_MapPixmapCache, levels)
+{
+    MapPixmapCache cache(source);
+    EXPECT_EQ(cache.level_count(), 1);
+
+    // 保持宽高比，从最接近的层缩放
+    const QPixmap fast = cache.Fast(QSize(400, 400));
+    EXPECT_EQ(fast.size(), QSize(400, 204));
+    EXPECT_EQ(cache.level_count(), 2);
+
+    // 和某一层大小相同时直接使用
+    EXPECT_EQ(cache.Fast(QSize(978, 500)).size(), QSize(978, 500));
+    EXPECT_EQ(cache.level_count(), 3);
+
+    // 比原图大时从原图缩放
+    EXPECT_EQ(cache.Fast(QSize(3912, 2000)).size(), QSize(3912, 2000));
+
+    const QPixmap smooth = cache.Smooth(QSize(700, 400));
+    EXPECT_EQ(smooth.size(), QSize(700, 357));
+    EXPECT_EQ(cache.Smooth(QSize(700, 400)).cacheKey(), smooth.cacheKey());
+
+    EXPECT_TRUE(cache.Fast(QSize(0, 0)).isNull());
+    EXPECT_TRUE(MapPixmapCache().Fast(QSize(400, 400)).isNull());
+}
+
+TEST_F(Tst_MapPixmapCache, costLimit)
+{
+    MapPixmapCache cache(source);
+    const int sourceCost = cache.cost();
+    for (int width = 1956; width > 100; width -= 50)
+        cache.Fast(QSize(width, width));
+    EXPECT_GT(cache.level_count(), 2);
+
+    // 超出限制时淘汰最久没有使用的层，原图一直保留
+    cache.SetCostLimit(sourceCost + 1024);
+    EXPECT_LE(cache.cost(), sourceCost + 1024);
+    EXPECT_FALSE(cache.source().isNull());
+
+    cache.SetCostLimit(0);
+    EXPECT_EQ(cache.level_count(), 2);
+    cache.Fast(QSize(400, 400));
+    cache.Fast(QSize(900, 900));
+    EXPECT_EQ(cache.level_count(), 2);
+}
+
+TEST_F(Tst_MapPixmapCache, benchmark)
+{
+    // 模拟拖动窗口时连续缩放
+    QList<QSize> sizes;
+    for (int step = 0; step < 100; ++step)
+        sizes << QSize(978 - step * 5, 500 - step * 2) * 2;
+    for (int step = 100; step > 0; --step)
+        sizes << QSize(978 - step * 5, 500 - step * 2) * 2;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const QSize &size : sizes)
+        source.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    const qint64 direct = timer.nsecsElapsed();
+
+    MapPixmapCache cache(source);
+    timer.restart();
+    for (const QSize &size : sizes)
+        cache.Fast(size);
+    cache.Smooth(sizes.last());
+    const qint64 cached = timer.nsecsElapsed();
+
+    qInfo() << "resize" << sizes.size() << "times, direct:" << direct / 1000000.0
+            << "ms, cached:" << cached / 1000000.0 << "ms";
+    EXPECT_LT(cached, direct);
+}
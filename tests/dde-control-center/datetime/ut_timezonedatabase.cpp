@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/datetime/timezone_dialog/timezone_database.h"
+
+#include <QFile>
+#include <QtConcurrent>
+
+#include <gtest/gtest.h>
+
+using namespace installer;
+
+class Tst_TimezoneDatabase : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        hasZoneInfo = QFile::exists("/usr/share/zoneinfo/zone1970.tab");
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+public:
+    bool hasZoneInfo = false;
+};
+
+TEST_F(Tst_TimezoneDatabase, zones)
+{
+    const TimezoneDatabase &database = TimezoneDatabase::Instance();
+    EXPECT_EQ(&database, &TimezoneDatabase::Instance());
+    if (!hasZoneInfo)
+        return;
+
+    // 只解析一次，所有调用者共享同一份数据
+    const ZoneInfoList zones = GetZoneInfoList();
+    ASSERT_FALSE(zones.isEmpty());
+    EXPECT_EQ(zones.constBegin(), database.zones().constBegin());
+
+    for (int i = 0; i < zones.size(); ++i) {
+        EXPECT_EQ(database.IndexOfZone(zones.at(i).timezone), GetZoneInfoByZone(zones, zones.at(i).timezone));
+        EXPECT_EQ(database.IndexOfCountry(zones.at(i).country), GetZoneInfoByCountry(zones, zones.at(i).country));
+    }
+    EXPECT_EQ(database.IndexOfZone("Not/Exist"), -1);
+    EXPECT_TRUE(database.IsValid("Asia/Shanghai"));
+    EXPECT_FALSE(database.IsValid("Not/Exist"));
+    EXPECT_FALSE(database.IsValid(""));
+}
+
+TEST_F(Tst_TimezoneDatabase, localName)
+{
+    const TimezoneDatabase &database = TimezoneDatabase::Instance();
+    // 没有翻译时使用时区名，去掉大洲
+    EXPECT_EQ(database.LocalName("America/Argentina/Buenos_Aires", "xx_XX"), QString("Buenos_Aires"));
+    EXPECT_EQ(database.LocalName("UTC", "xx_XX"), QString("UTC"));
+    EXPECT_EQ(GetLocalTimezoneName("Asia/Shanghai", "xx_XX.UTF-8"), QString("Shanghai"));
+}
+
+TEST_F(Tst_TimezoneDatabase, offset)
+{
+    const TimezoneDatabase &database = TimezoneDatabase::Instance();
+    if (!hasZoneInfo)
+        return;
+
+    // 2022-01-01 00:00:00 UTC 和 2022-07-01 00:00:00 UTC
+    const qint64 winter = 1640995200;
+    const qint64 summer = 1656633600;
+    EXPECT_EQ(database.Offset("Asia/Shanghai", winter).seconds, 8 * 3600);
+    EXPECT_EQ(database.Offset("Asia/Shanghai", summer).seconds, 8 * 3600);
+    EXPECT_EQ(database.Offset("Europe/Berlin", winter).seconds, 3600);
+    EXPECT_EQ(database.Offset("Europe/Berlin", summer).seconds, 2 * 3600);
+    EXPECT_EQ(database.Offset("Europe/Berlin", summer).name, QString("CEST"));
+    EXPECT_EQ(database.Offset("Not/Exist", summer).seconds, 0);
+
+    // 不修改进程的 TZ 环境变量
+    const QByteArray tz = qgetenv("TZ");
+    GetTimezoneOffset("America/New_York");
+    EXPECT_EQ(qgetenv("TZ"), tz);
+}
+
+TEST_F(Tst_TimezoneDatabase, threads)
+{
+    const TimezoneDatabase &database = TimezoneDatabase::Instance();
+    if (!hasZoneInfo)
+        return;
+
+    QStringList timezones;
+    for (const ZoneInfo &zone : database.zones())
+        timezones << zone.timezone;
+
+    auto describe = [&database](const QString &timezone) {
+        const TimezoneOffset offset = database.Offset(timezone, 1656633600);
+        return database.LocalName(timezone, "zh_CN") + offset.name + QString::number(offset.seconds);
+    };
+
+    QStringList expected;
+    for (const QString &timezone : timezones)
+        expected << describe(timezone);
+
+    // 多个线程同时读取，结果和单线程一致
+    for (int round = 0; round < 4; ++round) {
+        const QStringList result = QtConcurrent::blockingMapped<QStringList>(timezones, std::function<QString(const QString &)>(describe));
+        EXPECT_EQ(result, expected);
+    }
+}
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/datetime/timezone_dialog/timezone_map_util.h"
+
+#include <QPair>
+#include <QSize>
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+using namespace installer;
+
+namespace {
+// 随机生成的时区，经纬度覆盖地图之外的区域
+ZoneInfoList randomZones(int count, std::mt19937 &random)
+{
+    std::uniform_real_distribution<double> latitude(-85, 85);
+    std::uniform_real_distribution<double> longitude(-180, 180);
+    ZoneInfoList zones;
+    for (int i = 0; i < count; ++i) {
+        const ZoneInfo zone = { "CC", QString("Zone/%1").arg(i), latitude(random), longitude(random), 0.0 };
+        zones.append(zone);
+        // 部分时区位置相同
+        if (i % 50 == 0) {
+            const ZoneInfo twin = { "CC", QString("Zone/%1-1").arg(i), zone.latitude, zone.longitude, 0.0 };
+            zones.append(twin);
+        }
+    }
+    return zones;
+}
+
+double distance(const ZoneInfo &zone, const QSize &size, int x, int y)
+{
+    const double dx = ConvertLongitudeToX(zone.longitude) * size.width() - x;
+    const double dy = ConvertLatitudeToY(zone.latitude) * size.height() - y;
+    return dx * dx + dy * dy;
+}
+
+QList<int> bruteWithin(const ZoneInfoList &zones, const QSize &size, int x, int y, double threshold)
+{
+    QList<int> result;
+    for (int i = 0; i < zones.size(); ++i) {
+        if (distance(zones.at(i), size, x, y) <= threshold)
+            result << i;
+    }
+    return result;
+}
+
+QList<int> bruteNearest(const ZoneInfoList &zones, const QSize &size, int x, int y, int count)
+{
+    QVector<QPair<double, int>> distances;
+    for (int i = 0; i < zones.size(); ++i)
+        distances.append(qMakePair(distance(zones.at(i), size, x, y), i));
+    std::sort(distances.begin(), distances.end());
+
+    QList<int> result;
+    for (int i = 0; i < count && i < distances.size(); ++i)
+        result << distances.at(i).second;
+    return result;
+}
+}
+
+class Tst_TimezoneMapUtil : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+
+    }
+
+    void TearDown() override
+    {
+
+    }
+};
+
+TEST_F(Tst_TimezoneMapUtil, nearestZones)
+{
+    std::mt19937 random(20221017);
+    const ZoneInfoList zones = randomZones(400, random);
+    ZoneIndex index(zones);
+
+    for (const QSize &size : { QSize(760, 370), QSize(1520, 740), QSize(333, 171) }) {
+        index.Resize(size.width(), size.height());
+        std::uniform_int_distribution<int> x(-20, size.width() + 20);
+        std::uniform_int_distribution<int> y(-20, size.height() + 20);
+
+        for (int round = 0; round < 1000; ++round) {
+            const int px = x(random);
+            const int py = y(random);
+
+            // 和逐个比较的结果一致
+            ASSERT_EQ(index.Within(px, py, 64.0), bruteWithin(zones, size, px, py, 64.0)) << px << py;
+            ASSERT_EQ(index.Nearest(px, py, 5), bruteNearest(zones, size, px, py, 5)) << px << py;
+        }
+    }
+}
+
+TEST_F(Tst_TimezoneMapUtil, emptyIndex)
+{
+    ZoneIndex index;
+    EXPECT_TRUE(index.Nearest(10, 10).isEmpty());
+
+    index.Resize(760, 370);
+    EXPECT_TRUE(index.Within(10, 10, 64.0).isEmpty());
+    EXPECT_TRUE(index.Nearest(10, 10).isEmpty());
+
+    // 数量大于时区个数时返回全部时区
+    std::mt19937 random(1);
+    index.SetZones(randomZones(3, random));
+    EXPECT_EQ(index.Nearest(10, 10, 10).size(), 4);
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "display_dbus.h"
+
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDebug>
+#include <QProcess>
+
+#include <gtest/gtest.h>
+
+#ifdef QT_DEBUG
+#include <sanitizer/asan_interface.h>
+#endif
+
+int main(int argc, char **argv)
+{
+    QProcess process;
+    QString cmd = "dbus-daemon --session --print-address";
+    process.start(cmd);
+    process.waitForReadyRead();
+
+    QString path = process.readAllStandardOutput().simplified();
+
+    setenv("DBUS_SESSION_BUS_ADDRESS", path.toStdString().data(), 1);
+    setenv("QT_QPA_PLATFORM", "offscreen", 1);
+    QApplication app(argc, argv);
+
+    // 记录显示设置发送给后端的调用
+    QDBusConnection conn = QDBusConnection::sessionBus();
+    FakeDisplay display;
+    FakeDisplayMonitor monitor;
+    if (!conn.registerService(DISPLAY_SERVICE_NAME)
+            || !conn.registerObject(DISPLAY_SERVICE_PATH, &display, QDBusConnection::ExportAllContents)
+            || !conn.registerObject(DISPLAY_MONITOR_PATH, &monitor, QDBusConnection::ExportAllContents)) {
+        qWarning() << conn.lastError().name() << ", " << conn.lastError().message();
+        process.close();
+        return -1;
+    }
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    int ret = RUN_ALL_TESTS();
+
+#ifdef QT_DEBUG
+    __sanitizer_set_report_path("asan_display.log");
+#endif
+
+    process.close();
+    return ret;
+}
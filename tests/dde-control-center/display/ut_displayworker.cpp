@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define private public
+#include "../src/frame/modules/display/displayworker.h"
+#include "../src/frame/modules/display/displaymodel.h"
+#undef private
+
+#include "display_dbus.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+using namespace dcc::display;
+
+namespace {
+// 等待后端收到调用，D-Bus 调用是异步的
+bool waitForCall(const QString &call, int timeout = 3000)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!displayCalls().contains(call) && timer.elapsed() < timeout)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    return displayCalls().contains(call);
+}
+
+// 处理剩余的事件，确认没有多余的调用
+void settle(int timeout = 500)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < timeout)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+}
+}
+
+class Tst_DisplayWorker : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        // DisplayWorker 需要控制中心的 gsettings 配置
+        if (!QGSettings::isSchemaInstalled("com.deepin.dde.control-center"))
+            return;
+
+        model = new DisplayModel;
+        model->setDisplayMode(EXTEND_MODE);
+        worker = new DisplayWorker(model);
+
+        // 不通过 monitorAdded 读取属性，直接关联假的显示器对象
+        MonitorInter *inter = new MonitorInter(DISPLAY_SERVICE_NAME, DISPLAY_MONITOR_PATH, QDBusConnection::sessionBus(), worker);
+        monitor = new Monitor(worker);
+        monitor->setName("HDMI-1");
+        worker->m_monitors.insert(monitor, inter);
+
+        displayCalls().clear();
+        FakeDisplay::failApply = false;
+    }
+
+    void TearDown() override
+    {
+        // 等待上一次提交完成
+        settle();
+        delete worker;
+        delete model;
+        worker = nullptr;
+        model = nullptr;
+    }
+
+public:
+    DisplayModel *model = nullptr;
+    DisplayWorker *worker = nullptr;
+    Monitor *monitor = nullptr;
+};
+
+TEST_F(Tst_DisplayWorker, resolutionPreview)
+{
+    if (!worker)
+        return;
+
+    // 修改和 ApplyChanges 在同一次提交中发送用于预览，不保存
+    worker->setMonitorResolution(monitor, 5);
+    ASSERT_TRUE(waitForCall("ApplyChanges"));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetMode 5", "ApplyChanges" }));
+
+    // 确认对话框接受后只保存
+    worker->saveChanges();
+    ASSERT_TRUE(waitForCall("Save"));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetMode 5", "ApplyChanges", "Save" }));
+}
+
+TEST_F(Tst_DisplayWorker, resolutionPreviewRollback)
+{
+    if (!worker)
+        return;
+
+    // 预览时 ApplyChanges 失败，分辨率回滚到修改前的模式
+    FakeDisplay::failApply = true;
+    const QString lastMode = QString("SetMode %1").arg(monitor->currentMode().id());
+    worker->setMonitorResolution(monitor, 5);
+    ASSERT_TRUE(waitForCall(lastMode));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetMode 5", "ApplyChanges", lastMode }));
+}
+
+TEST_F(Tst_DisplayWorker, resolutionApply)
+{
+    if (!worker)
+        return;
+
+    worker->setMonitorResolutionBySize(monitor, 1920, 1080);
+    worker->applyChanges();
+    ASSERT_TRUE(waitForCall("Save"));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetModeBySize 1920 1080", "ApplyChanges", "Save" }));
+}
+
+#ifndef DCC_DISABLE_ROTATE
+TEST_F(Tst_DisplayWorker, rotate)
+{
+    if (!worker)
+        return;
+
+    worker->setMonitorRotate(monitor, 2);
+    worker->applyChanges();
+    ASSERT_TRUE(waitForCall("Save"));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetRotation 2", "ApplyChanges", "Save" }));
+}
+
+TEST_F(Tst_DisplayWorker, mergeModeRotate)
+{
+    if (!worker)
+        return;
+
+    // 复制模式下所有屏幕的旋转在一个事务中发送，只调用一次 ApplyChanges
+    MonitorInter *inter = new MonitorInter(DISPLAY_SERVICE_NAME, DISPLAY_MONITOR_PATH, QDBusConnection::sessionBus(), worker);
+    Monitor *second = new Monitor(worker);
+    second->setName("HDMI-2");
+    worker->m_monitors.insert(second, inter);
+    model->setDisplayMode(MERGE_MODE);
+
+    worker->setMonitorRotate(monitor, 2);
+    ASSERT_TRUE(waitForCall("ApplyChanges"));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetRotation 2", "SetRotation 2", "ApplyChanges" }));
+}
+#endif
+
+TEST_F(Tst_DisplayWorker, rollback)
+{
+    if (!worker)
+        return;
+
+    // 位置和 ApplyChanges 在同一次提交中，ApplyChanges 失败时回滚到修改前的位置，不保存
+    FakeDisplay::failApply = true;
+    const QString lastPosition = QString("SetPosition %1 %2").arg(monitor->x()).arg(monitor->y());
+    QHash<Monitor *, QPair<int, int>> position;
+    position.insert(monitor, qMakePair(1920, 0));
+    worker->setMonitorPosition(position);
+    ASSERT_TRUE(waitForCall(lastPosition));
+    settle();
+    EXPECT_EQ(displayCalls(), QStringList({ "SetPosition 1920 0", "ApplyChanges", lastPosition }));
+}
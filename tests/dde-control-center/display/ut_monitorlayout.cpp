@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/display/monitorlayout.h"
+
+#include <QElapsedTimer>
+#include <QSize>
+#include <QSet>
+#include <QDebug>
+
+#include "gtest/gtest.h"
+
+#include <random>
+
+using namespace dcc::display;
+
+namespace {
+const QSize ScreenSizes[] = { QSize(1920, 1080), QSize(1280, 1024), QSize(2560, 1440), QSize(1080, 1920) };
+
+// 原来 MonitorsGround::updateConnectedState 中逐对比较的实现
+MonitorLayout::Adjacency bruteForceAdjacency(const QVector<QRectF> &rects)
+{
+    MonitorLayout::Adjacency result;
+    result.neighbours.resize(rects.size());
+    for (int i = 0; i < rects.size(); ++i) {
+        const QRectF ex = rects[i].adjusted(-MonitorLayout::Tolerance, -MonitorLayout::Tolerance, MonitorLayout::Tolerance, MonitorLayout::Tolerance);
+        const QRectF inner = rects[i].adjusted(MonitorLayout::Inset, MonitorLayout::Inset, -MonitorLayout::Inset, -MonitorLayout::Inset);
+        for (int j = 0; j < rects.size(); ++j) {
+            if (i == j)
+                continue;
+            if (ex.intersects(rects[j]) && !inner.intersects(rects[j]))
+                result.neighbours[i] << j;
+            if (inner.intersects(rects[j]))
+                result.overlapped = true;
+        }
+    }
+    return result;
+}
+
+// 随机拼接的屏幕：每个新屏幕贴在已有屏幕的某条边上，不和其他屏幕重叠
+QVector<QRectF> randomLayout(int count, std::mt19937 &random)
+{
+    QVector<QRectF> rects;
+    rects << QRectF(QPointF(0, 0), ScreenSizes[random() % 4]);
+    while (rects.size() < count) {
+        const QRectF &base = rects[int(random() % rects.size())];
+        const QSizeF size = ScreenSizes[random() % 4];
+        const qreal offset = qreal(int(random() % 1000) - 500);
+        QRectF rect(QPointF(0, 0), size);
+        switch (random() % 4) {
+        case 0: rect.moveTopLeft(QPointF(base.right(), base.top() + offset)); break;
+        case 1: rect.moveTopRight(QPointF(base.left(), base.top() + offset)); break;
+        case 2: rect.moveTopLeft(QPointF(base.left() + offset, base.bottom())); break;
+        default: rect.moveBottomLeft(QPointF(base.left() + offset, base.top())); break;
+        }
+
+        const QRectF inner = rect.adjusted(MonitorLayout::Inset, MonitorLayout::Inset, -MonitorLayout::Inset, -MonitorLayout::Inset);
+        bool overlapped = false;
+        for (const QRectF &other : rects)
+            overlapped = overlapped || inner.intersects(other);
+        if (!overlapped)
+            rects << rect;
+    }
+    return rects;
+}
+
+// 随机摆放的屏幕，可能重叠也可能分开
+QVector<QRectF> randomRects(int count, std::mt19937 &random)
+{
+    QVector<QRectF> rects;
+    for (int i = 0; i < count; ++i)
+        rects << QRectF(QPointF(int(random() % 8) * 640, int(random() % 8) * 540), ScreenSizes[random() % 4]);
+    return rects;
+}
+
+QSet<int> toSet(const QVector<int> &list)
+{
+    QSet<int> set;
+    for (int i : list)
+        set.insert(i);
+    return set;
+}
+}
+
+class Tst_MonitorLayout : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    std::mt19937 random;
+};
+
+void Tst_MonitorLayout::SetUp()
+{
+    random.seed(20221017);
+}
+
+void Tst_MonitorLayout::TearDown()
+{
+
+}
+
+TEST_F(Tst_MonitorLayout, adjacency)
+{
+    // 扫描的结果和逐对比较的结果一致
+    for (int count = 2; count <= 16; ++count) {
+        for (int round = 0; round < 50; ++round) {
+            const QVector<QRectF> rects = round % 2 ? randomLayout(count, random) : randomRects(count, random);
+            const MonitorLayout::Adjacency expected = bruteForceAdjacency(rects);
+            const MonitorLayout::Adjacency adjacency = MonitorLayout::adjacency(rects);
+            ASSERT_EQ(adjacency.neighbours, expected.neighbours) << "count" << count << "round" << round;
+            ASSERT_EQ(adjacency.overlapped, expected.overlapped) << "count" << count << "round" << round;
+        }
+    }
+}
+
+TEST_F(Tst_MonitorLayout, connectivity)
+{
+    for (int count = 2; count <= 16; ++count) {
+        // 拼接出来的屏幕总是连通且不重叠
+        const QVector<QRectF> layout = randomLayout(count, random);
+        const MonitorLayout::Adjacency adjacency = MonitorLayout::adjacency(layout);
+        EXPECT_FALSE(adjacency.overlapped);
+        EXPECT_TRUE(MonitorLayout::isConnected(adjacency.neighbours));
+        EXPECT_EQ(MonitorLayout::connectedDomain(adjacency.neighbours, 0).size(), count);
+
+        // 并查集的结果和广度优先的连通域一致
+        const QVector<QVector<int>> neighbours = MonitorLayout::adjacency(randomRects(count, random)).neighbours;
+        int componentCount = 0;
+        const QVector<int> components = MonitorLayout::components(neighbours, &componentCount);
+        QSet<int> ids;
+        for (int i = 0; i < count; ++i) {
+            const QVector<int> domain = MonitorLayout::connectedDomain(neighbours, i);
+            EXPECT_EQ(domain.last(), i);
+            QSet<int> expected;
+            for (int j = 0; j < count; ++j) {
+                if (components[j] == components[i])
+                    expected.insert(j);
+            }
+            EXPECT_EQ(toSet(domain), expected);
+            ids.insert(components[i]);
+        }
+        EXPECT_EQ(ids.size(), componentCount);
+        EXPECT_EQ(MonitorLayout::isConnected(neighbours), componentCount == 1);
+    }
+}
+
+TEST_F(Tst_MonitorLayout, videoWall)
+{
+    // 4x4 的拼接墙，去掉中间一列后分成两部分
+    QVector<QRectF> rects;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column)
+            rects << QRectF(column * 1920, row * 1080, 1920, 1080);
+    }
+
+    MonitorLayout::Adjacency adjacency = MonitorLayout::adjacency(rects);
+    EXPECT_TRUE(MonitorLayout::isConnected(adjacency.neighbours));
+    // 中间的屏幕和周围 8 个屏幕接触(包括顶点)
+    EXPECT_EQ(adjacency.neighbours[5].size(), 8);
+
+    QVector<QRectF> split;
+    for (int i = 0; i < rects.size(); ++i) {
+        if (i % 4 != 1)
+            split << rects[i];
+    }
+    int count = 0;
+    MonitorLayout::components(MonitorLayout::adjacency(split).neighbours, &count);
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(Tst_MonitorLayout, snapOffset)
+{
+    const QVector<QRectF> others = { QRectF(0, 0, 1920, 1080) };
+
+    // 靠近右边时吸附到右边，并且和距离最近的下边对齐
+    QRectF moving(2000, 60, 1280, 1024);
+    const QRectF snapped = moving.translated(MonitorLayout::snapOffset(moving, others));
+    EXPECT_DOUBLE_EQ(snapped.left(), 1920);
+    EXPECT_DOUBLE_EQ(snapped.bottom(), 1080);
+
+    // 超出吸附范围时不移动
+    moving.moveTopLeft(QPointF(2200, 60));
+    EXPECT_EQ(MonitorLayout::snapOffset(moving, others), QPointF(0, 0));
+
+    // 已经相交时不移动
+    moving.moveTopLeft(QPointF(1900, 60));
+    EXPECT_EQ(MonitorLayout::snapOffset(moving, others), QPointF(0, 0));
+
+    // 在任意一边的吸附范围内，吸附后都和该屏幕相邻且不重叠
+    for (int round = 0; round < 200; ++round) {
+        const QRectF other(QPointF(0, 0), ScreenSizes[random() % 4]);
+        QRectF rect(QPointF(0, 0), ScreenSizes[random() % 4]);
+        const qreal gap = 1 + int(random() % 199);
+        const qreal offset = int(random() % 1000) - 500;
+        switch (round % 4) {
+        case 0: rect.moveTopLeft(QPointF(other.right() + gap, other.top() + offset)); break;
+        case 1: rect.moveTopRight(QPointF(other.left() - gap, other.top() + offset)); break;
+        case 2: rect.moveTopLeft(QPointF(other.left() + offset, other.bottom() + gap)); break;
+        default: rect.moveBottomLeft(QPointF(other.left() + offset, other.top() - gap)); break;
+        }
+
+        const QVector<QRectF> layout = { other, rect.translated(MonitorLayout::snapOffset(rect, { other })) };
+        const MonitorLayout::Adjacency adjacency = MonitorLayout::adjacency(layout);
+        EXPECT_FALSE(adjacency.overlapped) << "round" << round;
+        EXPECT_EQ(adjacency.neighbours[1], QVector<int>({ 0 })) << "round" << round;
+    }
+}
+
+TEST_F(Tst_MonitorLayout, benchmark)
+{
+    // 每次拖动都要重新计算相邻关系、连通性和吸附，只输出耗时，不依赖机器负载做断言
+    for (int count : { 2, 4, 8, 16 }) {
+        const QVector<QRectF> layout = randomLayout(count, random);
+        QVector<QRectF> others = layout;
+        const QRectF moving = others.takeLast().translated(30, 30);
+
+        const int rounds = 1000;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < rounds; ++i) {
+            const MonitorLayout::Adjacency adjacency = MonitorLayout::adjacency(layout);
+            MonitorLayout::isConnected(adjacency.neighbours);
+            MonitorLayout::connectedDomain(adjacency.neighbours, 0);
+            MonitorLayout::snapOffset(moving, others);
+        }
+        const qreal perFrame = qreal(timer.nsecsElapsed()) / rounds / 1000000;
+        qInfo() << count << "monitors:" << perFrame << "ms per drag move";
+    }
+}
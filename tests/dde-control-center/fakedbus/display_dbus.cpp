@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "display_dbus.h"
+
+#include <QDBusError>
+
+QStringList &displayCalls()
+{
+    static QStringList calls;
+    return calls;
+}
+
+bool FakeDisplay::failApply = false;
+
+FakeDisplay::FakeDisplay(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void FakeDisplay::ApplyChanges()
+{
+    displayCalls() << "ApplyChanges";
+    if (failApply)
+        sendErrorReply(QDBusError::Failed, "apply failed");
+}
+
+void FakeDisplay::Save()
+{
+    displayCalls() << "Save";
+}
+
+void FakeDisplay::ResetChanges()
+{
+    displayCalls() << "ResetChanges";
+}
+
+void FakeDisplay::SetPrimary(const QString &name)
+{
+    displayCalls() << QString("SetPrimary %1").arg(name);
+}
+
+void FakeDisplay::SwitchMode(uchar mode, const QString &name)
+{
+    displayCalls() << QString("SwitchMode %1 %2").arg(mode).arg(name);
+}
+
+FakeDisplayMonitor::FakeDisplayMonitor(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void FakeDisplayMonitor::SetMode(uint mode)
+{
+    displayCalls() << QString("SetMode %1").arg(mode);
+}
+
+void FakeDisplayMonitor::SetModeBySize(ushort width, ushort height)
+{
+    displayCalls() << QString("SetModeBySize %1 %2").arg(width).arg(height);
+}
+
+void FakeDisplayMonitor::SetRotation(ushort rotation)
+{
+    displayCalls() << QString("SetRotation %1").arg(rotation);
+}
+
+void FakeDisplayMonitor::SetPosition(short x, short y)
+{
+    displayCalls() << QString("SetPosition %1 %2").arg(x).arg(y);
+}
+
+void FakeDisplayMonitor::Enable(bool enabled)
+{
+    displayCalls() << QString("Enable %1").arg(enabled);
+}
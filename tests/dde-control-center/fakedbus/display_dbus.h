@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DISPLAY_DBUS_H
+#define DISPLAY_DBUS_H
+
+#include <QDBusContext>
+#include <QObject>
+#include <QStringList>
+
+#define DISPLAY_SERVICE_NAME "com.deepin.daemon.Display"
+#define DISPLAY_SERVICE_PATH "/com/deepin/daemon/Display"
+#define DISPLAY_MONITOR_PATH "/com/deepin/daemon/Display/Monitor_1"
+
+// 记录收到的调用，按到达顺序保存，如 "SetMode 5"、"ApplyChanges"
+QStringList &displayCalls();
+
+class FakeDisplay : public QObject
+    , protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.deepin.daemon.Display")
+
+public:
+    explicit FakeDisplay(QObject *parent = nullptr);
+
+    // 为 true 时 ApplyChanges 返回错误
+    static bool failApply;
+
+public Q_SLOTS:
+    void ApplyChanges();
+    void Save();
+    void ResetChanges();
+    void SetPrimary(const QString &name);
+    void SwitchMode(uchar mode, const QString &name);
+};
+
+class FakeDisplayMonitor : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.deepin.daemon.Display.Monitor")
+
+public:
+    explicit FakeDisplayMonitor(QObject *parent = nullptr);
+
+public Q_SLOTS:
+    void SetMode(uint mode);
+    void SetModeBySize(ushort width, ushort height);
+    void SetRotation(ushort rotation);
+    void SetPosition(short x, short y);
+    void Enable(bool enabled);
+};
+
+#endif // DISPLAY_DBUS_H
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "properties_dbus.h"
+
+#include <QDBusMessage>
+
+namespace {
+FakeProperties *Instance = nullptr;
+}
+
+FakeProperties::FakeProperties(QObject *parent)
+    : QObject(parent)
+{
+    Instance = this;
+    m_values.insert("Name", "speaker");
+    m_values.insert("Volume", 0.5);
+    m_values.insert("Mute", false);
+}
+
+FakeProperties *FakeProperties::instance()
+{
+    return Instance;
+}
+
+void FakeProperties::setValue(const QString &property, const QVariant &value)
+{
+    m_values.insert(property, value);
+}
+
+void FakeProperties::notifyChanged(const QVariantMap &changed, const QStringList &invalidated)
+{
+    QDBusMessage message = QDBusMessage::createSignal(PROPERTIES_SERVICE_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    message << QString(PROPERTIES_INTERFACE) << changed << invalidated;
+    QDBusConnection(PROPERTIES_CONNECTION).send(message);
+}
+
+void FakeProperties::SetVolume(double volume)
+{
+    volumeCalls << volume;
+    m_values.insert("Volume", volume);
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PROPERTIES_DBUS_H
+#define PROPERTIES_DBUS_H
+
+#include <QDBusConnection>
+#include <QObject>
+#include <QVariantMap>
+
+#define PROPERTIES_SERVICE_NAME "com.deepin.dcc.Test"
+#define PROPERTIES_SERVICE_PATH "/com/deepin/dcc/Test"
+#define PROPERTIES_INTERFACE "com.deepin.dcc.Test"
+// 服务端使用单独的连接，测试代码通过 sessionBus 访问
+#define PROPERTIES_CONNECTION "dcc-fake-properties"
+
+class FakeProperties : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.deepin.dcc.Test")
+    Q_PROPERTY(QString Name READ name)
+    Q_PROPERTY(double Volume READ volume)
+    Q_PROPERTY(bool Mute READ mute)
+
+public:
+    explicit FakeProperties(QObject *parent = nullptr);
+
+    static FakeProperties *instance();
+
+    QString name() const { return m_values.value("Name").toString(); }
+    double volume() const { return m_values.value("Volume").toDouble(); }
+    bool mute() const { return m_values.value("Mute").toBool(); }
+
+    // 只修改属性的值，不发出信号
+    void setValue(const QString &property, const QVariant &value);
+    // 发出 PropertiesChanged，不修改属性的值
+    void notifyChanged(const QVariantMap &changed, const QStringList &invalidated = QStringList());
+
+public Q_SLOTS:
+    // 按到达顺序记录写入的值
+    void SetVolume(double volume);
+
+public:
+    QList<double> volumeCalls;
+
+private:
+    QVariantMap m_values;
+};
+
+#endif // PROPERTIES_DBUS_H
@@ -73,3 +73,31 @@ TEST_F(Tst_IndexModel, metaData)
     EXPECT_EQ(3, model->getModelCount());
     EXPECT_EQ(1, model->indexOf(lmd[1]));
 }
+
+TEST_F(Tst_IndexModel, toPinyin)
+{
+    // 只去掉汉字的声调，标题中原有的数字保留
+    EXPECT_EQ(toPinyin("汉字"), QString("hanzi"));
+    EXPECT_EQ(toPinyin("德文2"), QString("dewen2"));
+    EXPECT_EQ(toPinyin("Win1"), QString("Win1"));
+    EXPECT_EQ(toPinyin("汉字 (Win5)"), QString("hanzi (Win5)"));
+}
+
+TEST_F(Tst_IndexModel, sortByPinyin)
+{
+    QList<MetaData> datas;
+    for (const QString &text : { QString("汉字"), QString("Arabic"), QString("德文2"), QString("德文1") }) {
+        MetaData md(text);
+        md.setPinyin(toPinyin(text));
+        datas << md;
+    }
+
+    QList<QString> letters;
+    const QList<MetaData> sorted = sortByPinyin(datas, letters);
+    EXPECT_EQ(letters, QList<QString>({ "A", "D", "H" }));
+
+    QStringList texts;
+    for (const MetaData &md : sorted)
+        texts << (md.section() ? "[" + md.text() + "]" : md.text());
+    EXPECT_EQ(texts, QStringList({ "[A]", "Arabic", "[D]", "德文1", "德文2", "[H]", "汉字" }));
+}
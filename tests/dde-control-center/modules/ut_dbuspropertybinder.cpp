@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "modules/dbuspropertybinder.h"
+#include "properties_dbus.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace dcc;
+
+namespace {
+class Receiver : public QObject
+{
+public:
+    void setName(const QString &value)
+    {
+        name = value;
+        ++nameCount;
+    }
+
+    void setVolume(double value)
+    {
+        volume = value;
+        ++volumeCount;
+    }
+
+public:
+    QString name;
+    double volume = 0;
+    int nameCount = 0;
+    int volumeCount = 0;
+};
+
+// 等待条件成立，超时返回 false
+bool waitFor(const std::function<bool()> &condition)
+{
+    for (int i = 0; i < 100 && !condition(); ++i)
+        QTest::qWait(20);
+    return condition();
+}
+
+// 和模块的 prefetch 一样在其他线程中读取，服务端在主线程中处理请求
+bool prefetchInThread()
+{
+    std::atomic<bool> done(false);
+    std::thread thread([&done] {
+        DBusPropertyBinder::prefetch(PROPERTIES_SERVICE_NAME, PROPERTIES_SERVICE_PATH, PROPERTIES_INTERFACE, QDBusConnection::sessionBus());
+        done = true;
+    });
+    const bool finished = waitFor([&done] { return done.load(); });
+    thread.join();
+    return finished;
+}
+}
+
+class Tst_DBusPropertyBinder : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    FakeProperties *fake = nullptr;
+    Receiver *receiver = nullptr;
+    DBusPropertyBinder *binder = nullptr;
+};
+
+void Tst_DBusPropertyBinder::SetUp()
+{
+    fake = FakeProperties::instance();
+    fake->setValue("Name", "speaker");
+    fake->setValue("Volume", 0.5);
+    fake->setValue("Mute", false);
+
+    receiver = new Receiver;
+    binder = new DBusPropertyBinder(PROPERTIES_SERVICE_NAME, PROPERTIES_SERVICE_PATH, PROPERTIES_INTERFACE, QDBusConnection::sessionBus());
+    binder->bind("Name", receiver, &Receiver::setName);
+    binder->bind("Volume", receiver, &Receiver::setVolume);
+}
+
+void Tst_DBusPropertyBinder::TearDown()
+{
+    delete binder;
+    binder = nullptr;
+    delete receiver;
+    receiver = nullptr;
+}
+
+TEST_F(Tst_DBusPropertyBinder, refresh)
+{
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+
+    // 一次 GetAll 更新所有绑定的属性
+    EXPECT_EQ(receiver->name, QString("speaker"));
+    EXPECT_DOUBLE_EQ(receiver->volume, 0.5);
+    EXPECT_EQ(receiver->nameCount, 1);
+    EXPECT_EQ(receiver->volumeCount, 1);
+}
+
+TEST_F(Tst_DBusPropertyBinder, bindFunction)
+{
+    bool mute = true;
+    binder->bind<bool>("Mute", receiver, [&mute](const bool &value) {
+        mute = value;
+    });
+
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+    EXPECT_FALSE(mute);
+}
+
+TEST_F(Tst_DBusPropertyBinder, propertiesChanged)
+{
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+
+    // 只更新变化的属性
+    fake->notifyChanged({ { "Volume", 0.8 } });
+    ASSERT_TRUE(waitFor([this] { return receiver->volumeCount == 2; }));
+    EXPECT_DOUBLE_EQ(receiver->volume, 0.8);
+    EXPECT_EQ(receiver->nameCount, 1);
+    EXPECT_EQ(refreshed.count(), 1);
+}
+
+TEST_F(Tst_DBusPropertyBinder, invalidatedProperty)
+{
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+
+    // 只通知属性失效时重新读取
+    fake->setValue("Name", "headphone");
+    fake->notifyChanged(QVariantMap(), { "Name" });
+    ASSERT_TRUE(refreshed.wait(3000));
+    EXPECT_EQ(receiver->name, QString("headphone"));
+
+    // 没有绑定的属性失效时不重新读取
+    fake->notifyChanged(QVariantMap(), { "Mute" });
+    EXPECT_FALSE(refreshed.wait(300));
+}
+
+TEST_F(Tst_DBusPropertyBinder, inactive)
+{
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+
+    // 未激活时忽略属性变化，重新激活后通过 refresh 同步
+    binder->setActive(false);
+    fake->setValue("Volume", 0.3);
+    fake->notifyChanged({ { "Volume", 0.3 } });
+    QTest::qWait(300);
+    EXPECT_DOUBLE_EQ(receiver->volume, 0.5);
+
+    binder->setActive(true);
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+    EXPECT_DOUBLE_EQ(receiver->volume, 0.3);
+}
+
+TEST_F(Tst_DBusPropertyBinder, changedWhileRefreshing)
+{
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+
+    // GetAll 返回前收到的新值不会被 GetAll 中更旧的值覆盖
+    binder->refresh();
+    fake->notifyChanged({ { "Volume", 0.9 } });
+    ASSERT_TRUE(refreshed.wait(3000));
+    EXPECT_DOUBLE_EQ(receiver->volume, 0.9);
+    EXPECT_EQ(receiver->name, QString("speaker"));
+}
+
+TEST_F(Tst_DBusPropertyBinder, receiverDestroyed)
+{
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    delete receiver;
+    receiver = nullptr;
+
+    // 接收者销毁后绑定失效
+    binder->refresh();
+    ASSERT_TRUE(refreshed.wait(3000));
+    fake->notifyChanged({ { "Volume", 0.7 } });
+    QTest::qWait(100);
+}
+
+TEST_F(Tst_DBusPropertyBinder, prefetch)
+{
+    ASSERT_TRUE(prefetchInThread());
+
+    // refresh 时立即使用 prefetch 的结果，之后再通过 GetAll 同步一次
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    EXPECT_EQ(receiver->name, QString("speaker"));
+    EXPECT_DOUBLE_EQ(receiver->volume, 0.5);
+    ASSERT_TRUE(refreshed.wait(3000));
+
+    // prefetch 的结果只使用一次
+    EXPECT_TRUE(DBusPropertyBinder::takePrefetched(PROPERTIES_SERVICE_NAME, PROPERTIES_SERVICE_PATH, PROPERTIES_INTERFACE).isEmpty());
+}
+
+TEST_F(Tst_DBusPropertyBinder, clearPrefetched)
+{
+    ASSERT_TRUE(prefetchInThread());
+
+    // 预初始化结束后清除的结果不再使用
+    DBusPropertyBinder::clearPrefetched();
+    QSignalSpy refreshed(binder, &DBusPropertyBinder::refreshed);
+    binder->refresh();
+    EXPECT_EQ(receiver->nameCount, 0);
+    ASSERT_TRUE(refreshed.wait(3000));
+    EXPECT_EQ(receiver->name, QString("speaker"));
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "modules/dbuswritecoalescer.h"
+#include "properties_dbus.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "gtest/gtest.h"
+
+using namespace dcc;
+
+namespace {
+DBusWriteCoalescer::Call setVolume(double volume)
+{
+    return [volume] {
+        QDBusMessage message = QDBusMessage::createMethodCall(PROPERTIES_SERVICE_NAME, PROPERTIES_SERVICE_PATH, PROPERTIES_INTERFACE, "SetVolume");
+        message << volume;
+        return QDBusPendingCall(QDBusConnection::sessionBus().asyncCall(message));
+    };
+}
+
+DBusWriteCoalescer::Call callMissing()
+{
+    return [] {
+        QDBusMessage message = QDBusMessage::createMethodCall(PROPERTIES_SERVICE_NAME, PROPERTIES_SERVICE_PATH, PROPERTIES_INTERFACE, "Missing");
+        return QDBusPendingCall(QDBusConnection::sessionBus().asyncCall(message));
+    };
+}
+}
+
+class Tst_DBusWriteCoalescer : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    FakeProperties *fake = nullptr;
+    DBusWriteCoalescer *coalescer = nullptr;
+    QObject *sink = nullptr;
+};
+
+void Tst_DBusWriteCoalescer::SetUp()
+{
+    fake = FakeProperties::instance();
+    fake->volumeCalls.clear();
+    coalescer = new DBusWriteCoalescer;
+    sink = new QObject;
+}
+
+void Tst_DBusWriteCoalescer::TearDown()
+{
+    delete sink;
+    sink = nullptr;
+    delete coalescer;
+    coalescer = nullptr;
+}
+
+TEST_F(Tst_DBusWriteCoalescer, lastValueWins)
+{
+    QSignalSpy written(coalescer, &DBusWriteCoalescer::written);
+
+    // 第一个值立即发送，返回前的请求只保留最新的一个
+    coalescer->write(sink, "Volume", setVolume(0.1));
+    coalescer->write(sink, "Volume", setVolume(0.2));
+    coalescer->write(sink, "Volume", setVolume(0.3));
+    coalescer->write(sink, "Volume", setVolume(0.4));
+    EXPECT_TRUE(coalescer->isPending(sink, "Volume"));
+
+    ASSERT_TRUE(written.wait(3000));
+    EXPECT_EQ(fake->volumeCalls, QList<double>({ 0.1, 0.4 }));
+    EXPECT_DOUBLE_EQ(fake->volume(), 0.4);
+    EXPECT_FALSE(coalescer->isPending(sink, "Volume"));
+
+    // 只在最新的值写入后通知一次
+    EXPECT_EQ(written.count(), 1);
+    EXPECT_EQ(written.first().at(0).value<QObject *>(), sink);
+    EXPECT_EQ(written.first().at(1).toString(), QString("Volume"));
+}
+
+TEST_F(Tst_DBusWriteCoalescer, settleOrdering)
+{
+    QSignalSpy written(coalescer, &DBusWriteCoalescer::written);
+
+    coalescer->write(sink, "Volume", setVolume(0.1));
+    ASSERT_TRUE(written.wait(3000));
+
+    // 上一个调用返回后新的请求立即发送，不等待其他请求
+    coalescer->write(sink, "Volume", setVolume(0.2));
+    ASSERT_TRUE(written.wait(3000));
+    coalescer->write(sink, "Volume", setVolume(0.3));
+    coalescer->write(sink, "Volume", setVolume(0.5));
+    ASSERT_TRUE(written.wait(3000));
+
+    EXPECT_EQ(fake->volumeCalls, QList<double>({ 0.1, 0.2, 0.3, 0.5 }));
+    EXPECT_EQ(written.count(), 3);
+}
+
+TEST_F(Tst_DBusWriteCoalescer, propertiesAreIndependent)
+{
+    QObject source;
+    QSignalSpy written(coalescer, &DBusWriteCoalescer::written);
+
+    // 不同对象或属性的写入互不合并
+    coalescer->write(sink, "Volume", setVolume(0.1));
+    coalescer->write(&source, "Volume", setVolume(0.2));
+    coalescer->write(sink, "Balance", setVolume(0.3));
+
+    for (int i = 0; i < 100 && written.count() < 3; ++i)
+        QTest::qWait(20);
+    EXPECT_EQ(written.count(), 3);
+    EXPECT_EQ(fake->volumeCalls, QList<double>({ 0.1, 0.2, 0.3 }));
+}
+
+TEST_F(Tst_DBusWriteCoalescer, metrics)
+{
+    QSignalSpy written(coalescer, &DBusWriteCoalescer::written);
+
+    coalescer->write(sink, "Volume", setVolume(0.1));
+    coalescer->write(sink, "Volume", setVolume(0.2));
+    coalescer->write(sink, "Volume", setVolume(0.3));
+    coalescer->write(sink, "Volume", setVolume(0.4));
+    ASSERT_TRUE(written.wait(3000));
+
+    const DBusWriteCoalescer::Metrics volume = coalescer->metrics(sink, "Volume");
+    EXPECT_EQ(volume.requested, 4u);
+    EXPECT_EQ(volume.sent, 2u);
+    EXPECT_EQ(volume.dropped, 2u);
+    EXPECT_EQ(volume.failed, 0u);
+
+    // 返回错误的调用计入 failed
+    coalescer->write(sink, "Missing", callMissing());
+    ASSERT_TRUE(written.wait(3000));
+    const DBusWriteCoalescer::Metrics missing = coalescer->metrics(sink, "Missing");
+    EXPECT_EQ(missing.requested, 1u);
+    EXPECT_EQ(missing.sent, 1u);
+    EXPECT_EQ(missing.failed, 1u);
+
+    // 总计包含所有的对象和属性
+    const DBusWriteCoalescer::Metrics &total = coalescer->metrics();
+    EXPECT_EQ(total.requested, 5u);
+    EXPECT_EQ(total.sent, 3u);
+    EXPECT_EQ(total.dropped, 2u);
+    EXPECT_EQ(total.failed, 1u);
+}
+
+TEST_F(Tst_DBusWriteCoalescer, objectDestroyed)
+{
+    QSignalSpy written(coalescer, &DBusWriteCoalescer::written);
+
+    coalescer->write(sink, "Volume", setVolume(0.1));
+    coalescer->write(sink, "Volume", setVolume(0.2));
+
+    // 对象销毁后丢弃还没有发送的请求
+    delete sink;
+    sink = nullptr;
+    EXPECT_FALSE(written.wait(500));
+    EXPECT_EQ(fake->volumeCalls, QList<double>({ 0.1 }));
+}
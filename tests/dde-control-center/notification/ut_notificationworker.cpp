@@ -2,12 +2,47 @@
 //
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
+#define private public
 #include "../src/frame/modules/notification/notificationworker.h"
+#undef private
+#include "../src/frame/modules/notification/model/appitemmodel.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QSignalSpy>
+#include <QTest>
 
 #include <gtest/gtest.h>
 
 using namespace dcc::notification;
 
+static AppItemModel *findApp(NotificationModel &model, const QString &id)
+{
+    for (int i = 0; i < model.getAppSize(); ++i) {
+        if (model.getAppModel(i)->getActName() == id)
+            return model.getAppModel(i);
+    }
+    return nullptr;
+}
+
+static int appCount(NotificationModel &model, const QString &id)
+{
+    int count = 0;
+    for (int i = 0; i < model.getAppSize(); ++i) {
+        if (model.getAppModel(i)->getActName() == id)
+            ++count;
+    }
+    return count;
+}
+
+// 通过 session bus 发出服务端的 AppInfoChanged 信号
+static void sendAppInfoChanged(const QString &id, uint item, const QVariant &value)
+{
+    QDBusMessage msg = QDBusMessage::createSignal("/com/deepin/dde/Notification", "com.deepin.dde.Notification", "AppInfoChanged");
+    msg << id << item << QVariant::fromValue(QDBusVariant(value));
+    QDBusConnection::sessionBus().send(msg);
+}
+
 class Tst_NotificationWorker : public testing::Test
 {
 public:
@@ -61,3 +96,76 @@ TEST_F(Tst_NotificationWorker, FullTest)
     worker.setSystemSetting(0, false);
     worker.deactive();
 }
+
+TEST_F(Tst_NotificationWorker, appsAdded)
+{
+    NotificationModel model;
+    QSignalSpy spy(&model, &NotificationModel::appListChanged);
+
+    AppItemModel *code = new AppItemModel(&model);
+    code->setActName("code");
+    AppItemModel *editor = new AppItemModel(&model);
+    editor->setActName("deepin-editor");
+    model.appsAdded({ code, editor });
+
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_EQ(model.getAppSize(), 2);
+    EXPECT_EQ(model.getAppModel(1)->getActName(), QString("deepin-editor"));
+
+    model.appRemoved("code");
+    EXPECT_EQ(model.getAppSize(), 1);
+}
+
+TEST_F(Tst_NotificationWorker, appInfoChangedDispatchedById)
+{
+    NotificationModel model;
+    NotificationWorker worker(&model);
+    QSignalSpy listSpy(&model, &NotificationModel::appListChanged);
+    worker.active(true);
+    ASSERT_TRUE(listSpy.wait());
+
+    AppItemModel *code = findApp(model, "code");
+    AppItemModel *editor = findApp(model, "deepin-editor");
+    ASSERT_TRUE(code);
+    ASSERT_TRUE(editor);
+    EXPECT_EQ(worker.m_appItems.value("code").data(), code);
+    EXPECT_TRUE(code->isAllowNotify());
+    EXPECT_TRUE(editor->isAllowNotify());
+
+    // 只有 id 对应的应用收到变化
+    QSignalSpy codeSpy(code, &AppItemModel::allowNotifyChanged);
+    QSignalSpy editorSpy(editor, &AppItemModel::allowNotifyChanged);
+    sendAppInfoChanged("code", AppItemModel::ENABELNOTIFICATION, false);
+    ASSERT_TRUE(codeSpy.wait());
+    EXPECT_FALSE(code->isAllowNotify());
+    EXPECT_TRUE(editor->isAllowNotify());
+    EXPECT_EQ(editorSpy.count(), 0);
+
+    // 未知的应用直接忽略
+    sendAppInfoChanged("unknown-app", AppItemModel::ENABELNOTIFICATION, false);
+    sendAppInfoChanged("deepin-editor", AppItemModel::ENABELSOUND, false);
+    ASSERT_TRUE(QTest::qWaitFor([editor] { return !editor->isNotifySound(); }));
+    EXPECT_EQ(editorSpy.count(), 0);
+    EXPECT_FALSE(code->isAllowNotify());
+}
+
+TEST_F(Tst_NotificationWorker, supersededLoadDiscarded)
+{
+    NotificationModel model;
+    NotificationWorker worker(&model);
+
+    worker.loadApps({ "code" });
+    QPointer<AppItemModel> stale = worker.m_appItems.value("code");
+    ASSERT_TRUE(stale);
+
+    // 重新加载后，之前还未返回的一批应用被丢弃，不加入 model
+    QSignalSpy listSpy(&model, &NotificationModel::appListChanged);
+    worker.active(true);
+    ASSERT_TRUE(QTest::qWaitFor([&stale] { return stale.isNull(); }));
+    ASSERT_TRUE(QTest::qWaitFor([&listSpy] { return listSpy.count() > 0; }));
+
+    EXPECT_EQ(listSpy.count(), 1);
+    EXPECT_EQ(appCount(model, "code"), 1);
+    EXPECT_NE(findApp(model, "code"), stale.data());
+    EXPECT_EQ(model.getAppSize(), worker.m_appItems.size());
+}
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define private public
+#include "window/modules/personalization/themepiccache.h"
+#undef private
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include "gtest/gtest.h"
+
+using namespace DCC_NAMESPACE::personalization;
+
+namespace {
+const QByteArray Svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="16" height="16">
+<rect width="16" height="16" fill="#0081ff"/>
+</svg>
+)";
+
+// 64x64 的 ARGB32 图片占用 16KB
+const QSize PicSize(64, 64);
+const int PicCost = 16;
+
+// 等待指定路径的图片绘制完成
+bool waitForImage(QSignalSpy &spy, const QString &path)
+{
+    for (int i = 0; i < 10; ++i) {
+        for (const QList<QVariant> &args : spy) {
+            if (args.at(0).toString() == path)
+                return true;
+        }
+        if (!spy.wait(1000))
+            return false;
+    }
+    return false;
+}
+}
+
+class Tst_ThemePicCache : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    // 写入一个新的 svg 文件，每个文件对应缓存中单独的一项
+    QString writeSvg(const QString &name);
+
+    QTemporaryDir dir;
+    ThemePicCache *cache = nullptr;
+};
+
+void Tst_ThemePicCache::SetUp()
+{
+    // 每个测试使用单独的缓存，避免其他测试的绘制结果影响缓存大小
+    cache = new ThemePicCache;
+}
+
+void Tst_ThemePicCache::TearDown()
+{
+    QThreadPool::globalInstance()->waitForDone();
+    delete cache;
+    cache = nullptr;
+}
+
+QString Tst_ThemePicCache::writeSvg(const QString &name)
+{
+    const QString path = dir.path() + "/" + name + ".svg";
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly))
+        file.write(Svg);
+    return path;
+}
+
+TEST_F(Tst_ThemePicCache, render)
+{
+    QSignalSpy ready(cache, &ThemePicCache::imageReady);
+    const QString path = writeSvg("render");
+
+    // 第一次请求在后台绘制，返回空图片
+    EXPECT_TRUE(cache->image(path, PicSize, 1).isNull());
+    ASSERT_TRUE(waitForImage(ready, path));
+
+    const QImage image = cache->image(path, PicSize, 1);
+    ASSERT_FALSE(image.isNull());
+    EXPECT_EQ(image.size(), PicSize);
+    EXPECT_EQ(cache->cost(), PicCost);
+
+    // 缩放比例不同时单独绘制
+    EXPECT_TRUE(cache->image(path, PicSize, 2).isNull());
+    ready.clear();
+    ASSERT_TRUE(waitForImage(ready, path));
+    EXPECT_EQ(cache->image(path, PicSize, 2).size(), PicSize * 2);
+    EXPECT_EQ(cache->cost(), PicCost * 5);
+}
+
+TEST_F(Tst_ThemePicCache, costLimit)
+{
+    QSignalSpy ready(cache, &ThemePicCache::imageReady);
+
+    // 缓存总大小不超过限制，超出时淘汰最久没有使用的图片
+    cache->setCostLimit(PicCost * 2 + PicCost / 2);
+    EXPECT_EQ(cache->costLimit(), PicCost * 2 + PicCost / 2);
+    EXPECT_EQ(cache->cost(), 0);
+
+    QStringList paths;
+    for (int i = 0; i < 3; ++i) {
+        const QString path = writeSvg(QString("limit%1").arg(i));
+        paths << path;
+        cache->image(path, PicSize, 1);
+        ASSERT_TRUE(waitForImage(ready, path));
+        EXPECT_LE(cache->cost(), cache->costLimit());
+    }
+
+    EXPECT_EQ(cache->cost(), PicCost * 2);
+    EXPECT_FALSE(cache->image(paths.at(2), PicSize, 1).isNull());
+
+    // 被淘汰的图片再次请求时重新绘制
+    EXPECT_TRUE(cache->image(paths.at(0), PicSize, 1).isNull());
+    ready.clear();
+    ASSERT_TRUE(waitForImage(ready, paths.at(0)));
+    EXPECT_EQ(cache->cost(), PicCost * 2);
+}
+
+TEST_F(Tst_ThemePicCache, oversizeImage)
+{
+    QSignalSpy ready(cache, &ThemePicCache::imageReady);
+
+    // 单张图片超出限制时仍然放入缓存，占满整个缓存
+    cache->setCostLimit(PicCost / 2);
+    const QString path = writeSvg("oversize");
+    cache->image(path, PicSize, 1);
+    ASSERT_TRUE(waitForImage(ready, path));
+
+    EXPECT_FALSE(cache->image(path, PicSize, 1).isNull());
+    EXPECT_EQ(cache->cost(), cache->costLimit());
+}
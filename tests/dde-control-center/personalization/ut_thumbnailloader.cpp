@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define private public
+#include "modules/personalization/thumbnailloader.h"
+#undef private
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include "gtest/gtest.h"
+
+using namespace dcc::personalization;
+
+class Tst_ThumbnailLoader : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    QString writeFile(const QString &name);
+    QStringList cacheFiles() const;
+    ThumbnailLoader *createLoader();
+
+    QTemporaryDir dir;
+    QString cacheDir;
+    QList<ThumbnailLoader *> loaders;
+};
+
+void Tst_ThumbnailLoader::SetUp()
+{
+    cacheDir = dir.path() + "/theme-thumbnails";
+}
+
+void Tst_ThumbnailLoader::TearDown()
+{
+    qDeleteAll(loaders);
+    loaders.clear();
+}
+
+QString Tst_ThumbnailLoader::writeFile(const QString &name)
+{
+    const QString path = dir.path() + "/" + name;
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly))
+        file.write(name.toUtf8());
+    return path;
+}
+
+QStringList Tst_ThumbnailLoader::cacheFiles() const
+{
+    return QDir(cacheDir).entryList(QDir::Files, QDir::Name);
+}
+
+ThumbnailLoader *Tst_ThumbnailLoader::createLoader()
+{
+    // 只测试缓存，不调用 Thumbnail
+    ThumbnailLoader *loader = new ThumbnailLoader(nullptr);
+    loader->m_cacheDir = cacheDir;
+    loaders << loader;
+    return loader;
+}
+
+TEST_F(Tst_ThumbnailLoader, cacheName)
+{
+    ThumbnailLoader *loader = createLoader();
+    const QString source = writeFile("thumbnail.png");
+
+    // 文件名为 (类型/id) 的哈希和主题目录的修改时间，保留原来的后缀
+    const QString name = QCryptographicHash::hash(QString("gtk/Deepin Dark").toUtf8(), QCryptographicHash::Md5).toHex();
+    const QString path = loader->saveCache({ "gtk", "Deepin Dark", 1000 }, source);
+    EXPECT_EQ(path, cacheDir + "/" + name + "-1000.png");
+    EXPECT_EQ(cacheFiles(), QStringList({ name + "-1000.png" }));
+
+    // 没有后缀时也能找到缓存
+    EXPECT_EQ(loader->saveCache({ "icon", "bloom", 1000 }, writeFile("thumbnail")), cacheDir + "/" + loader->cacheName("icon", "bloom") + "-1000");
+    EXPECT_EQ(loader->findCache({ "icon", "bloom", 1000 }), cacheDir + "/" + loader->cacheName("icon", "bloom") + "-1000");
+
+    // 没有主题目录的修改时间时不缓存
+    EXPECT_TRUE(loader->saveCache({ "gtk", "deepin", 0 }, source).isEmpty());
+    EXPECT_TRUE(loader->findCache({ "gtk", "deepin", 0 }).isEmpty());
+}
+
+TEST_F(Tst_ThumbnailLoader, findCache)
+{
+    ThumbnailLoader *loader = createLoader();
+    const QString path = loader->saveCache({ "gtk", "deepin", 1000 }, writeFile("thumbnail.svg"));
+    ASSERT_FALSE(path.isEmpty());
+
+    EXPECT_EQ(loader->findCache({ "gtk", "deepin", 1000 }), path);
+    EXPECT_TRUE(loader->findCache({ "gtk", "deepin-dark", 1000 }).isEmpty());
+    EXPECT_TRUE(loader->findCache({ "icon", "deepin", 1000 }).isEmpty());
+
+    // 重新启动后从缓存目录中读取
+    ThumbnailLoader *reloaded = createLoader();
+    EXPECT_EQ(reloaded->findCache({ "gtk", "deepin", 1000 }), path);
+
+    // 缓存文件被删除后不再使用
+    QFile::remove(path);
+    EXPECT_TRUE(reloaded->findCache({ "gtk", "deepin", 1000 }).isEmpty());
+}
+
+TEST_F(Tst_ThumbnailLoader, stale)
+{
+    ThumbnailLoader *loader = createLoader();
+    const QString source = writeFile("thumbnail.png");
+    const QString old = loader->saveCache({ "gtk", "deepin", 1000 }, source);
+
+    // 主题目录的修改时间变化后缓存过期
+    EXPECT_TRUE(loader->findCache({ "gtk", "deepin", 2000 }).isEmpty());
+
+    // 保存新的缩略图时删除旧的缓存
+    const QString path = loader->saveCache({ "gtk", "deepin", 2000 }, source);
+    EXPECT_FALSE(QFile::exists(old));
+    EXPECT_EQ(loader->findCache({ "gtk", "deepin", 2000 }), path);
+    EXPECT_TRUE(loader->findCache({ "gtk", "deepin", 1000 }).isEmpty());
+    EXPECT_EQ(cacheFiles().size(), 1);
+}
+
+TEST_F(Tst_ThumbnailLoader, cleanupDuplicates)
+{
+    // 同一个主题残留多个缓存时，读取缓存目录时只保留最新的
+    ASSERT_TRUE(QDir().mkpath(cacheDir));
+    ThumbnailLoader *loader = createLoader();
+    const QString name = loader->cacheName("gtk", "deepin");
+    const QString source = writeFile("thumbnail.png");
+    ASSERT_TRUE(QFile::copy(source, cacheDir + "/" + name + "-1000.png"));
+    ASSERT_TRUE(QFile::copy(source, cacheDir + "/" + name + "-3000.png"));
+    ASSERT_TRUE(QFile::copy(source, cacheDir + "/" + name + "-2000.png"));
+
+    EXPECT_EQ(loader->findCache({ "gtk", "deepin", 3000 }), cacheDir + "/" + name + "-3000.png");
+    EXPECT_EQ(cacheFiles(), QStringList({ name + "-3000.png" }));
+}
+
+TEST_F(Tst_ThumbnailLoader, requestFromCache)
+{
+    ThumbnailLoader *loader = createLoader();
+    QDir(dir.path()).mkdir("theme");
+    const QString themePath = dir.path() + "/theme";
+    const qint64 mtime = QFileInfo(themePath).lastModified().toMSecsSinceEpoch();
+    const QString path = loader->saveCache({ "gtk", "deepin", mtime }, writeFile("thumbnail.png"));
+    ASSERT_FALSE(path.isEmpty());
+
+    // 主题没有变化时直接使用缓存，不调用 Thumbnail
+    QSignalSpy ready(loader, &ThumbnailLoader::thumbnailReady);
+    loader->request("gtk", "deepin", themePath);
+    ASSERT_EQ(ready.count(), 1);
+    EXPECT_EQ(ready.first().at(2).toString(), path);
+    EXPECT_EQ(loader->m_running, 0);
+    EXPECT_TRUE(loader->m_queue.isEmpty());
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/window/search/searchindex.h"
+
+#include <QBuffer>
+#include <QTemporaryDir>
+
+#include "gtest/gtest.h"
+
+using namespace DCC_NAMESPACE::search;
+
+namespace {
+const QByteArray Translation = R"(<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="zh_CN">
+<context>
+    <name>dccV20::display::BrightnessWidget</name>
+    <message>
+        <source>Brightness</source>
+        <translation>亮度</translation>
+        <extra-child_page>Brightness</extra-child_page>
+        <extra-contents_path>/display/Brightness</extra-contents_path>
+    </message>
+    <message>
+        <source>Night Shift</source>
+        <translation type="unfinished"></translation>
+        <extra-contents_path>/display/Brightness</extra-contents_path>
+    </message>
+    <message>
+        <source>Not searchable</source>
+        <translation>不可搜索</translation>
+    </message>
+    <message>
+        <source>Touch Screen</source>
+        <translation>触摸屏</translation>
+        <extra-child_page_hide>Touch Screen</extra-child_page_hide>
+        <extra-contents_path>/display/Touch Screen</extra-contents_path>
+    </message>
+</context>
+</TS>
+)";
+}
+
+class Tst_SearchIndex : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    // 解析 Translation 并以 version 写入索引文件
+    bool writeIndex(const QString &version);
+
+    QTemporaryDir dir;
+    QString indexFile;
+    SearchIndexData source;
+};
+
+void Tst_SearchIndex::SetUp()
+{
+    indexFile = dir.path() + "/dde-control-center_zh_CN.idx";
+
+    QBuffer buffer;
+    buffer.setData(Translation);
+    buffer.open(QIODevice::ReadOnly);
+    ASSERT_TRUE(SearchIndex::parseTranslation(&buffer, source));
+}
+
+void Tst_SearchIndex::TearDown()
+{
+
+}
+
+bool Tst_SearchIndex::writeIndex(const QString &version)
+{
+    QFile file(indexFile);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && SearchIndex::write(source, version, &file);
+}
+
+TEST_F(Tst_SearchIndex, parseTranslation)
+{
+    // 只提取带有 extra-contents_path 的条目，没有翻译时使用原文
+    ASSERT_EQ(source.entries.size(), 3);
+    EXPECT_EQ(source.entries.at(0).source, QString("Brightness"));
+    EXPECT_EQ(source.entries.at(0).translation, QString("亮度"));
+    EXPECT_EQ(source.entries.at(0).childPage, QString("Brightness"));
+    EXPECT_EQ(source.entries.at(0).contentsPath, QString("/display/Brightness"));
+    EXPECT_EQ(source.entries.at(1).translation, QString("Night Shift"));
+    EXPECT_EQ(source.childPages, QStringList({ "Brightness" }));
+    EXPECT_EQ(source.hiddenChildPages, QStringList({ "Touch Screen" }));
+}
+
+TEST_F(Tst_SearchIndex, load)
+{
+    ASSERT_TRUE(writeIndex("5.5.1"));
+
+    SearchIndex index;
+    ASSERT_TRUE(index.open(indexFile, "5.5.1"));
+
+    SearchIndexData data;
+    ASSERT_TRUE(index.read(data));
+    ASSERT_EQ(data.entries.size(), source.entries.size());
+    for (int i = 0; i < data.entries.size(); ++i) {
+        EXPECT_EQ(data.entries.at(i).source, source.entries.at(i).source);
+        EXPECT_EQ(data.entries.at(i).translation, source.entries.at(i).translation);
+        EXPECT_EQ(data.entries.at(i).childPage, source.entries.at(i).childPage);
+        EXPECT_EQ(data.entries.at(i).contentsPath, source.entries.at(i).contentsPath);
+    }
+    EXPECT_EQ(data.childPages, source.childPages);
+    EXPECT_EQ(data.hiddenChildPages, source.hiddenChildPages);
+}
+
+TEST_F(Tst_SearchIndex, stale)
+{
+    ASSERT_TRUE(writeIndex("5.5.1"));
+
+    // 构建版本不同时索引已过期，需要重新解析 .ts
+    SearchIndex index;
+    EXPECT_FALSE(index.open(indexFile, "5.5.2"));
+    EXPECT_FALSE(index.isValid());
+    EXPECT_FALSE(index.open(indexFile, QString()));
+
+    EXPECT_TRUE(index.open(indexFile, "5.5.1"));
+    EXPECT_TRUE(index.isValid());
+}
+
+TEST_F(Tst_SearchIndex, invalid)
+{
+    SearchIndex index;
+    EXPECT_FALSE(index.open(dir.path() + "/missing.idx", "5.5.1"));
+
+    // 文件被截断时不读取
+    ASSERT_TRUE(writeIndex("5.5.1"));
+    QFile file(indexFile);
+    ASSERT_TRUE(file.resize(file.size() - 4));
+    EXPECT_FALSE(index.open(indexFile, "5.5.1"));
+
+    QFile garbage(indexFile);
+    ASSERT_TRUE(garbage.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    garbage.write(QByteArray(128, 'x'));
+    garbage.close();
+    EXPECT_FALSE(index.open(indexFile, "5.5.1"));
+}
+
+TEST_F(Tst_SearchIndex, indexPath)
+{
+    EXPECT_EQ(SearchIndex::indexPath(":/translations/dde-control-center_zh_CN.ts"),
+              SearchIndexDirectory + "dde-control-center_zh_CN.idx");
+    EXPECT_TRUE(SearchIndexDirectory.endsWith("/dde-control-center/search-index/"));
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/window/search/searchtextindex.h"
+
+#include "gtest/gtest.h"
+
+using namespace DCC_NAMESPACE::search;
+
+class Tst_SearchTextIndex : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    SearchTextIndex *index = nullptr;
+};
+
+void Tst_SearchTextIndex::SetUp()
+{
+    index = new SearchTextIndex();
+    index->insert(0, { "Display --> Brightness" }, 10);
+    index->insert(1, { "Sound --> Output / Output Volume" }, 20);
+    index->insert(2, { "Display --> Night Shift" }, 10);
+    index->insert(3, { "显示 --> 亮度", "xianshi --> liangdu", "xsld" }, 10);
+}
+
+void Tst_SearchTextIndex::TearDown()
+{
+    delete index;
+    index = nullptr;
+}
+
+TEST_F(Tst_SearchTextIndex, search)
+{
+    EXPECT_EQ(index->count(), 4);
+
+    // 不区分大小写，超过3个字符时需要确认完整匹配
+    EXPECT_EQ(index->search("brightness"), QList<int>({ 0 }));
+    EXPECT_EQ(index->search("bright ness"), QList<int>());
+    EXPECT_TRUE(index->search("volumes").isEmpty());
+
+    // 短查询直接使用片段的文档列表
+    EXPECT_EQ(index->search("亮"), QList<int>({ 3 }));
+    EXPECT_EQ(index->search("xsl"), QList<int>({ 3 }));
+    EXPECT_EQ(index->search("liangdu"), QList<int>({ 3 }));
+}
+
+TEST_F(Tst_SearchTextIndex, rank)
+{
+    // 开头匹配 > 单词开头匹配 > 其他位置匹配
+    EXPECT_EQ(index->search("display"), QList<int>({ 0, 2 }));
+    EXPECT_EQ(index->search("out").first(), 1);
+    EXPECT_EQ(index->search("sh"), QList<int>({ 2, 3 }));
+
+    // 同一级别内模块权重高的在前
+    index->insert(4, { "Power --> Display Off" }, 30);
+    EXPECT_EQ(index->search("display"), QList<int>({ 0, 2, 4 }));
+    index->insert(5, { "Display Off" }, 30);
+    EXPECT_EQ(index->search("display").first(), 5);
+
+    EXPECT_EQ(index->search("display", 2).size(), 2);
+    EXPECT_TRUE(index->search("display", 0).isEmpty());
+}
+
+TEST_F(Tst_SearchTextIndex, remove)
+{
+    index->remove(0);
+    EXPECT_FALSE(index->contains(0));
+    EXPECT_EQ(index->search("display"), QList<int>({ 2 }));
+    EXPECT_TRUE(index->search("brightness").isEmpty());
+
+    // 重新插入相同id会替换原有数据
+    index->insert(2, { "Display --> Scale" }, 10);
+    EXPECT_EQ(index->search("night").size(), 0);
+    EXPECT_EQ(index->search("scale"), QList<int>({ 2 }));
+
+    index->clear();
+    EXPECT_EQ(index->count(), 0);
+    EXPECT_TRUE(index->search("sound").isEmpty());
+}
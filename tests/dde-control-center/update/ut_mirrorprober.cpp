@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/update/mirrorprober.h"
+
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace dcc::update;
+
+namespace {
+// 监听队列已满的端口，新的连接会一直等待，用于模拟很慢的镜像
+class StalledServer
+{
+public:
+    StalledServer()
+        : m_fd(::socket(AF_INET, SOCK_STREAM, 0))
+        , m_port(0)
+    {
+        sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (::bind(m_fd, reinterpret_cast<sockaddr *>(&addr), len) != 0 || ::listen(m_fd, 0) != 0)
+            return;
+        ::getsockname(m_fd, reinterpret_cast<sockaddr *>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+
+        // 占满监听队列
+        m_filler.connectToHost(QHostAddress::LocalHost, m_port);
+        m_filler.waitForConnected(1000);
+    }
+
+    ~StalledServer()
+    {
+        ::close(m_fd);
+    }
+
+    inline quint16 port() const { return m_port; }
+
+private:
+    int m_fd;
+    quint16 m_port;
+    QTcpSocket m_filler;
+};
+
+QString localUrl(quint16 port)
+{
+    return QString("http://127.0.0.1:%1/deepin/").arg(port);
+}
+}
+
+class Tst_MirrorProber : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    MirrorProber *prober = nullptr;
+};
+
+void Tst_MirrorProber::SetUp()
+{
+    prober = new MirrorProber();
+    prober->setTimeout(500);
+}
+
+void Tst_MirrorProber::TearDown()
+{
+    delete prober;
+    prober = nullptr;
+}
+
+TEST_F(Tst_MirrorProber, computeResult)
+{
+    MirrorProber::Result result = MirrorProber::computeResult({ 30, 10, 20 }, 1);
+    EXPECT_EQ(result.latency, 20);
+    EXPECT_EQ(result.jitter, 6);
+    EXPECT_EQ(result.succeeded, 3);
+    EXPECT_EQ(result.failed, 1);
+
+    EXPECT_EQ(MirrorProber::computeResult({ 10, 20 }, 0).latency, 15);
+    EXPECT_EQ(MirrorProber::computeResult({}, 2).latency, int(MirrorProber::TimeoutLatency));
+}
+
+TEST_F(Tst_MirrorProber, reachable)
+{
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    QList<MirrorProber::Result> results;
+    QObject::connect(prober, &MirrorProber::resultReady, [&results](int, const MirrorProber::Result &result) {
+        results << result;
+    });
+    QSignalSpy finished(prober, &MirrorProber::finished);
+
+    prober->setSampleCount(3);
+    prober->probe({ localUrl(server.serverPort()) });
+    EXPECT_TRUE(prober->isRunning());
+    ASSERT_TRUE(finished.wait(3000));
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results.first().succeeded, 3);
+    EXPECT_LT(results.first().latency, int(MirrorProber::TimeoutLatency));
+    EXPECT_FALSE(prober->isRunning());
+}
+
+TEST_F(Tst_MirrorProber, unreachable)
+{
+    quint16 closedPort = 0;
+    {
+        QTcpServer server;
+        ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+        closedPort = server.serverPort();
+    }
+
+    QList<MirrorProber::Result> results;
+    QObject::connect(prober, &MirrorProber::resultReady, [&results](int, const MirrorProber::Result &result) {
+        results << result;
+    });
+    QSignalSpy finished(prober, &MirrorProber::finished);
+
+    prober->probe({ localUrl(closedPort), QString("not a url") });
+    ASSERT_TRUE(finished.wait(3000));
+
+    ASSERT_EQ(results.size(), 2);
+    for (const MirrorProber::Result &result : results) {
+        EXPECT_EQ(result.succeeded, 0);
+        EXPECT_EQ(result.latency, int(MirrorProber::TimeoutLatency));
+    }
+}
+
+TEST_F(Tst_MirrorProber, concurrency)
+{
+    StalledServer stalled;
+    ASSERT_NE(stalled.port(), 0);
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+
+    QList<int> order;
+    QObject::connect(prober, &MirrorProber::resultReady, [&order](int index, const MirrorProber::Result &) {
+        order << index;
+    });
+    QSignalSpy finished(prober, &MirrorProber::finished);
+
+    // 同时只测试一个镜像时，第二个镜像要等第一个超时
+    prober->setConcurrency(1);
+    prober->probe({ localUrl(stalled.port()), localUrl(server.serverPort()) });
+    ASSERT_TRUE(finished.wait(3000));
+    EXPECT_EQ(order, QList<int>({ 0, 1 }));
+
+    // 并行测试时，慢的镜像不会阻塞其他镜像
+    order.clear();
+    prober->setConcurrency(2);
+    prober->probe({ localUrl(stalled.port()), localUrl(server.serverPort()) });
+    ASSERT_TRUE(finished.wait(3000));
+    EXPECT_EQ(order, QList<int>({ 1, 0 }));
+}
+
+TEST_F(Tst_MirrorProber, abort)
+{
+    StalledServer stalled;
+    ASSERT_NE(stalled.port(), 0);
+
+    QSignalSpy ready(prober, &MirrorProber::resultReady);
+    QSignalSpy finished(prober, &MirrorProber::finished);
+
+    // 取消后超时定时器不再触发
+    prober->probe({ localUrl(stalled.port()) });
+    EXPECT_TRUE(prober->isRunning());
+    prober->abort();
+    EXPECT_FALSE(prober->isRunning());
+    EXPECT_FALSE(finished.wait(1000));
+    EXPECT_EQ(ready.count(), 0);
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/update/progressaggregator.h"
+
+#include <QTest>
+
+#include "gtest/gtest.h"
+
+using namespace dcc::update;
+
+class Tst_ProgressAggregator : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    struct Progress {
+        int type;
+        ProgressAggregator::Phase phase;
+        double value;
+    };
+
+    ProgressAggregator *aggregator = nullptr;
+    QList<Progress> changed;
+    bool accept = true;
+};
+
+void Tst_ProgressAggregator::SetUp()
+{
+    changed.clear();
+    accept = true;
+    aggregator = new ProgressAggregator([this](int type, ProgressAggregator::Phase phase, double value) {
+        changed << Progress { type, phase, value };
+        return accept;
+    });
+    aggregator->setMaxRate(10);
+}
+
+void Tst_ProgressAggregator::TearDown()
+{
+    delete aggregator;
+    aggregator = nullptr;
+}
+
+TEST_F(Tst_ProgressAggregator, coalesce)
+{
+    // 第一次变化立即通知，周期内的其他进度只保留最新的
+    for (int i = 1; i <= 50; ++i)
+        aggregator->update(1, ProgressAggregator::Download, i / 100.0);
+    ASSERT_EQ(changed.size(), 1);
+    EXPECT_DOUBLE_EQ(changed.at(0).value, 0.01);
+
+    ASSERT_TRUE(QTest::qWaitFor([this] { return changed.size() == 2; }, 1000));
+    EXPECT_DOUBLE_EQ(changed.at(1).value, 0.5);
+
+    // 没有新的进度时不再通知
+    QTest::qWait(300);
+    EXPECT_EQ(changed.size(), 2);
+}
+
+TEST_F(Tst_ProgressAggregator, keys)
+{
+    aggregator->update(1, ProgressAggregator::Download, 0.1);
+    aggregator->update(2, ProgressAggregator::Download, 0.2);
+    aggregator->update(1, ProgressAggregator::Download, 0.3);
+    aggregator->update(2, ProgressAggregator::Download, 0.4);
+    aggregator->flush();
+
+    ASSERT_EQ(changed.size(), 3);
+    EXPECT_EQ(changed.at(1).type, 1);
+    EXPECT_DOUBLE_EQ(changed.at(1).value, 0.3);
+    EXPECT_EQ(changed.at(2).type, 2);
+    EXPECT_DOUBLE_EQ(changed.at(2).value, 0.4);
+
+    // 完成时立即通知
+    aggregator->update(2, ProgressAggregator::Download, 1.0);
+    ASSERT_EQ(changed.size(), 4);
+    EXPECT_DOUBLE_EQ(changed.at(3).value, 1.0);
+
+    // 相同的进度不重复通知，清除后重新通知
+    aggregator->update(2, ProgressAggregator::Download, 1.0);
+    EXPECT_EQ(changed.size(), 4);
+    aggregator->clear();
+    aggregator->update(2, ProgressAggregator::Download, 1.0);
+    EXPECT_EQ(changed.size(), 5);
+}
+
+TEST_F(Tst_ProgressAggregator, phases)
+{
+    // 同一类型的下载和安装进度分别合并，互不覆盖
+    aggregator->update(1, ProgressAggregator::Download, 0.1);
+    aggregator->update(1, ProgressAggregator::Download, 0.6);
+    aggregator->update(1, ProgressAggregator::Install, 0.2);
+    aggregator->flush();
+
+    ASSERT_EQ(changed.size(), 3);
+    EXPECT_EQ(changed.at(1).phase, ProgressAggregator::Download);
+    EXPECT_DOUBLE_EQ(changed.at(1).value, 0.6);
+    EXPECT_EQ(changed.at(2).phase, ProgressAggregator::Install);
+    EXPECT_DOUBLE_EQ(changed.at(2).value, 0.2);
+
+    // 按阶段单独提交
+    aggregator->update(1, ProgressAggregator::Download, 0.7);
+    aggregator->update(1, ProgressAggregator::Install, 0.3);
+    aggregator->flush(1, ProgressAggregator::Install);
+    ASSERT_EQ(changed.size(), 4);
+    EXPECT_EQ(changed.at(3).phase, ProgressAggregator::Install);
+    EXPECT_DOUBLE_EQ(changed.at(3).value, 0.3);
+}
+
+TEST_F(Tst_ProgressAggregator, rejected)
+{
+    // 设置失败的进度不记录，相同的进度会再次通知
+    accept = false;
+    aggregator->update(1, ProgressAggregator::Download, 1.0);
+    aggregator->update(1, ProgressAggregator::Download, 1.0);
+    EXPECT_EQ(changed.size(), 2);
+
+    accept = true;
+    aggregator->update(1, ProgressAggregator::Download, 1.0);
+    EXPECT_EQ(changed.size(), 3);
+    aggregator->update(1, ProgressAggregator::Download, 1.0);
+    EXPECT_EQ(changed.size(), 3);
+}
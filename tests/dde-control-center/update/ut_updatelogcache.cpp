@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "../src/frame/modules/update/updatelogcache.h"
+
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "gtest/gtest.h"
+
+using namespace dcc::update;
+
+namespace {
+// 本地的更新日志服务器，记录收到的请求头，返回设置好的内容
+class HttpStandIn : public QTcpServer
+{
+public:
+    HttpStandIn()
+    {
+        listen(QHostAddress::LocalHost);
+        connect(this, &QTcpServer::newConnection, this, [this] {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, socket, [this, socket] {
+                    onReadyRead(socket);
+                });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+    QUrl url() const
+    {
+        return QUrl(QString("http://127.0.0.1:%1/api/v1/systemupdatelogs?rt=1").arg(serverPort()));
+    }
+
+    void setResponse(int status, const QByteArray &body, const QByteArray &etag)
+    {
+        m_status = status;
+        m_body = body;
+        m_etag = etag;
+    }
+
+public:
+    int requestCount = 0;
+    QByteArray lastIfNoneMatch;
+
+private:
+    void onReadyRead(QTcpSocket *socket)
+    {
+        QByteArray &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        const int headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0)
+            return;
+
+        int contentLength = 0;
+        QByteArray ifNoneMatch;
+        for (const QByteArray &line : buffer.left(headerEnd).split('\n')) {
+            const QByteArray header = line.trimmed();
+            if (header.toLower().startsWith("content-length:"))
+                contentLength = header.mid(15).trimmed().toInt();
+            else if (header.toLower().startsWith("if-none-match:"))
+                ifNoneMatch = header.mid(14).trimmed();
+        }
+        if (buffer.size() < headerEnd + 4 + contentLength)
+            return;
+
+        m_buffers.remove(socket);
+        ++requestCount;
+        lastIfNoneMatch = ifNoneMatch;
+
+        const bool notModified = !m_etag.isEmpty() && ifNoneMatch == m_etag;
+        const QByteArray body = notModified ? QByteArray() : m_body;
+        QByteArray response = notModified ? "HTTP/1.1 304 Not Modified\r\n" : QByteArray("HTTP/1.1 ") + QByteArray::number(m_status) + " OK\r\n";
+        if (!m_etag.isEmpty())
+            response += "ETag: " + m_etag + "\r\n";
+        response += "Content-Type: application/json\r\nConnection: close\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + body;
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+
+private:
+    int m_status = 200;
+    QByteArray m_body;
+    QByteArray m_etag;
+    QHash<QTcpSocket *, QByteArray> m_buffers;
+};
+
+const QByteArray FirstLogs = R"({"code":0,"data":[
+    {"id":1,"systemVersion":"1050","publishTime":"2022-01-01T00:00:00+08:00","cnLog":"a","enLog":"a","logType":1},
+    {"id":3,"systemVersion":"1060","publishTime":"2022-06-01T00:00:00+08:00","cnLog":"c","enLog":"c","logType":1},
+    {"id":2,"systemVersion":"1050","publishTime":"2022-02-01T00:00:00+08:00","cnLog":"b","enLog":"b","logType":2}
+]})";
+
+const QByteArray SecondLogs = R"({"code":0,"data":[
+    {"id":4,"systemVersion":"1070","publishTime":"2022-09-01T00:00:00+08:00","cnLog":"d","enLog":"d","logType":1},
+    {"id":3,"systemVersion":"1060","publishTime":"2022-06-01T00:00:00+08:00","cnLog":"c","enLog":"c","logType":1}
+]})";
+
+QList<int> idsOf(const QList<UpdateLogItem> &logs)
+{
+    QList<int> ids;
+    for (const UpdateLogItem &item : logs)
+        ids << item.id;
+    return ids;
+}
+
+// 等待请求完成，服务器没有返回新内容时不会发出 logsChanged
+void waitForRequest(HttpStandIn &server, int count)
+{
+    for (int i = 0; i < 100 && server.requestCount < count; ++i)
+        QTest::qWait(20);
+    QTest::qWait(100);
+}
+}
+
+class Tst_UpdateLogCache : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    QTemporaryDir dir;
+    QString cacheFile;
+};
+
+void Tst_UpdateLogCache::SetUp()
+{
+    cacheFile = dir.path() + "/update-logs.cache";
+}
+
+void Tst_UpdateLogCache::TearDown()
+{
+
+}
+
+TEST_F(Tst_UpdateLogCache, fetch)
+{
+    HttpStandIn server;
+    ASSERT_TRUE(server.isListening());
+    server.setResponse(200, FirstLogs, "\"v1\"");
+    const QByteArray body = R"({"platformType":1})";
+
+    UpdateLogCache cache(cacheFile);
+    QSignalSpy changed(&cache, &UpdateLogCache::logsChanged);
+    cache.fetch(server.url(), body);
+    ASSERT_TRUE(changed.wait(3000));
+    // 按版本号和发布时间降序
+    EXPECT_EQ(idsOf(cache.logs()), QList<int>({ 3, 2, 1 }));
+    EXPECT_TRUE(server.lastIfNoneMatch.isEmpty());
+
+    // 缓存未过期时不请求服务器
+    cache.fetch(server.url(), body);
+    waitForRequest(server, 2);
+    EXPECT_EQ(server.requestCount, 1);
+
+    // 过期后带上 ETag 请求，服务器返回 304
+    cache.setMaxAge(0);
+    cache.fetch(server.url(), body);
+    waitForRequest(server, 2);
+    EXPECT_EQ(server.requestCount, 2);
+    EXPECT_EQ(server.lastIfNoneMatch, QByteArray("\"v1\""));
+    EXPECT_EQ(changed.count(), 1);
+
+    // 内容变化时用新的日志替换缓存，服务器已经删除的日志不再保留
+    server.setResponse(200, SecondLogs, "\"v2\"");
+    cache.fetch(server.url(), body);
+    ASSERT_TRUE(changed.wait(3000));
+    EXPECT_EQ(idsOf(cache.logs()), QList<int>({ 4, 3 }));
+
+    // 再次启动时从文件中读取，不需要排序
+    UpdateLogCache reloaded(cacheFile);
+    ASSERT_TRUE(reloaded.load());
+    EXPECT_EQ(idsOf(reloaded.logs()), QList<int>({ 4, 3 }));
+    EXPECT_EQ(reloaded.logs().first().cnLog, QString("d"));
+
+    reloaded.fetch(server.url(), body);
+    waitForRequest(server, 4);
+    EXPECT_EQ(server.requestCount, 3);
+}
+
+TEST_F(Tst_UpdateLogCache, requestChanged)
+{
+    HttpStandIn server;
+    ASSERT_TRUE(server.isListening());
+    server.setResponse(200, FirstLogs, QByteArray());
+
+    UpdateLogCache cache(cacheFile);
+    QSignalSpy changed(&cache, &UpdateLogCache::logsChanged);
+    cache.fetch(server.url(), R"({"platformType":1})");
+    ASSERT_TRUE(changed.wait(3000));
+
+    // 请求参数变化后重新请求，替换之前的日志
+    server.setResponse(200, SecondLogs, QByteArray());
+    cache.fetch(server.url(), R"({"platformType":3})");
+    ASSERT_TRUE(changed.wait(3000));
+    EXPECT_EQ(idsOf(cache.logs()), QList<int>({ 4, 3 }));
+    EXPECT_EQ(server.requestCount, 2);
+}
+
+TEST_F(Tst_UpdateLogCache, requestChangedWhileFetching)
+{
+    HttpStandIn server;
+    ASSERT_TRUE(server.isListening());
+    server.setResponse(200, FirstLogs, QByteArray());
+
+    UpdateLogCache cache(cacheFile);
+    QSignalSpy changed(&cache, &UpdateLogCache::logsChanged);
+    cache.fetch(server.url(), R"({"platformType":1})");
+    // 请求过程中参数变化，完成后用最后一次的参数重新请求
+    cache.fetch(server.url(), R"({"platformType":2})");
+    cache.fetch(server.url(), R"({"platformType":3})");
+    ASSERT_TRUE(changed.wait(3000));
+    EXPECT_EQ(idsOf(cache.logs()), QList<int>({ 3, 2, 1 }));
+
+    server.setResponse(200, SecondLogs, QByteArray());
+    ASSERT_TRUE(changed.wait(3000));
+    EXPECT_EQ(idsOf(cache.logs()), QList<int>({ 4, 3 }));
+    waitForRequest(server, 3);
+    EXPECT_EQ(server.requestCount, 2);
+}
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "window/pagecache.h"
+#include "interface/moduleinterface.h"
+
+#include <QFile>
+#include <QLabel>
+#include <QStandardPaths>
+#include <QVBoxLayout>
+
+#include "gtest/gtest.h"
+
+using namespace DCC_NAMESPACE;
+
+namespace {
+class FakeModule : public ModuleInterface
+{
+public:
+    explicit FakeModule(const QString &name) : m_name(name) {}
+
+    void initialize() override {}
+    const QString name() const override { return m_name; }
+    const QString displayName() const override { return m_name; }
+
+private:
+    QString m_name;
+};
+
+// 创建包含 children 个子控件的页面，页面开销为 children + 1
+PageCache::PageStack makePages(ModuleInterface *module, int children)
+{
+    QWidget *page = new QWidget;
+    QVBoxLayout *layout = new QVBoxLayout(page);
+    for (int i = 0; i < children; ++i)
+        layout->addWidget(new QLabel(page));
+
+    return { qMakePair(module, QPointer<QWidget>(page)) };
+}
+
+void destroyPages(const QList<PageCache::PageStack> &stacks)
+{
+    for (const auto &stack : stacks) {
+        for (const auto &page : stack)
+            delete page.second;
+    }
+}
+}
+
+class Tst_PageCache : public testing::Test
+{
+    void SetUp() override;
+
+    void TearDown() override;
+
+public:
+    QString usageFile() const
+    {
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/page-usage.ini";
+    }
+
+    FakeModule sound { "sound" };
+    FakeModule display { "display" };
+    FakeModule mouse { "mouse" };
+};
+
+void Tst_PageCache::SetUp()
+{
+    QFile::remove(usageFile());
+}
+
+void Tst_PageCache::TearDown()
+{
+    QFile::remove(usageFile());
+}
+
+TEST_F(Tst_PageCache, insertAndTake)
+{
+    PageCache cache(4, 100);
+
+    const PageCache::PageStack pages = makePages(&sound, 4);
+    EXPECT_TRUE(cache.insert(&sound, pages).isEmpty());
+    EXPECT_TRUE(cache.contains(&sound));
+    EXPECT_EQ(cache.widgetCount(), 5);
+
+    // 取出的是同一组页面，取出后不再占用缓存
+    const PageCache::PageStack restored = cache.take(&sound);
+    ASSERT_EQ(restored.size(), 1);
+    EXPECT_EQ(restored.first().first, &sound);
+    EXPECT_EQ(restored.first().second.data(), pages.first().second.data());
+    EXPECT_FALSE(cache.contains(&sound));
+    EXPECT_EQ(cache.widgetCount(), 0);
+    EXPECT_TRUE(cache.take(&sound).isEmpty());
+
+    destroyPages({ restored });
+}
+
+TEST_F(Tst_PageCache, reinsertReplacesPages)
+{
+    PageCache cache(4, 100);
+
+    const PageCache::PageStack first = makePages(&sound, 2);
+    cache.insert(&sound, first);
+
+    // 同一模块再次放入时旧页面交给调用者销毁
+    const QList<PageCache::PageStack> evicted = cache.insert(&sound, makePages(&sound, 3));
+    ASSERT_EQ(evicted.size(), 1);
+    EXPECT_EQ(evicted.first().first().second.data(), first.first().second.data());
+    EXPECT_EQ(cache.widgetCount(), 4);
+
+    destroyPages(evicted);
+    destroyPages(cache.takeAll());
+}
+
+TEST_F(Tst_PageCache, evictLeastRecentlyUsedByCapacity)
+{
+    PageCache cache(2, 100);
+
+    cache.insert(&sound, makePages(&sound, 1));
+    cache.insert(&display, makePages(&display, 1));
+
+    // sound 重新进入后最近使用的是 sound，淘汰 display
+    const PageCache::PageStack pages = cache.take(&sound);
+    EXPECT_TRUE(cache.insert(&sound, pages).isEmpty());
+
+    const QList<PageCache::PageStack> evicted = cache.insert(&mouse, makePages(&mouse, 1));
+    ASSERT_EQ(evicted.size(), 1);
+    EXPECT_EQ(evicted.first().first().first, &display);
+    EXPECT_TRUE(cache.contains(&sound));
+    EXPECT_TRUE(cache.contains(&mouse));
+    EXPECT_FALSE(cache.contains(&display));
+
+    destroyPages(evicted);
+    destroyPages(cache.takeAll());
+}
+
+TEST_F(Tst_PageCache, evictByWidgetCount)
+{
+    PageCache cache(4, 10);
+
+    cache.insert(&sound, makePages(&sound, 4));
+    cache.insert(&display, makePages(&display, 3));
+    EXPECT_EQ(cache.widgetCount(), 9);
+
+    // 超出控件数量上限时从最久未使用的开始淘汰，直到回到上限以内
+    const QList<PageCache::PageStack> evicted = cache.insert(&mouse, makePages(&mouse, 2));
+    ASSERT_EQ(evicted.size(), 1);
+    EXPECT_EQ(evicted.first().first().first, &sound);
+    EXPECT_EQ(cache.widgetCount(), 7);
+
+    destroyPages(evicted);
+    destroyPages(cache.takeAll());
+}
+
+TEST_F(Tst_PageCache, rejectOversizePages)
+{
+    PageCache cache(4, 10);
+
+    cache.insert(&display, makePages(&display, 1));
+
+    // 单个页面的控件数量超出上限时直接退回，不影响已缓存的页面
+    const PageCache::PageStack pages = makePages(&sound, 20);
+    const QList<PageCache::PageStack> evicted = cache.insert(&sound, pages);
+    ASSERT_EQ(evicted.size(), 1);
+    EXPECT_EQ(evicted.first().first().second.data(), pages.first().second.data());
+    EXPECT_FALSE(cache.contains(&sound));
+    EXPECT_TRUE(cache.contains(&display));
+    EXPECT_EQ(cache.widgetCount(), 2);
+
+    destroyPages(evicted);
+    destroyPages(cache.takeAll());
+}
+
+TEST_F(Tst_PageCache, takeAll)
+{
+    PageCache cache(4, 100);
+
+    cache.insert(&sound, makePages(&sound, 1));
+    cache.insert(&display, makePages(&display, 1));
+
+    const QList<PageCache::PageStack> pages = cache.takeAll();
+    EXPECT_EQ(pages.size(), 2);
+    EXPECT_FALSE(cache.contains(&sound));
+    EXPECT_FALSE(cache.contains(&display));
+    EXPECT_EQ(cache.widgetCount(), 0);
+
+    destroyPages(pages);
+}
+
+TEST_F(Tst_PageCache, mostUsedForPrewarm)
+{
+    {
+        PageCache cache(4, 100);
+        cache.addVisit("display");
+        cache.addVisit("sound");
+        cache.addVisit("sound");
+        cache.addVisit("sound");
+        cache.addVisit("mouse");
+        cache.addVisit("mouse");
+
+        EXPECT_EQ(cache.mostUsed(2), QStringList({ "sound", "mouse" }));
+        EXPECT_EQ(cache.mostUsed(10).size(), 3);
+        EXPECT_TRUE(cache.mostUsed(0).isEmpty());
+    }
+
+    // 进入次数保存在缓存目录中，重新启动后仍用于预先创建页面
+    PageCache cache(4, 100);
+    EXPECT_EQ(cache.mostUsed(1), QStringList({ "sound" }));
+}